@@ -72,11 +72,15 @@
 
 /* Algebra methods */
 #include "../projects/Algebra/include/STK_CG.h"
+#include "../projects/Algebra/include/STK_Lanczos.h"
 
 #include "../projects/Algebra/include/STK_Qr.h"
 #include "../projects/Algebra/include/STK_Svd.h"
+#include "../projects/Algebra/include/STK_RandomizedSvd.h"
 #include "../projects/Algebra/include/STK_SymEigen.h"
+#include "../projects/Algebra/include/STK_BatchSymmetric.h"
 #include "../projects/Algebra/include/STK_MultiLeastSquare.h"
+#include "../projects/Algebra/include/STK_UpdatableQr.h"
 #include "../projects/Algebra/include/STK_GinvSymmetric.h"
 
 // the lapack classes
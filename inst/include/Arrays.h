@@ -65,6 +65,8 @@
 #ifndef ARRAYS_H
 #define ARRAYS_H
 
+/* memory arena for the temporary containers */
+#include "../projects/Arrays/include/STK_MemoryArena.h"
 
 /* Array2D */
 #include "../projects/Arrays/include/STK_Array2DPoint.h"
@@ -89,6 +91,9 @@
 /* constant Arrays */
 #include "../projects/Arrays/include/STK_Const_Arrays.h"
 
+/* sparse matrices */
+#include "../projects/Arrays/include/STK_SparseMatrix.h"
+
 /* display arrays and expressions */
 #include "../projects/Arrays/include/STK_Display.h"
 
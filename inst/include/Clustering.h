@@ -88,6 +88,12 @@
 #include "Clustering/include/DiagGaussianMixtureModels/STK_Gaussian_s.h"
 #include "Clustering/include/DiagGaussianMixtureModels/STK_DiagGaussianMixtureManager.h"
 
+#include "Clustering/include/FullGaussianMixtureModels/STK_Gaussian_Lk_Ck.h"
+#include "Clustering/include/FullGaussianMixtureModels/STK_Gaussian_L_C.h"
+#include "Clustering/include/FullGaussianMixtureModels/STK_Gaussian_Lk_C.h"
+#include "Clustering/include/FullGaussianMixtureModels/STK_Gaussian_Lk_Dk_A_Dk.h"
+#include "Clustering/include/FullGaussianMixtureModels/STK_FullGaussianMixtureManager.h"
+
 #include "Clustering/include/CategoricalMixtureModels/STK_Categorical_pjk.h"
 #include "Clustering/include/CategoricalMixtureModels/STK_Categorical_pk.h"
 #include "Clustering/include/CategoricalMixtureModels/STK_CategoricalMixtureManager.h"
@@ -103,6 +109,7 @@
 #include "Clustering/include/STK_MixtureInit.h"
 #include "Clustering/include/STK_MixtureAlgo.h"
 #include "Clustering/include/STK_MixtureStrategy.h"
+#include "Clustering/include/STK_MixtureTrace.h"
 #include "Clustering/include/STK_MixtureComposer.h"
 #include "Clustering/include/STK_MixtureCriterion.h"
 #include "Clustering/include/STK_MixtureFacade.h"
@@ -46,6 +46,8 @@
  *    <li> a templated implementation for arbitrary data, </li>
  *    <li> a Dataframe (Table) class,</li>
  *    <li> classes for read and write csv and (TODO) dbf files, </li>
+ *    <li> classes for read and write binary columnar files, </li>
+ *    <li> classes for reading data sets by blocks of rows, </li>
  *    <li> various  classes for importing/exporting and converting data from
  *    different containers in different type, </li>
  *    <li> methods for sorting one dimensional containers and two-dimensionnal
@@ -81,6 +83,7 @@
 #include "../projects/DManager/include/STK_IDataHandler.h"
 
 /* main classes for managing Csv data. */
+#include "../projects/DManager/include/STK_CsvParser.h"
 #include "../projects/DManager/include/STK_ReadWriteCsv.h"
 #include "../projects/DManager/include/STK_DataHandler.h"
 
@@ -90,9 +93,25 @@
 #include "../projects/DManager/include/STK_DataFrameToArray2D.h"
 #include "../projects/DManager/include/STK_CsvToArray.h"
 
+/* binary columnar files */
+#include "../projects/DManager/include/STK_BinaryColumns.h"
+
+/* fast export of arrays and DataFrame */
+#include "../projects/DManager/include/STK_CsvWriter.h"
+#include "../projects/DManager/include/STK_ExportToFile.h"
+
+/* sources of blocks of rows */
+#include "../projects/DManager/include/STK_IRowBlockSource.h"
+#include "../projects/DManager/include/STK_ArrayRowBlockSource.h"
+#include "../projects/DManager/include/STK_CsvRowBlockSource.h"
+#include "../projects/DManager/include/STK_BinaryRowBlockSource.h"
+
 /* HeapSort utilities. */
 #include "../projects/DManager/include/STK_HeapSort.h"
 
+/* sorting and selection utilities. */
+#include "../projects/DManager/include/STK_Sort.h"
+
 /* main classes for option files. */
 #include "../projects/DManager/include/STK_Option.h"
 #include "../projects/DManager/include/STK_IPage.h"
@@ -77,6 +77,7 @@
 #include "../projects/Reduct/include/STK_IReducer.h"
 #include "../projects/Reduct/include/STK_ILinearReduct.h"
 
+#include "../projects/Reduct/include/STK_NeighborGraph.h"
 #include "../projects/Reduct/include/STK_LocalVariance.h"
 #include "../projects/Reduct/include/STK_LocalVariancePage.h"
 
@@ -120,6 +120,7 @@
 // Multivariate Statistics
 #include "STatistiK/include/STK_Stat_Multivariate.h"
 #include "STatistiK/include/STK_Stat_MultivariateReal.h"
+#include "STatistiK/include/STK_Stat_OnlineCovariance.h"
 
 // perform the usual transformations on variables
 #include "STatistiK/include/STK_Stat_Transform.h"
@@ -43,6 +43,7 @@
 #include <StatModels/include/STK_IStatModel.h>
 #include <STatistiK/include/STK_MultiLaw_Normal.h>
 #include <STatistiK/include/STK_Stat_MultivariateReal.h>
+#include <STatistiK/include/STK_Stat_OnlineCovariance.h>
 
 namespace STK
 {
@@ -121,6 +122,11 @@ class GaussianAAModel : public IAAModel<Array>
      *  only the first time the data set is projected.
      **/
     void computeProjectedCovariance();
+    /** set the covariance matrix of the projected data set using statistics
+     *  accumulated by blocks of rows on the projected data set.
+     *  @param stat the statistics of the projected data set
+     **/
+    void computeProjectedCovariance(Stat::OnlineCovariance const& stat);
     /** compute the ln-likelihood of the model */
     void computeModelParameters();
 
@@ -279,11 +285,17 @@ void GaussianAAModel<Array>::computeProjectedCovariance()
 #ifdef STK_AAMODELS_VERBOSE
   stk_cout << _T("GaussianAAModel::computeProjectedCovariance().\n");
 #endif
-  Stat::covariance(*p_reduced_, projectedCovariance_);
+  Stat::OnlineCovariance stat(p_reduced_->cols());
+  stat.update(*p_reduced_);
+  stat.covariance(projectedCovariance_);
 #ifdef STK_AAMODELS_VERBOSE
   stk_cout << _T("GaussianAAModel::computeProjectedCovariance() done.\n");
 #endif
 }
+/* set the covariance matrix of the projected data set. */
+template<class Array>
+void GaussianAAModel<Array>::computeProjectedCovariance(Stat::OnlineCovariance const& stat)
+{ stat.covariance(projectedCovariance_);}
 /* compute the covariance matrix of the residuals. */
 template<class Array>
 void GaussianAAModel<Array>::computeResidualCovariance()
@@ -295,7 +307,9 @@ void GaussianAAModel<Array>::computeResidualCovariance()
 #ifdef STK_AAMODELS_VERBOSE
   stk_cout << _T("in GaussianAAModel::computeResidualCovariance().\n");
 #endif
-  Stat::covariance(*p_residuals_, residualCovariance_);
+  Stat::OnlineCovariance stat(p_residuals_->cols());
+  stat.update(*p_residuals_);
+  stat.covariance(residualCovariance_);
   residualVariance_ = (residualCovariance_.trace())/Real(this->nbVariable()-dim());
 #ifdef STK_AAMODELS_VERBOSE
   stk_cout << _T("GaussianAAModel::computeResidualCovariance() done.\n");
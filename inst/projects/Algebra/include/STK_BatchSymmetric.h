@@ -0,0 +1,501 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Algebra
+ * Purpose:  Define the BatchSymmetric class.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_BatchSymmetric.h
+ *  @brief In this file we define the BatchSymmetric class performing the
+ *  usual decompositions on a batch of small symmetric matrices.
+ **/
+
+#ifndef STK_BATCHSYMMETRIC_H
+#define STK_BATCHSYMMETRIC_H
+
+#include <vector>
+#include <cmath>
+
+#include <STKernel/include/STK_Constants.h>
+#include <Arrays/include/STK_CArray.h>
+#include <Arrays/include/STK_CArraySquare.h>
+#include <Arrays/include/STK_CArrayVector.h>
+
+#include "STK_SymEigen.h"
+
+namespace STK
+{
+
+namespace hidden
+{
+/** @ingroup hidden
+ *  Kernels operating on a symmetric matrix of size n stored by columns in a
+ *  contiguous array. When @c Size_ is known, the loops have a fixed number of
+ *  iterations and are unrolled by the compiler.
+ **/
+template<int Size_>
+struct BatchSymmetricKernels
+{
+  /** Cholesky decomposition A = LL'. The lower part of a is overwritten by
+   *  L and the upper part is set to zero.
+   *  @return 0 if A is positive definite, j+1 if the pivot j is not positive
+   **/
+  static int cholesky(Real* a, int p)
+  {
+    const int n = (Size_ == UnknownSize) ? p : Size_;
+    for (int j=0; j<n; ++j)
+    {
+      Real d = a[j+j*n];
+      for (int k=0; k<j; ++k) { d -= a[j+k*n]*a[j+k*n];}
+      if (!(d > 0.)) return j+1;
+      d = std::sqrt(d);
+      a[j+j*n] = d;
+      for (int i=j+1; i<n; ++i)
+      {
+        Real s = a[i+j*n];
+        for (int k=0; k<j; ++k) { s -= a[i+k*n]*a[j+k*n];}
+        a[i+j*n] = s/d;
+      }
+      for (int i=0; i<j; ++i) { a[i+j*n] = 0.;}
+    }
+    return 0;
+  }
+  /** @return the log-determinant of LL' */
+  static Real logDetCholesky(Real const* l, int p)
+  {
+    const int n = (Size_ == UnknownSize) ? p : Size_;
+    Real sum = 0.;
+    for (int j=0; j<n; ++j) { sum += std::log(l[j+j*n]);}
+    return 2.*sum;
+  }
+  /** compute the inverse of LL' in place.
+   *  @param a the Cholesky factor L, overwritten by the inverse
+   *  @param w workspace of size n*n
+   **/
+  static void inverseCholesky(Real* a, int p, Real* w)
+  {
+    const int n = (Size_ == UnknownSize) ? p : Size_;
+    // W = L^{-1} (lower triangular)
+    for (int j=0; j<n; ++j)
+    {
+      w[j+j*n] = 1./a[j+j*n];
+      for (int i=j+1; i<n; ++i)
+      {
+        Real s = 0.;
+        for (int k=j; k<i; ++k) { s += a[i+k*n]*w[k+j*n];}
+        w[i+j*n] = -s/a[i+i*n];
+      }
+    }
+    // A^{-1} = W'W
+    for (int j=0; j<n; ++j)
+    {
+      for (int i=0; i<=j; ++i)
+      {
+        Real s = 0.;
+        for (int k=j; k<n; ++k) { s += w[k+i*n]*w[k+j*n];}
+        a[i+j*n] = a[j+i*n] = s;
+      }
+    }
+  }
+  /** cyclic Jacobi eigenvalue decomposition. a is overwritten by the
+   *  eigenvectors and d by the eigenvalues in decreasing order.
+   *  @param w workspace of size n*n
+   **/
+  static void jacobi(Real* a, int p, Real* d, Real* w)
+  {
+    const int n = (Size_ == UnknownSize) ? p : Size_;
+    for (int j=0; j<n; ++j)
+      for (int i=0; i<n; ++i) { w[i+j*n] = (i==j) ? 1. : 0.;}
+    Real norm = 0.;
+    for (int j=0; j<n; ++j)
+      for (int i=0; i<n; ++i) { norm += a[i+j*n]*a[i+j*n];}
+    for (int sweep=0; sweep<50; ++sweep)
+    {
+      Real off = 0.;
+      for (int q=1; q<n; ++q)
+        for (int r=0; r<q; ++r) { off += a[r+q*n]*a[r+q*n];}
+      if (off <= Arithmetic<Real>::epsilon()*Arithmetic<Real>::epsilon()*norm) break;
+      for (int q=1; q<n; ++q)
+      {
+        for (int r=0; r<q; ++r)
+        {
+          const Real arq = a[r+q*n];
+          if (arq == 0.) continue;
+          const Real theta = (a[q+q*n] - a[r+r*n])/(2.*arq);
+          const Real t = (theta >= 0. ? 1. : -1.)/(std::abs(theta) + std::sqrt(theta*theta+1.));
+          const Real c = 1./std::sqrt(t*t+1.), s = t*c;
+          for (int k=0; k<n; ++k)
+          {
+            const Real akr = a[k+r*n], akq = a[k+q*n];
+            a[k+r*n] = c*akr - s*akq;
+            a[k+q*n] = s*akr + c*akq;
+          }
+          for (int k=0; k<n; ++k)
+          {
+            const Real ark = a[r+k*n], aqk = a[q+k*n];
+            a[r+k*n] = c*ark - s*aqk;
+            a[q+k*n] = s*ark + c*aqk;
+          }
+          for (int k=0; k<n; ++k)
+          {
+            const Real wkr = w[k+r*n], wkq = w[k+q*n];
+            w[k+r*n] = c*wkr - s*wkq;
+            w[k+q*n] = s*wkr + c*wkq;
+          }
+        }
+      }
+    }
+    for (int j=0; j<n; ++j) { d[j] = a[j+j*n];}
+    // sort in decreasing order and copy the eigenvectors
+    for (int j=0; j<n; ++j)
+    {
+      int jmax = j;
+      for (int i=j+1; i<n; ++i) { if (d[i] > d[jmax]) jmax = i;}
+      if (jmax != j)
+      {
+        std::swap(d[j], d[jmax]);
+        for (int k=0; k<n; ++k) { std::swap(w[k+j*n], w[k+jmax*n]);}
+      }
+    }
+    for (int j=0; j<n*n; ++j) { a[j] = w[j];}
+  }
+};
+
+} // namespace hidden
+
+/** @ingroup Algebra
+ *  @brief The BatchSymmetric class stores K symmetric matrices of size
+ *  p by p and perform on all of them the Cholesky decomposition, the
+ *  inversion, the eigenvalues decomposition or the generalized inversion.
+ *
+ *  The matrices are stored contiguously by columns in an array of size
+ *  p by K*p, so that the k-th matrix is given by the columns k*p to
+ *  (k+1)*p-1. The matrices are processed in parallel when OpenMP is available
+ *  and the batch is large enough. For p<=8 the kernels have a size fixed at
+ *  compile time.
+ *
+ *  All the decompositions overwrite the matrices. The log-determinant of the
+ *  original matrices is computed by all the methods.
+ *  @code
+ *    BatchSymmetric batch(K, p);
+ *    for (int k=0; k<K; ++k) { batch.setMatrix(k, sigma[k]);}
+ *    batch.inverse();
+ *    for (int k=0; k<K; ++k) { batch.getMatrix(k, sigmaInv[k]);}
+ *  @endcode
+ **/
+class BatchSymmetric
+{
+  public:
+    /** constructor
+     *  @param nbMatrix number of matrices
+     *  @param dim dimension of the matrices
+     **/
+    BatchSymmetric( int nbMatrix = 0, int dim = 0)
+                  : nbMatrix_(0), dim_(0), data_(), eigenValues_(), logDet_(), info_()
+    { resize(nbMatrix, dim);}
+    /** resize the batch. The matrices are set to zero.
+     *  @param nbMatrix number of matrices
+     *  @param dim dimension of the matrices
+     **/
+    void resize( int nbMatrix, int dim)
+    {
+      nbMatrix_ = nbMatrix; dim_ = dim;
+      data_.resize(dim_, nbMatrix_*dim_);
+      data_ = 0.;
+      logDet_.resize(nbMatrix_);
+      logDet_ = 0.;
+      info_.resize(nbMatrix_);
+      info_ = 0;
+    }
+    /** @return the number of matrices */
+    inline int nbMatrix() const { return nbMatrix_;}
+    /** @return the dimension of the matrices */
+    inline int dim() const { return dim_;}
+    /** @return the array storing the matrices */
+    inline CArrayXX const& data() const { return data_;}
+    /** @return the element (i,j) of the k-th matrix (indexes begin at 0) */
+    inline Real& operator()( int k, int i, int j) { return data_(i, k*dim_+j);}
+    /** @return the element (i,j) of the k-th matrix (indexes begin at 0) */
+    inline Real const& operator()( int k, int i, int j) const { return data_(i, k*dim_+j);}
+    /** @return a pointer on the k-th matrix */
+    inline Real* p_matrix(int k) { return data_.p_data() + k*dim_*dim_;}
+    /** @return a constant pointer on the k-th matrix */
+    inline Real const* p_matrix(int k) const { return data_.p_data() + k*dim_*dim_;}
+    /** @return the eigenvalues (in columns) computed by eigen() and ginv() */
+    inline CArrayXX const& eigenValues() const { return eigenValues_;}
+    /** @return the log-determinant of the matrices */
+    inline CVectorX const& logDet() const { return logDet_;}
+    /** @return the status of the matrices: 0 if the last decomposition
+     *  succeeded, the index (beginning at 1) of the failing pivot otherwise.
+     **/
+    inline CVectorXi const& info() const { return info_;}
+    /** copy a square matrix in the k-th matrix of the batch.
+     *  @param k index of the matrix
+     *  @param a the matrix to copy
+     **/
+    template<class Square>
+    void setMatrix( int k, ExprBase<Square> const& a)
+    {
+      for (int j=0; j<dim_; ++j)
+        for (int i=0; i<dim_; ++i)
+        { (*this)(k, i, j) = a.elt(a.beginRows()+i, a.beginCols()+j);}
+    }
+    /** copy the k-th matrix of the batch in a square matrix.
+     *  @param k index of the matrix
+     *  @param a the matrix to overwrite (it must have the correct size)
+     **/
+    template<class Square>
+    void getMatrix( int k, ArrayBase<Square>& a) const
+    {
+      for (int j=0; j<dim_; ++j)
+        for (int i=0; i<dim_; ++i)
+        { a.elt(a.beginRows()+i, a.beginCols()+j) = (*this)(k, i, j);}
+    }
+    /** Compute the Cholesky decompositions @f$ A_k = L_kL_k' @f$. The
+     *  matrices are overwritten by the lower triangular matrices L_k.
+     *  @return @c true if all the matrices are positive definite
+     **/
+    bool cholesky()
+    {
+      switch (dim_)
+      {
+        case 0: return emptyImpl();
+        case 1: return choleskyImpl<1>();
+        case 2: return choleskyImpl<2>();
+        case 3: return choleskyImpl<3>();
+        case 4: return choleskyImpl<4>();
+        case 5: return choleskyImpl<5>();
+        case 6: return choleskyImpl<6>();
+        case 7: return choleskyImpl<7>();
+        case 8: return choleskyImpl<8>();
+        default: return choleskyImpl<UnknownSize>();
+      }
+    }
+    /** Compute the inverse of the positive definite matrices using their
+     *  Cholesky decomposition. The matrices are overwritten by their inverse
+     *  (the matrices which are not positive definite are overwritten by
+     *  their partial Cholesky factor and their info is not zero).
+     *  @return @c true if all the matrices are positive definite
+     **/
+    bool inverse()
+    {
+      switch (dim_)
+      {
+        case 0: return emptyImpl();
+        case 1: return inverseImpl<1>();
+        case 2: return inverseImpl<2>();
+        case 3: return inverseImpl<3>();
+        case 4: return inverseImpl<4>();
+        case 5: return inverseImpl<5>();
+        case 6: return inverseImpl<6>();
+        case 7: return inverseImpl<7>();
+        case 8: return inverseImpl<8>();
+        default: return inverseImpl<UnknownSize>();
+      }
+    }
+    /** Compute the eigenvalues decompositions @f$ A_k = P_kD_kP_k' @f$. The
+     *  matrices are overwritten by the eigenvectors and the eigenvalues are
+     *  stored in decreasing order in the columns of eigenValues().
+     **/
+    void eigen()
+    {
+      switch (dim_)
+      {
+        case 0: eigenValues_.resize(0, nbMatrix_); emptyImpl(); break;
+        case 1: eigenImpl<1>(); break;
+        case 2: eigenImpl<2>(); break;
+        case 3: eigenImpl<3>(); break;
+        case 4: eigenImpl<4>(); break;
+        case 5: eigenImpl<5>(); break;
+        case 6: eigenImpl<6>(); break;
+        case 7: eigenImpl<7>(); break;
+        case 8: eigenImpl<8>(); break;
+        default: eigenImpl<UnknownSize>(); break;
+      }
+    }
+    /** Compute the generalized inverses of the matrices using their
+     *  eigenvalues decomposition. The eigenvalues less than
+     *  tol times the largest eigenvalue are considered as zero. The
+     *  log-determinant is the logarithm of the product of the non zero
+     *  eigenvalues and info is the number of zero eigenvalues.
+     *  @param tol the relative tolerance
+     **/
+    void ginv(Real const& tol = Arithmetic<Real>::epsilon())
+    {
+      eigen();
+      const int p = dim_;
+      if (p == 0) return;
+#ifdef _OPENMP
+#pragma omp parallel if (nbMatrix_*p*p*p > ParallelThreshold)
+#endif
+      {
+        std::vector<Real> w(p*p);
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (int k=0; k<nbMatrix_; ++k)
+        {
+          Real* a = p_matrix(k);
+          for (int j=0; j<p*p; ++j) { w[j] = a[j];}
+          const Real eps = tol * std::max(std::abs(eigenValues_(0,k)), Arithmetic<Real>::min());
+          Real sum = 0.;
+          int nbZero = 0;
+          for (int l=0; l<p; ++l)
+          {
+            if (eigenValues_(l,k) > eps) { sum += std::log(eigenValues_(l,k));}
+            else { ++nbZero;}
+          }
+          logDet_[k] = sum;
+          info_[k] = nbZero;
+          for (int j=0; j<p; ++j)
+          {
+            for (int i=0; i<=j; ++i)
+            {
+              Real s = 0.;
+              for (int l=0; l<p; ++l)
+              { if (eigenValues_(l,k) > eps) s += w[i+l*p]*w[j+l*p]/eigenValues_(l,k);}
+              a[i+j*p] = a[j+i*p] = s;
+            }
+          }
+        }
+      }
+    }
+
+  private:
+    /** number of matrices */
+    int nbMatrix_;
+    /** dimension of the matrices */
+    int dim_;
+    /** the matrices */
+    CArrayXX data_;
+    /** the eigenvalues */
+    CArrayXX eigenValues_;
+    /** the log-determinants */
+    CVectorX logDet_;
+    /** status of the last decomposition */
+    CVectorXi info_;
+    /** implementation of the decompositions of matrices of dimension 0: the
+     *  kernels are not called (their workspaces would be empty).
+     *  @return @c true
+     **/
+    bool emptyImpl()
+    {
+      for (int k=0; k<nbMatrix_; ++k) { logDet_[k] = 0.; info_[k] = 0;}
+      return true;
+    }
+    /** implementation of the Cholesky decomposition */
+    template<int Size_>
+    bool choleskyImpl()
+    {
+      const int p = dim_;
+      int nbFail = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:nbFail) if (nbMatrix_*p*p*p > ParallelThreshold)
+#endif
+      for (int k=0; k<nbMatrix_; ++k)
+      {
+        Real* a = p_matrix(k);
+        info_[k] = hidden::BatchSymmetricKernels<Size_>::cholesky(a, p);
+        if (info_[k]) { logDet_[k] = Arithmetic<Real>::NA(); ++nbFail;}
+        else { logDet_[k] = hidden::BatchSymmetricKernels<Size_>::logDetCholesky(a, p);}
+      }
+      return nbFail == 0;
+    }
+    /** implementation of the inversion */
+    template<int Size_>
+    bool inverseImpl()
+    {
+      const int p = dim_;
+      int nbFail = 0;
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:nbFail) if (nbMatrix_*p*p*p > ParallelThreshold)
+#endif
+      {
+        std::vector<Real> w(p*p);
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (int k=0; k<nbMatrix_; ++k)
+        {
+          Real* a = p_matrix(k);
+          info_[k] = hidden::BatchSymmetricKernels<Size_>::cholesky(a, p);
+          if (info_[k]) { logDet_[k] = Arithmetic<Real>::NA(); ++nbFail; continue;}
+          logDet_[k] = hidden::BatchSymmetricKernels<Size_>::logDetCholesky(a, p);
+          hidden::BatchSymmetricKernels<Size_>::inverseCholesky(a, p, &w.front());
+        }
+      }
+      return nbFail == 0;
+    }
+    /** implementation of the eigenvalues decomposition */
+    template<int Size_>
+    void eigenImpl()
+    {
+      const int p = dim_;
+      eigenValues_.resize(p, nbMatrix_);
+#ifdef _OPENMP
+#pragma omp parallel if (nbMatrix_*p*p*p > ParallelThreshold)
+#endif
+      {
+        std::vector<Real> w(p*p), d(p);
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (int k=0; k<nbMatrix_; ++k)
+        {
+          Real* a = p_matrix(k);
+          if (Size_ != UnknownSize)
+          { hidden::BatchSymmetricKernels<Size_>::jacobi(a, p, &d.front(), &w.front());}
+          else
+          {
+            CSquareX s(p);
+            for (int j=0; j<p; ++j)
+              for (int i=0; i<p; ++i) { s(i,j) = a[i+j*p];}
+            SymEigen<CSquareX> decomp(s);
+            decomp.run();
+            for (int j=0; j<p; ++j)
+            {
+              d[j] = decomp.eigenValues()[j];
+              for (int i=0; i<p; ++i) { a[i+j*p] = decomp.rotation()(i,j);}
+            }
+          }
+          Real sum = 0.;
+          bool positive = true;
+          for (int j=0; j<p; ++j)
+          {
+            eigenValues_(j,k) = d[j];
+            if (d[j] > 0.) { sum += std::log(d[j]);} else { positive = false;}
+          }
+          logDet_[k] = positive ? sum : Arithmetic<Real>::NA();
+          info_[k] = 0;
+        }
+      }
+    }
+};
+
+} // namespace STK
+
+#endif /* STK_BATCHSYMMETRIC_H */
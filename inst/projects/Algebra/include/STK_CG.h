@@ -36,14 +36,46 @@
 #ifndef STK_CG_H
 #define STK_CG_H
 
+#include <vector>
+#include <ctime>
+
+#ifdef _OPENMP
+#include <omp.h>
+#elif !defined(_WIN32)
+#include <sys/time.h>
+#endif
+
 #include <Sdk/include/STK_Macros.h>
 #include <Sdk/include/STK_IRunner.h>
+#include <Arrays/include/STK_SparseMatrix.h>
 
 //#include "Arrays/include/STK_Display.h"
 
 namespace STK
 {
 
+namespace hidden
+{
+/** @ingroup hidden
+ *  @return the wall clock time in seconds, used by the conjugate gradient
+ *  classes for their timing counters. Without OpenMP the time is given by
+ *  @c gettimeofday, or by @c clock on Windows where it measures the elapsed
+ *  time of the process.
+ **/
+inline Real cgWallTime()
+{
+#if defined(_OPENMP)
+  return omp_get_wtime();
+#elif defined(_WIN32)
+  return Real(clock())/CLOCKS_PER_SEC;
+#else
+  timeval tv;
+  gettimeofday(&tv, 0);
+  return Real(tv.tv_sec) + Real(tv.tv_usec)*1e-6;
+#endif
+}
+} // namespace hidden
+
 template<class ColVector>
 struct DefaultFunctor
 {
@@ -91,7 +123,9 @@ class CG
   public:
     typedef typename ColVector::Type Type;
     /** Default Constructor */
-    CG(): x_(), r_(), eps_(0.), iter_(0), nbStart_(0), p_mult_(0), p_init_(0), p_b_(0) {}
+    CG(): x_(), r_(), eps_(0.), iter_(0), nbStart_(0), p_mult_(0), p_init_(0), p_b_(0)
+        , resHistory_(), nbMult_(0), multTime_(0.), elapsedTime_(0.)
+    {}
     /**Constructor
      * @param mult functor which compute @b Ax with @b A a matrix and @b x a vector
      * @param b from @b Ax=b
@@ -107,6 +141,7 @@ class CG
       , p_mult_(&mult)
       , p_init_(p_init)
       , p_b_(&b)
+      , resHistory_(), nbMult_(0), multTime_(0.), elapsedTime_(0.)
     {}
 
     /**Copy constructor. The constructor to copy.
@@ -119,6 +154,8 @@ class CG
       , p_mult_(cg.p_mult_)
       , p_init_(cg.p_init_)
       , p_b_(cg.p_b_)
+      , resHistory_(cg.resHistory_), nbMult_(cg.nbMult_)
+      , multTime_(cg.multTime_), elapsedTime_(cg.elapsedTime_)
     {}
     /**destructor*/
     ~CG() {}
@@ -135,6 +172,16 @@ class CG
     inline int const& nbStart() const { return nbStart_;}
     /**@return the residuals b-A*x*/
     inline ColVector const& r() const { return r_;}
+    /** @return the relative norms of the residuals \f$ \|r_k\|/\|b\| \f$ at
+     *  the start of each cycle and after each iteration
+     **/
+    inline std::vector<Type> const& resHistory() const { return resHistory_;}
+    /** @return the number of products @b Ax computed */
+    inline int nbMult() const { return nbMult_;}
+    /** @return the time (in seconds) spent in the products @b Ax */
+    inline Real multTime() const { return multTime_;}
+    /** @return the total time (in seconds) of the last run */
+    inline Real elapsedTime() const { return elapsedTime_;}
     /** Set the tolerance*/
     inline void setEps(Type const& eps) {eps_ = eps;}
     /** Set the constant vector */
@@ -158,7 +205,9 @@ class CG
     /** @return the number of iterations */
     int cg()
     {
-      iter_ = 0;
+      const Real start = hidden::cgWallTime();
+      iter_ = 0; nbMult_ = 0; multTime_ = 0.;
+      resHistory_.clear();
       int nbStart = 0;
       ColVector xOld, z, p_;
 
@@ -171,7 +220,8 @@ class CG
         Real bnorm2 = p_b_->norm2(), alpha, beta; //
         if (bnorm2 == 0.) bnorm2 = 1.;
         //compute the residuals
-        r_ = *p_b_ - (*p_mult_)(x_);
+        r_ = *p_b_ - mult(x_);
+        resHistory_.push_back(std::sqrt(r_.norm2()/bnorm2));
         if (r_.norm2()/bnorm2 <eps_) { break;}
         //initialization of the conjugate direction
         p_= r_;
@@ -179,7 +229,7 @@ class CG
         {
           Real rnorm2 = r_.norm2();
           //compute z=A p
-          z.move((*p_mult_)(p_));
+          z.move(mult(p_));
           //compute alpha
           alpha = rnorm2/p_.dot(z);
           //update x_
@@ -190,7 +240,9 @@ class CG
           r_ = r_ - (alpha * z);
           //compute beta
           beta = 1/rnorm2;
-          if ((rnorm2=r_.norm2())/bnorm2 <eps_) { nbStart = 2; break;}
+          rnorm2=r_.norm2();
+          resHistory_.push_back(std::sqrt(rnorm2/bnorm2));
+          if (rnorm2/bnorm2 <eps_) { nbStart = 2; break;}
           beta *= rnorm2;
           //update p_
           p_ = (p_ * beta) + r_;
@@ -199,9 +251,19 @@ class CG
         }
         nbStart++;
       }
+      elapsedTime_ = hidden::cgWallTime() - start;
       // return an error
       return iter_;
     }
+    /** compute @b Ax and update the counters */
+    ColVector mult(ColVector const& x)
+    {
+      const Real start = hidden::cgWallTime();
+      ColVector y((*p_mult_)(x));
+      multTime_ += hidden::cgWallTime() - start;
+      ++nbMult_;
+      return y;
+    }
 
   private:
     /** solution of the system */
@@ -220,6 +282,14 @@ class CG
     InitFunctor const*  p_init_;
     /** constant pointer on the second member of the system */
     ColVector const* p_b_;
+    /** history of the relative residuals */
+    std::vector<Type> resHistory_;
+    /** number of products */
+    int nbMult_;
+    /** time spent in the products */
+    Real multTime_;
+    /** total time of the last run */
+    Real elapsedTime_;
 };
 
 /** @ingroup Algebra
@@ -276,22 +346,25 @@ class PCG
      */
     PCG( MultFunctor const& mult, CondFunctor const& cond, ColVector const& b, InitFunctor* const& p_init =0, Type eps=Arithmetic<Type>::epsilon())
        : x_(), r_()
-       , iter_(0), eps_(eps)
+       , iter_(0), eps_(eps), maxIter_(0)
        , p_mult_(&mult)
        , p_cond_(&cond)
        , p_init_(p_init)
        , p_b_(&b)
+       , resHistory_(), nbMult_(0), multTime_(0.), condTime_(0.), elapsedTime_(0.)
     {};
     /**Copy constructor. The constructor to copy.
      * @param pcg the preconditioned conjugate gradient to copy
      */
     PCG( PCG const& pcg)
       : x_(pcg.x_), r_(pcg.r_)
-      , eps_(pcg.eps_), iter_(0)
+      , iter_(pcg.iter_), eps_(pcg.eps_), maxIter_(pcg.maxIter_)
       , p_mult_(pcg.p_mult_)
       , p_cond_(pcg.p_cond_)
       , p_init_(pcg.p_init_)
       , p_b_(pcg.p_b_)
+      , resHistory_(pcg.resHistory_), nbMult_(pcg.nbMult_), multTime_(pcg.multTime_)
+      , condTime_(pcg.condTime_), elapsedTime_(pcg.elapsedTime_)
     {};
     /**destructor*/
     ~PCG() {};
@@ -304,8 +377,24 @@ class PCG
     inline Real const& x(int const& i) const { return x_[i];}
     /**@return the residuals b-A*x*/
     inline ColVector const& r() const { return r_;}
+    /** @return the relative norms of the residuals \f$ \|r_k\|/\|b\| \f$ at
+     *  the start of each cycle and after each iteration
+     **/
+    inline std::vector<Type> const& resHistory() const { return resHistory_;}
+    /** @return the number of products @b Ax computed */
+    inline int nbMult() const { return nbMult_;}
+    /** @return the time (in seconds) spent in the products @b Ax */
+    inline Real multTime() const { return multTime_;}
+    /** @return the total time (in seconds) of the last run */
+    inline Real elapsedTime() const { return elapsedTime_;}
+    /** @return the time (in seconds) spent in the preconditioner */
+    inline Real condTime() const { return condTime_;}
+    /** @return the number of iterations */
+    inline int const& iter() const { return iter_;}
     /** Set the tolerance*/
     inline void setEps(Type const& eps) {eps_ = eps;}
+    /** Set the maximal number of iterations (0 for ten times the size of @b b) */
+    inline void setMaxIter(int maxIter) { maxIter_ = maxIter;}
     /** Set the constant vector */
     inline void setB(ColVector const& b) { p_b_=&b;}
     /** Set functor computing @b x at initialization */
@@ -327,11 +416,14 @@ class PCG
     /** preconditioned Gradient implementation */
     int pcg()
     {
+      const Real start = hidden::cgWallTime();
       int nbStart = 0;
       ColVector xOld, y, z, p;
 
       Real bnorm2 = p_b_->norm2(), alpha, beta; //
-      iter_= 0;
+      const int maxIter = (maxIter_ > 0) ? maxIter_ : 10*std::max(p_b_->size(), 10);
+      iter_= 0; nbMult_ = 0; multTime_ = 0.; condTime_ = 0.;
+      resHistory_.clear();
       // initialization
       if(!p_init_) {x_ = *p_b_;}
       else { x_ = (*p_init_)();}
@@ -340,17 +432,18 @@ class PCG
       {
         if (bnorm2 == 0.) bnorm2 = 1.;
         //compute the residuals
-        r_ = *p_b_ - (*p_mult_)(x_);
+        r_ = *p_b_ - mult(x_);
+        resHistory_.push_back(std::sqrt(r_.norm2()/bnorm2));
         if (r_.norm2()/bnorm2 <eps_) { break;}
         //initialization of the conjugate direction
-        y = (*p_cond_)(r_);
+        y = cond(r_);
         p = y;
         Real rty=r_.dot(y);
         while(1)
         {
           Real rnorm2 = r_.norm2();
           //compute z=A p
-          z.move((*p_mult_)(p));
+          z.move(mult(p));
           //compute alpha
           alpha = rty/p.dot(z);
           //update x_
@@ -360,10 +453,17 @@ class PCG
           //update residuals
           r_ = r_ - (alpha * z);
           //update y
-          y = (*p_cond_)(r_);
+          y = cond(r_);
           //compute beta
           beta = 1/rty;
-          if ((rnorm2=r_.norm2())/bnorm2 <eps_) { nbStart = 2; break;}
+          rnorm2=r_.norm2();
+          resHistory_.push_back(std::sqrt(rnorm2/bnorm2));
+          if (rnorm2/bnorm2 <eps_) { nbStart = 2; break;}
+          if (iter_ >= maxIter)
+          {
+            msg_error_ = STKERROR_NO_ARG(PCG::pcg,maximal number of iterations reached);
+            nbStart = 2; break;
+          }
           rty = r_.dot(y);
           beta *= rty;
           //update p_
@@ -371,8 +471,26 @@ class PCG
         }
         nbStart++;
       }
+      elapsedTime_ = hidden::cgWallTime() - start;
       return iter_;
     }
+    /** compute @b Ax and update the counters */
+    ColVector mult(ColVector const& x)
+    {
+      const Real start = hidden::cgWallTime();
+      ColVector y((*p_mult_)(x));
+      multTime_ += hidden::cgWallTime() - start;
+      ++nbMult_;
+      return y;
+    }
+    /** compute \f$ \mathbf{M}^{-1} \mathbf{r}\f$ and update the counters */
+    ColVector cond(ColVector const& r)
+    {
+      const Real start = hidden::cgWallTime();
+      ColVector y((*p_cond_)(r));
+      condTime_ += hidden::cgWallTime() - start;
+      return y;
+    }
 
   private:
     /** solution of the system */
@@ -383,6 +501,8 @@ class PCG
     int iter_;
     /** tolerance */
     Type eps_;
+    /** maximal number of iterations */
+    int maxIter_;
     /** pointer on the functor performing @b Ax */
     MultFunctor const*  p_mult_;
     /** pointer on the functor performing \f$ \mathbf{M}^{-1} \mathbf{r}\f$*/
@@ -391,6 +511,420 @@ class PCG
     InitFunctor const*  p_init_;
     /** constant pointer on the second member of the system */
     ColVector const* p_b_;
+    /** history of the relative residuals */
+    std::vector<Type> resHistory_;
+    /** number of products */
+    int nbMult_;
+    /** time spent in the products */
+    Real multTime_;
+    /** time spent in the preconditioner */
+    Real condTime_;
+    /** total time of the last run */
+    Real elapsedTime_;
+};
+
+/** @ingroup Algebra
+ *  @brief Functor computing the product of a sparse matrix with a vector or
+ *  with a block of vectors. It can be used as @c MultFunctor in the CG, PCG
+ *  and BlockCG classes.
+ *
+ *  The product is delegated to the @c mult method of the matrix, so that any
+ *  sparse matrix type providing
+ *  @code
+ *    template<class Rhs, class Result> void mult(Rhs const& x, Result& y) const;
+ *  @endcode
+ *  can be plugged in. The SparseMatrix class computes this product in parallel.
+ *
+ *  @tparam ColVector The type of the containers for the vectors.
+ *  @tparam Matrix The type of the sparse matrix.
+ **/
+template<class ColVector, class Matrix = SparseMatrix>
+struct SparseMultFunctor
+{
+  /** constructor
+   *  @param a the sparse matrix
+   **/
+  inline SparseMultFunctor( Matrix const& a): a_(a) {}
+  /** @return the product of the matrix with x
+   *  @param x the vector (or block of vectors) to multiply
+   **/
+  inline ColVector operator()( ColVector const& x) const
+  { ColVector y; a_.mult(x, y); return y;}
+  /** the sparse matrix */
+  Matrix const& a_;
+};
+
+/** @ingroup Algebra
+ *  @brief Identity preconditioner. It can be used as @c CondFunctor in the
+ *  PCG and BlockCG classes when no preconditioning is needed.
+ **/
+template<class ColVector>
+struct IdCondFunctor
+{
+  /** @return r */
+  inline ColVector operator()( ColVector const& r) const { return r;}
+};
+
+/** @ingroup Algebra
+ *  @brief Jacobi (diagonal) preconditioner: \f$ \mathbf{M} = diag(\mathbf{A}) \f$.
+ *  It can be used as @c CondFunctor in the PCG and BlockCG classes.
+ *  The null values of the diagonal are replaced by one.
+ *  @tparam ColVector The type of the containers for the vectors.
+ **/
+template<class ColVector>
+class JacobiCondFunctor
+{
+  public:
+    /** constructor.
+     *  @param d the diagonal of the matrix @b A
+     **/
+    template<class Vector>
+    JacobiCondFunctor( Vector const& d): invDiag_(d.size())
+    {
+      for (int i = 0; i < d.size(); ++i)
+      {
+        Real v = d[d.begin()+i];
+        invDiag_[i] = (v != 0.) ? 1./v : 1.;
+      }
+    }
+    /** constructor.
+     *  @param a the sparse matrix @b A
+     **/
+    JacobiCondFunctor( SparseMatrix const& a): invDiag_(std::min(a.sizeRows(), a.sizeCols()))
+    {
+      for (int i = 0; i < int(invDiag_.size()); ++i)
+      {
+        Real v = a.elt(i, i);
+        invDiag_[i] = (v != 0.) ? 1./v : 1.;
+      }
+    }
+    /** @return \f$ \mathbf{M}^{-1} \mathbf{r}\f$
+     *  @param r the vector (or the block of vectors) of residuals
+     **/
+    ColVector operator()( ColVector const& r) const
+    {
+      ColVector z(r);
+      const int b = z.beginRows();
+      for (int j = z.beginCols(); j < z.endCols(); ++j)
+        for (int i = 0; i < int(invDiag_.size()); ++i)
+        { z.elt(b+i, j) *= invDiag_[i];}
+      return z;
+    }
+
+  private:
+    /** the inverse of the diagonal */
+    std::vector<Real> invDiag_;
+};
+
+/** @ingroup Algebra
+ *  @brief Incomplete Cholesky preconditioner without fill-in (IC(0)):
+ *  \f$ \mathbf{M} = \mathbf{L}\mathbf{L}^T \f$ where @b L has the sparsity
+ *  pattern of the lower part of @b A. It can be used as @c CondFunctor in the
+ *  PCG and BlockCG classes.
+ *
+ *  If the factorization breaks down (a non-positive pivot), it is restarted on
+ *  the matrix \f$ \mathbf{A} + \alpha diag(\mathbf{A})\f$ with increasing
+ *  values of the shift \f$ \alpha \f$.
+ *  @tparam ColVector The type of the containers for the vectors.
+ **/
+template<class ColVector>
+class IncompleteCholeskyCondFunctor
+{
+  public:
+    /** constructor. Compute the factor @b L.
+     *  @param a the sparse symmetric matrix @b A
+     **/
+    IncompleteCholeskyCondFunctor( SparseMatrix const& a)
+                                 : rowPtr_(), colIdx_(), values_(), shift_(0.)
+    { factorize(a);}
+    /** @return the shift used for computing the factorization */
+    inline Real shift() const { return shift_;}
+    /** @return \f$ \mathbf{M}^{-1} \mathbf{r}\f$
+     *  @param r the vector (or the block of vectors) of residuals
+     **/
+    ColVector operator()( ColVector const& r) const
+    {
+      ColVector z(r);
+      const int b = z.beginRows(), n = int(rowPtr_.size())-1;
+      const int first = z.beginCols(), last = z.endCols();
+#ifdef _OPENMP
+#pragma omp parallel for if (double(rowPtr_[n])*(last-first) > ParallelThreshold)
+#endif
+      for (int j = first; j < last; ++j)
+      {
+        // solve L y = r
+        for (int i = 0; i < n; ++i)
+        {
+          Real sum = z.elt(b+i, j);
+          int k = rowPtr_[i];
+          for (; k < rowPtr_[i+1]-1; ++k) { sum -= values_[k] * z.elt(b+colIdx_[k], j);}
+          z.elt(b+i, j) = sum / values_[k];
+        }
+        // solve L' z = y
+        for (int i = n-1; i >= 0; --i)
+        {
+          Real zi = (z.elt(b+i, j) /= values_[rowPtr_[i+1]-1]);
+          for (int k = rowPtr_[i]; k < rowPtr_[i+1]-1; ++k)
+          { z.elt(b+colIdx_[k], j) -= values_[k] * zi;}
+        }
+      }
+      return z;
+    }
+
+  private:
+    /** offsets of the rows of L */
+    std::vector<int> rowPtr_;
+    /** column indexes of L (the diagonal is the last element of each row) */
+    std::vector<int> colIdx_;
+    /** values of L */
+    std::vector<Real> values_;
+    /** shift used for the factorization */
+    Real shift_;
+    /** compute the factorization */
+    void factorize( SparseMatrix const& a)
+    {
+      const int n = a.sizeRows();
+      // pattern of the lower part with the diagonal at the end of each row
+      rowPtr_.assign(n+1, 0);
+      colIdx_.clear();
+      std::vector<Real> lower;
+      for (int i = 0; i < n; ++i)
+      {
+        for (int k = a.rowPtr()[i]; k < a.rowPtr()[i+1] && a.colIdx()[k] < i; ++k)
+        { colIdx_.push_back(a.colIdx()[k]); lower.push_back(a.values()[k]);}
+        colIdx_.push_back(i); lower.push_back(a.elt(i, i));
+        rowPtr_[i+1] = int(colIdx_.size());
+      }
+      shift_ = 0.;
+      for (int trial = 0; trial < 30; ++trial)
+      {
+        if (tryFactorize(lower)) return;
+        shift_ = (shift_ == 0.) ? 1e-3 : 2.*shift_;
+      }
+      STKRUNTIME_ERROR_NO_ARG(IncompleteCholeskyCondFunctor::factorize,matrix is not positive);
+    }
+    /** try to factorize the matrix with the current shift
+     *  @param lower the values of the lower part of @b A
+     *  @return @c false if a non-positive pivot is found
+     **/
+    bool tryFactorize( std::vector<Real> const& lower)
+    {
+      const int n = int(rowPtr_.size())-1;
+      values_ = lower;
+      for (int i = 0; i < n; ++i)
+      {
+        const int diag = rowPtr_[i+1]-1;
+        for (int k = rowPtr_[i]; k < diag; ++k)
+        {
+          const int j = colIdx_[k];
+          // sum_{m<j} L(i,m) L(j,m) on the common pattern
+          Real sum = values_[k];
+          int ki = rowPtr_[i], kj = rowPtr_[j];
+          while (ki < k && kj < rowPtr_[j+1]-1)
+          {
+            if (colIdx_[ki] == colIdx_[kj]) { sum -= values_[ki++] * values_[kj++];}
+            else if (colIdx_[ki] < colIdx_[kj]) { ++ki;}
+            else { ++kj;}
+          }
+          values_[k] = sum / values_[rowPtr_[j+1]-1];
+        }
+        Real d = values_[diag] * (1. + shift_);
+        for (int k = rowPtr_[i]; k < diag; ++k) { d -= values_[k] * values_[k];}
+        if (!(d > 0.)) return false;
+        values_[diag] = std::sqrt(d);
+      }
+      return true;
+    }
+};
+
+/** @ingroup Algebra
+ *  @brief The BlockCG class solves the linear systems \f$ \mathbf{AX} = \mathbf{B}\f$
+ *  for a block @b B of right hand sides with the preconditioned conjugate
+ *  gradient method.
+ *
+ *  The columns of @b X are updated simultaneously: the products
+ *  \f$ \mathbf{AP} \f$ and \f$ \mathbf{M}^{-1}\mathbf{R} \f$ are computed for
+ *  all the search directions in a single call to the functors, so that the
+ *  matrix is traversed once per iteration whatever the number of right hand
+ *  sides. Each column keeps its own step sizes and is frozen as soon as its
+ *  relative residual satisfies \f$ \|r\|^2/\|b\|^2 < \epsilon\f$.
+ *
+ *  @tparam MultFunctor A functor computing the result of @b AX for a block @b X.
+ *  @tparam ColArray The type of the containers for the blocks of vectors.
+ *  @tparam CondFunctor A functor computing the value \f$ \mathbf{M}^{-1} \mathbf{R}\f$.
+ *  @tparam InitFunctor A functor computing the initial value @b X.
+ **/
+template< class MultFunctor, class ColArray, class CondFunctor = IdCondFunctor<ColArray>
+        , class InitFunctor = DefaultFunctor<ColArray> >
+class BlockCG
+{
+  public:
+    typedef typename ColArray::Type Type;
+    /** Constructor
+     *  @param mult functor which compute @b AX
+     *  @param cond functor which compute \f$ \mathbf{M}^{-1} \mathbf{R}\f$
+     *  @param b the right hand sides
+     *  @param p_init functor which initialize @b X
+     *  @param eps tolerance
+     **/
+    BlockCG( MultFunctor const& mult, CondFunctor const& cond, ColArray const& b
+           , InitFunctor* const& p_init =0, Type eps=Arithmetic<Type>::epsilon())
+           : x_(), r_(), iter_(0), eps_(eps), maxIter_(0)
+           , p_mult_(&mult), p_cond_(&cond), p_init_(p_init), p_b_(&b)
+           , iters_(), resHistory_(), nbMult_(0), multTime_(0.), condTime_(0.), elapsedTime_(0.)
+    {}
+    /** destructor */
+    ~BlockCG() {}
+
+    /** @return the solutions of the linear systems */
+    inline ColArray const& x() const { return x_;}
+    /** @return the residuals B-A*X */
+    inline ColArray const& r() const { return r_;}
+    /** @return the number of iterations */
+    inline int const& iter() const { return iter_;}
+    /** @return the number of iterations of each right hand side */
+    inline std::vector<int> const& iters() const { return iters_;}
+    /** @return the largest relative norm of the residuals of the right hand
+     *  sides at initialization and after each iteration
+     **/
+    inline std::vector<Type> const& resHistory() const { return resHistory_;}
+    /** @return the number of block products @b AX computed */
+    inline int nbMult() const { return nbMult_;}
+    /** @return the time (in seconds) spent in the products @b AX */
+    inline Real multTime() const { return multTime_;}
+    /** @return the time (in seconds) spent in the preconditioner */
+    inline Real condTime() const { return condTime_;}
+    /** @return the total time (in seconds) of the last run */
+    inline Real elapsedTime() const { return elapsedTime_;}
+    /** Set the tolerance*/
+    inline void setEps(Type const& eps) {eps_ = eps;}
+    /** Set the maximal number of iterations (0 for ten times the number of rows of @b B) */
+    inline void setMaxIter(int maxIter) { maxIter_ = maxIter;}
+    /** Set the right hand sides */
+    inline void setB(ColArray const& b) { p_b_=&b;}
+    /** run the block conjugate gradient
+     *  @return the number of iterations
+     **/
+    inline int run() { return blockCG();}
+    /** get the last error message.
+     * @return the last error message
+     **/
+    inline String const& error() const { return msg_error_;}
+
+  protected:
+    /** String with the last error message. */
+    String msg_error_;
+    /** block conjugate gradient implementation */
+    int blockCG()
+    {
+      const Real start = hidden::cgWallTime();
+      const int maxIter = (maxIter_ > 0) ? maxIter_ : 10*std::max(p_b_->sizeRows(), 10);
+      const int first = p_b_->beginCols(), last = p_b_->endCols(), s = p_b_->sizeCols();
+      iter_ = 0; nbMult_ = 0; multTime_ = 0.; condTime_ = 0.;
+      resHistory_.clear();
+      iters_.assign(s, 0);
+      ColArray z, p, q;
+      // initialization
+      if(!p_init_) {x_ = *p_b_;}
+      else { x_ = (*p_init_)();}
+      r_ = *p_b_ - mult(x_);
+      z = cond(r_);
+      p = z;
+      std::vector<Real> bnorm2(s), rz(s);
+      std::vector<bool> active(s, true);
+      int nbActive = s;
+      Real maxRes = 0.;
+      for (int j = first; j < last; ++j)
+      {
+        Real b2 = p_b_->col(j).norm2();
+        bnorm2[j-first] = (b2 == 0.) ? 1. : b2;
+        Real res2 = r_.col(j).norm2()/bnorm2[j-first];
+        maxRes = std::max(maxRes, res2);
+        if (res2 < eps_) { active[j-first] = false; p.col(j) = 0.; --nbActive;}
+        rz[j-first] = r_.col(j).dot(z.col(j));
+      }
+      resHistory_.push_back(std::sqrt(maxRes));
+      while (nbActive > 0 && iter_ < maxIter)
+      {
+        q = mult(p);
+        ++iter_;
+        maxRes = 0.;
+        for (int j = first; j < last; ++j)
+        {
+          if (!active[j-first]) continue;
+          Real alpha = rz[j-first]/p.col(j).dot(q.col(j));
+          x_.col(j) += alpha * p.col(j);
+          r_.col(j) -= alpha * q.col(j);
+          ++iters_[j-first];
+          Real res2 = r_.col(j).norm2()/bnorm2[j-first];
+          maxRes = std::max(maxRes, res2);
+          if (res2 < eps_) { active[j-first] = false; p.col(j) = 0.; --nbActive;}
+        }
+        resHistory_.push_back(std::sqrt(maxRes));
+        if (nbActive == 0) break;
+        z = cond(r_);
+        for (int j = first; j < last; ++j)
+        {
+          if (!active[j-first]) continue;
+          Real rzNew = r_.col(j).dot(z.col(j));
+          p.col(j) = z.col(j) + (rzNew/rz[j-first]) * p.col(j);
+          rz[j-first] = rzNew;
+        }
+      }
+      if (nbActive > 0)
+      { msg_error_ = STKERROR_NO_ARG(BlockCG::blockCG,maximal number of iterations reached);}
+      elapsedTime_ = hidden::cgWallTime() - start;
+      return iter_;
+    }
+    /** compute @b AX and update the counters */
+    ColArray mult(ColArray const& x)
+    {
+      const Real start = hidden::cgWallTime();
+      ColArray y((*p_mult_)(x));
+      multTime_ += hidden::cgWallTime() - start;
+      ++nbMult_;
+      return y;
+    }
+    /** compute \f$ \mathbf{M}^{-1} \mathbf{R}\f$ and update the counters */
+    ColArray cond(ColArray const& r)
+    {
+      const Real start = hidden::cgWallTime();
+      ColArray y((*p_cond_)(r));
+      condTime_ += hidden::cgWallTime() - start;
+      return y;
+    }
+
+  private:
+    /** solutions of the systems */
+    ColArray x_;
+    /** residuals of the systems */
+    ColArray r_;
+    /** number of iterations */
+    int iter_;
+    /** tolerance */
+    Type eps_;
+    /** maximal number of iterations */
+    int maxIter_;
+    /** pointer on the functor performing @b AX */
+    MultFunctor const*  p_mult_;
+    /** pointer on the functor performing \f$ \mathbf{M}^{-1} \mathbf{R}\f$*/
+    CondFunctor const*  p_cond_;
+    /** pointer on the functor initializing @b X*/
+    InitFunctor const*  p_init_;
+    /** constant pointer on the right hand sides */
+    ColArray const* p_b_;
+    /** number of iterations of each right hand side */
+    std::vector<int> iters_;
+    /** history of the largest relative residuals */
+    std::vector<Type> resHistory_;
+    /** number of block products */
+    int nbMult_;
+    /** time spent in the products */
+    Real multTime_;
+    /** time spent in the preconditioner */
+    Real condTime_;
+    /** total time of the last run */
+    Real elapsedTime_;
 };
 
 } // namespace STK
@@ -0,0 +1,240 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Algebra
+ * Purpose:  Define the Lanczos class.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_Lanczos.h
+ *  @brief In this file we define the Lanczos class computing the largest
+ *  eigenvalues of a symmetric operator.
+ **/
+
+#ifndef STK_LANCZOS_H
+#define STK_LANCZOS_H
+
+#include <Sdk/include/STK_IRunner.h>
+#include <Arrays/include/STK_CArray.h>
+#include <Arrays/include/STK_CArraySquare.h>
+#include <Arrays/include/STK_CArrayVector.h>
+
+#include "STK_SymEigen.h"
+
+namespace STK
+{
+
+/** @ingroup Algebra
+ *  @brief Functor computing the product of a dense symmetric matrix with a
+ *  vector. It can be used as @c MultFunctor in the CG and Lanczos classes.
+ **/
+template<class SquareArray, class ColVector = CVectorX>
+struct SymMultFunctor
+{
+  /** constructor
+   *  @param a the symmetric matrix
+   **/
+  inline SymMultFunctor( SquareArray const& a): a_(a) {}
+  /** @return the product of the matrix with x
+   *  @param x the vector to multiply
+   **/
+  inline ColVector operator()( ColVector const& x) const
+  { ColVector y; y = a_ * x; return y;}
+  /** the symmetric matrix */
+  SquareArray const& a_;
+};
+
+/** @ingroup Algebra
+ *  @brief The Lanczos class computes the @c k largest eigenvalues and the
+ *  corresponding eigenvectors of a symmetric operator @b A given by a functor
+ *  computing the products @b Ax.
+ *
+ *  The method build an orthonormal basis @b V of a Krylov space of dimension
+ *  @c m (with full re-orthogonalization) and the Ritz pairs of @b A are
+ *  computed using the SymEigen class on the small matrix @b V'AV. When the
+ *  residuals of the @c k leading Ritz pairs are not small enough, the method
+ *  is restarted keeping the leading Ritz vectors (thick restart).
+ *
+ *  The products @b Ax are never stored except for the current basis, so that
+ *  a Gram matrix or a covariance matrix can be decomposed without forming it.
+ *
+ *  @tparam MultFunctor A functor computing the result of @b Ax.
+ *  @tparam ColVector The type of the vectors used by the functor.
+ **/
+template<class MultFunctor, class ColVector = CVectorX>
+class Lanczos : public IRunnerBase
+{
+  public:
+    /** Constructor
+     *  @param mult functor which compute @b Ax
+     *  @param range the range of the vectors @b x
+     *  @param nbEigen the number of eigenvalues to compute
+     *  @param nbVectors the dimension of the Krylov space (0 for default)
+     *  @param tol tolerance on the residuals relative to the largest eigenvalue
+     **/
+    Lanczos( MultFunctor const& mult, Range const& range, int nbEigen
+           , int nbVectors = 0, Real tol = 1e-10)
+           : IRunnerBase(), p_mult_(&mult), range_(range), nbEigen_(nbEigen)
+           , nbVectors_(nbVectors), tol_(tol), maxRestart_(100)
+           , eigenValues_(), eigenVectors_(), nbMult_(0), nbRestart_(0)
+    {}
+    /** destructor */
+    virtual ~Lanczos() {}
+    /** @return the eigenvalues in decreasing order */
+    inline CVectorX const& eigenValues() const { return eigenValues_;}
+    /** @return the eigenvectors (in columns) */
+    inline CArrayXX const& eigenVectors() const { return eigenVectors_;}
+    /** @return the number of products @b Ax computed */
+    inline int nbMult() const { return nbMult_;}
+    /** @return the number of restarts */
+    inline int nbRestart() const { return nbRestart_;}
+    /** @param tol the tolerance on the residuals */
+    inline void setTol(Real const& tol) { tol_ = tol;}
+    /** @param maxRestart the maximal number of restarts */
+    inline void setMaxRestart(int maxRestart) { maxRestart_ = maxRestart;}
+    /** compute the eigenvalues.
+     *  @return @c true if the eigenpairs have converged, @c false otherwise
+     **/
+    virtual bool run();
+
+  private:
+    /** pointer on the functor performing @b Ax */
+    MultFunctor const* p_mult_;
+    /** range of the vectors */
+    Range range_;
+    /** number of eigenvalues to compute */
+    int nbEigen_;
+    /** dimension of the Krylov space */
+    int nbVectors_;
+    /** tolerance */
+    Real tol_;
+    /** maximal number of restarts */
+    int maxRestart_;
+    /** the eigenvalues */
+    CVectorX eigenValues_;
+    /** the eigenvectors */
+    CArrayXX eigenVectors_;
+    /** number of products computed */
+    int nbMult_;
+    /** number of restarts */
+    int nbRestart_;
+    /** orthogonalize r against the @c nbCols first columns of V (twice)
+     *  @return the norm of r
+     **/
+    static Real orthogonalize(CArrayXX const& V, int nbCols, CVectorX& r);
+};
+
+template<class MultFunctor, class ColVector>
+bool Lanczos<MultFunctor, ColVector>::run()
+{
+  const int n = range_.size();
+  const int k = std::min(nbEigen_, n);
+  if (k <= 0)
+  { msg_error_ = STKERROR_NO_ARG(Lanczos::run,nbEigen must be positive);
+    return false;
+  }
+  int m = (nbVectors_ > 0) ? nbVectors_ : std::max(2*k, k+20);
+  m = std::min(std::max(m, k+1), n);
+  // number of Ritz vectors kept at each restart
+  const int q = std::min(k + (m-k)/2, m-1);
+  CArrayXX V(n, m, 0.), W(n, m, 0.);
+  V.shift(range_.begin(), 0);
+  W.shift(range_.begin(), 0);
+  CVectorX r(range_);
+  ColVector x(range_);
+  r.randGauss();
+  nbMult_ = 0; nbRestart_ = 0;
+  int first = 0;
+  bool converged = false;
+  CSquareX H(m);
+  CVectorX res(k);
+  while (true)
+  {
+    // extend the basis
+    for (int j = first; j < m; ++j)
+    {
+      const Real rnorm = r.norm();
+      Real norm = orthogonalize(V, j, r);
+      // invariant subspace found: restart with a random direction
+      if (norm <= Arithmetic<Real>::epsilon() * n * rnorm)
+      { r.randGauss(); norm = orthogonalize(V, j, r);}
+      V.col(j) = r / norm;
+      x = V.col(j);
+      W.col(j) = (*p_mult_)(x);
+      ++nbMult_;
+      r = W.col(j);
+    }
+    // Rayleigh-Ritz
+    CArrayXX VtW = V.transpose() * W;
+    for (int j = 0; j < m; ++j)
+      for (int i = 0; i <= j; ++i)
+      { H(i, j) = H(j, i) = 0.5 * (VtW(i, j) + VtW(j, i));}
+    SymEigen<CSquareX> eigen(H);
+    eigen.run();
+    CArrayXX S = eigen.rotation().col(Range(0, q));
+    CArrayXX VS = V * S, WS = W * S;
+    Real scale = std::max(std::abs(eigen.eigenValues()[0]), Arithmetic<Real>::min());
+    converged = true;
+    for (int i = 0; i < k; ++i)
+    {
+      res[i] = (WS.col(i) - eigen.eigenValues()[i] * VS.col(i)).norm();
+      if (res[i] > tol_ * scale) converged = false;
+    }
+    if (converged || nbRestart_ >= maxRestart_ || m == n)
+    {
+      eigenValues_ = eigen.eigenValues().sub(Range(0, k));
+      eigenVectors_ = VS.col(Range(0, k));
+      break;
+    }
+    // thick restart: keep the q leading Ritz vectors and continue with the
+    // residual of the Krylov basis
+    orthogonalize(V, m, r);
+    V.col(Range(0, q)) = VS;
+    W.col(Range(0, q)) = WS;
+    first = q;
+    ++nbRestart_;
+  }
+  if (!converged && m < n)
+  { msg_error_ = STKERROR_NO_ARG(Lanczos::run,maximal number of restarts reached);
+    return false;
+  }
+  return true;
+}
+
+template<class MultFunctor, class ColVector>
+Real Lanczos<MultFunctor, ColVector>::orthogonalize(CArrayXX const& V, int nbCols, CVectorX& r)
+{
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    for (int i = 0; i < nbCols; ++i)
+    { r -= V.col(i).dot(r) * V.col(i);}
+  }
+  return r.norm();
+}
+
+} // namespace STK
+
+#endif /* STK_LANCZOS_H */
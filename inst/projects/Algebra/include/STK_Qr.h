@@ -39,6 +39,12 @@
 #include "STK_IQr.h"
 #include "../include/STK_Givens.h"
 #include "Arrays/include/STK_Array2DPoint.h"
+#include "Arrays/include/STK_CArray.h"
+#include "Arrays/include/STK_CArrayVector.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #ifdef STK_ALGEBRA_DEBUG
 #include "../../Arrays/include/STK_Display.h"
@@ -124,28 +130,167 @@ class Qr: public IQr<Qr<Array> >
     inline bool runImpl() { qr(); return true;}
 
   private:
-  /** Compute the qr decomposition of the matrix Q_ */
+    /** number of columns of the panels of the blocked algorithm */
+    enum { panelSize_ = 32 };
+    /** number of rows processed by a thread in the trailing updates */
+    enum { rowBlockSize_ = 1024 };
+    /** Compute the qr decomposition of the matrix Q_ */
     void qr();
+    /** Apply the block reflector \f$ (I + V T V')' \f$ of the panel to the
+     *  trailing columns of Q_.
+     *  @param rows the rows of the panel
+     *  @param panel the columns of the panel
+     *  @param trailing the columns to update
+     **/
+    void applyBlockReflector(Range const& rows, Range const& panel, Range const& trailing);
 };
 
-/* Computation of the QR decomposition */
+/* Computation of the QR decomposition.
+ * The columns are processed by panels. The householder reflectors of a panel
+ * are computed with the unblocked algorithm, then they are applied to the
+ * trailing columns using the compact WY representation.
+ */
 template<class Array>
 void Qr<Array>::qr()
 {
   typedef typename Array::SubCol ColVector;
   R_.resize(Q_.rows(), Q_.cols());
-  // start left householder reflections
-  Range r(Q_.rows()), c(Q_.cols());
-  for(int j = R_.beginRows(); (j < R_.endRows()) && (j < R_.endCols()) ; ++j)
+  int end = Q_.beginCols() + std::min(Q_.sizeRows(), Q_.sizeCols());
+  for(int j = Q_.beginCols(); j < end; j += panelSize_)
   {
-    ColVector u(Q_, r, j);// get a reference on the j-th column in the range r
-    R_(j, j) = house(u);  // compute the housolder vector
-    leftHouseholder(Q_.sub(r, c.incFirst(1)), u); // apply-it to the remaining part of Q_
-    R_.row(j, c).copy(Q_.row(j, c)); // copy current row of Q_ in the range c in R_
-    r.incFirst(1);        // decrease the range
+    Range panel(j, std::min(int(panelSize_), end - j));
+    // start left householder reflections in the panel
+    Range r(j, Q_.endRows() - j), c(panel);
+    for(int k = panel.begin(); k < panel.end(); ++k)
+    {
+      ColVector u(Q_, r, k); // get a reference on the k-th column in the range r
+      R_(k, k) = house(u);   // compute the housolder vector
+      leftHouseholder(Q_.sub(r, c.incFirst(1)), u); // apply-it to the remaining part of the panel
+      r.incFirst(1);         // decrease the range
+    }
+    // apply the reflectors to the trailing part of Q_
+    Range trailing(panel.end(), Q_.endCols() - panel.end());
+    if (trailing.size() > 0)
+    { applyBlockReflector(Range(j, Q_.endRows() - j), panel, trailing);}
+    // copy current rows of Q_ in R_
+    for(int k = panel.begin(); k < panel.end(); ++k)
+    {
+      Range c(k+1, Q_.endCols() - k - 1);
+      R_.row(k, c).copy(Q_.row(k, c));
+    }
   }
 }
 
+/* The product \f$ H_1 \ldots H_b \f$ of the reflectors of the panel is
+ * \f$ I + V T V' \f$ with V the unit lower trapezoidal array of the
+ * householder vectors and T an upper triangular array. The trailing array C
+ * is overwritten by \f$ C + V T' (V' C) \f$. V is split in its upper (unit
+ * triangular) part V1 and its lower part V2, which is used in place.
+ */
+template<class Array>
+void Qr<Array>::applyBlockReflector(Range const& rows, Range const& panel, Range const& trailing)
+{
+  int nb = panel.size();
+  Range top(rows.begin(), nb), bottom(rows.begin() + nb, rows.size() - nb);
+  // upper part of V and betas of the reflectors
+  CArrayXX V1(nb, nb, 0.);
+  V1.shift(top.begin(), panel.begin());
+  CVectorX beta(nb);
+  beta.shift(panel.begin());
+  for (int k = panel.begin(), i = top.begin(); k < panel.end(); ++k, ++i)
+  {
+    beta[k] = Q_(i, k);
+    V1(i, k) = 1.;
+    for (int l = i+1; l < top.end(); ++l) { V1(l, k) = Q_(l, k);}
+  }
+  // compute V'V and T
+  CArrayXX VtV = V1.transpose() * V1;
+  if (bottom.size() > 0) { VtV += Q_.sub(bottom, panel).transpose() * Q_.sub(bottom, panel);}
+  CArrayXX T(nb, nb, 0.);
+  T.shift(panel.begin(), panel.begin());
+  for (int k = panel.begin(); k < panel.end(); ++k)
+  {
+    T(k, k) = beta[k];
+    for (int l = panel.begin(); l < k; ++l)
+    {
+      Real sum = 0.;
+      for (int p = l; p < k; ++p) { sum += T(l, p) * VtV(p, k);}
+      T(l, k) = beta[k] * sum;
+    }
+  }
+  // W = T' V' C
+  CArrayXX W = V1.transpose() * Q_.sub(top, trailing);
+  if (bottom.size() > 0) { W += Q_.sub(bottom, panel).transpose() * Q_.sub(bottom, trailing);}
+  W = T.transpose() * W;
+  // C += V W, the rows of C are updated in parallel
+  Q_.sub(top, trailing) += V1 * W;
+  int nbBlocks = (bottom.size() + rowBlockSize_ - 1)/rowBlockSize_;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int b = 0; b < nbBlocks; ++b)
+  {
+    int first = bottom.begin() + b * rowBlockSize_;
+    Range block(first, std::min(int(rowBlockSize_), bottom.end() - first));
+    Q_.sub(block, trailing) += Q_.sub(block, panel) * W;
+  }
+}
+
+/** @ingroup Algebra
+ *  @brief Compute the R factor of the QR decomposition of a tall and skinny
+ *  array using the TSQR algorithm.
+ *
+ *  The rows of @c A are split in blocks which are decomposed in parallel.
+ *  The R factors of the blocks are then stacked and decomposed again. The
+ *  result is the R factor of @c A up to the signs of its rows.
+ *
+ *  In order to solve a least square problem \f$ \min \|Ax-b\| \f$,
+ *  decompose the array [A b]: the last column of R contains \f$ Q'b \f$
+ *  and the norm of the residuals.
+ *  @param A the array to decompose
+ *  @param R the R factor of A
+ *  @param nbBlock number of blocks of rows (0 for the number of threads)
+ **/
+template <class Array>
+void tsqr( ArrayBase<Array> const& A, ArrayUpperTriangularXX& R, int nbBlock = 0)
+{
+  int p = A.sizeCols();
+  if (nbBlock <= 0)
+  {
+#ifdef _OPENMP
+    nbBlock = omp_get_max_threads();
+#else
+    nbBlock = 1;
+#endif
+  }
+  // each block must have at least p rows
+  nbBlock = std::max(1, std::min(nbBlock, A.sizeRows()/std::max(p, 1)));
+  int blockSize = A.sizeRows()/nbBlock;
+  // decompose the blocks and stack the R factors
+  CArrayXX stack(nbBlock * p, p, 0.);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int b = 0; b < nbBlock; ++b)
+  {
+    int first = A.beginRows() + b * blockSize;
+    int size  = (b == nbBlock-1) ? A.endRows() - first : blockSize;
+    CArrayXX block(size, p);
+    for (int j = 0; j < p; ++j)
+      for (int i = 0; i < size; ++i) { block(i, j) = A.elt(first + i, A.beginCols() + j);}
+    Qr<CArrayXX> qr(block, true);
+    qr.run();
+    for (int i = 0; i < std::min(size, p); ++i)
+      for (int j = i; j < p; ++j) { stack(b * p + i, j) = qr.R()(i, j);}
+  }
+  // decompose the stacked R factors
+  Qr<CArrayXX> qr(stack, true);
+  qr.run();
+  R.resize(A.cols(), A.cols());
+  R = 0.;
+  for (int i = 0; i < std::min(stack.sizeRows(), p); ++i)
+    for (int j = i; j < p; ++j) { R(A.beginCols() + i, A.beginCols() + j) = qr.R()(i, j);}
+}
 
 } // namespace STK
 
@@ -0,0 +1,330 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Algebra
+ * Purpose:  Define the RandomizedSvd class.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_RandomizedSvd.h
+ *  @brief In this file we define the RandomizedSvd class computing the
+ *  leading singular triplets of an array.
+ **/
+
+#ifndef STK_RANDOMIZEDSVD_H
+#define STK_RANDOMIZEDSVD_H
+
+#include <vector>
+
+#include <Sdk/include/STK_IRunner.h>
+#include <Arrays/include/STK_CArray.h>
+#include <Arrays/include/STK_CArrayVector.h>
+#include <Arrays/include/STK_CArrayPoint.h>
+
+#include "STK_GramSchmidt.h"
+#include "STK_Svd.h"
+
+namespace STK
+{
+
+/** @ingroup Algebra
+ *  @brief The RandomizedSvd class compute the @c dim leading singular
+ *  values and vectors of an array using the randomized range finder of
+ *  Halko, Martinsson and Tropp.
+ *
+ *  Let @e A be the n by p array to decompose and @e l = dim + oversampling.
+ *  A Gaussian p by l array @e Omega is drawn and the range of @e A is
+ *  approximated by the orthonormalized columns of @e Y = A Omega. The
+ *  approximation is refined by @c nbPowerIter subspace iterations. The small
+ *  p by l array @e Z = A'Y is then decomposed using the Svd class, giving
+ *  @f$ A \simeq U D V' @f$ with U = Y V_Z and V = U_Z.
+ *
+ *  The array @e A is not copied: the products @e A Omega and @e A'Y are
+ *  computed by blocks of rows, in parallel if OpenMP is available. The
+ *  decomposition can be computed on the centered and scaled array
+ *  @f$ D_r (A - 1 \mu') D_c @f$ without building it, see the methods
+ *  @c setCenter, @c setRowsScaling and @c setColsScaling.
+ *
+ *  The singular vectors are stored in the arrays U (of size n by dim, with the
+ *  rows of A) and V (of size p by dim, with the columns of A), the singular
+ *  values in the vector D (indexed from 0).
+ **/
+template<class Array>
+class RandomizedSvd : public IRunnerWithData<Array>
+{
+  public:
+    typedef IRunnerWithData<Array> Base;
+    using Base::p_data_;
+    using Base::msg_error_;
+    /** default size of the blocks of rows */
+    enum { blockSize_ = 1024 };
+    /** maximal number of partial sums of A'Y */
+    enum { maxChunks_ = 16 };
+    /** constructor.
+     *  @param A the array to decompose
+     *  @param dim the number of singular triplets to compute
+     *  @param nbOverSampling the number of additional random directions
+     *  @param nbPowerIter the number of subspace iterations
+     **/
+    RandomizedSvd( Array const& A, int dim, int nbOverSampling = 10, int nbPowerIter = 2)
+                 : Base(A), dim_(dim), nbOverSampling_(nbOverSampling), nbPowerIter_(nbPowerIter)
+                 , center_(), rowsScale_(), colsScale_()
+                 , U_(), D_(), V_(), norm_(0.), rank_(0)
+    {}
+    /** destructor */
+    virtual ~RandomizedSvd() {}
+    /** @return the number of singular triplets computed */
+    inline int dim() const { return dim_;}
+    /** @return the rank of the decomposition */
+    inline int rank() const { return rank_;}
+    /** @return the largest singular value */
+    inline Real normSup() const { return norm_;}
+    /** @return the left singular vectors */
+    inline CArrayXX const& getU() const { return U_;}
+    /** @return the singular values */
+    inline CVectorX const& getD() const { return D_;}
+    /** @return the right singular vectors */
+    inline CArrayXX const& getV() const { return V_;}
+    /** set the number of subspace iterations
+     *  @param nbPowerIter the number of iterations
+     **/
+    inline void setNbPowerIter(int nbPowerIter) { nbPowerIter_ = nbPowerIter;}
+    /** decompose the centered array @f$ A - 1 \mu' @f$.
+     *  @param center the values to subtract to each row of A
+     **/
+    template<class Center>
+    inline void setCenter(ExprBase<Center> const& center) { center_ = center.asDerived();}
+    /** decompose the rows scaled array @f$ D_r A @f$.
+     *  @param scale the scaling factors of the rows
+     **/
+    template<class Scale>
+    inline void setRowsScaling(ExprBase<Scale> const& scale) { rowsScale_ = scale.asDerived();}
+    /** decompose the columns scaled array @f$ A D_c @f$.
+     *  @param scale the scaling factors of the columns
+     **/
+    template<class Scale>
+    inline void setColsScaling(ExprBase<Scale> const& scale) { colsScale_ = scale.asDerived();}
+    /** run the decomposition
+     *  @return @c true if no error occur, @c false otherwise
+     **/
+    virtual bool run();
+
+  private:
+    /** number of singular triplets to compute */
+    int dim_;
+    /** number of additional random directions */
+    int nbOverSampling_;
+    /** number of subspace iterations */
+    int nbPowerIter_;
+    /** centers of the columns (not used if empty) */
+    CPointX center_;
+    /** scaling of the rows (not used if empty) */
+    CVectorX rowsScale_;
+    /** scaling of the columns (not used if empty) */
+    CPointX colsScale_;
+    /** left singular vectors */
+    CArrayXX U_;
+    /** singular values */
+    CVectorX D_;
+    /** right singular vectors */
+    CArrayXX V_;
+    /** the largest singular value */
+    Real norm_;
+    /** rank of the decomposition */
+    int rank_;
+    /** compute Y = D_r (A - 1 mu') D_c Z
+     *  @param Z the p by l array to multiply (with the columns of A as rows)
+     *  @param Y the n by l result (with the rows of A as rows)
+     **/
+    void multiply(CArrayXX const& Z, CArrayXX& Y) const;
+    /** compute Z = D_c (A - 1 mu')' D_r Y
+     *  @param Y the n by l array to multiply (with the rows of A as rows)
+     *  @param Z the p by l result (with the columns of A as rows)
+     **/
+    void multiplyTranspose(CArrayXX const& Y, CArrayXX& Z) const;
+};
+
+template<class Array>
+bool RandomizedSvd<Array>::run()
+{
+  if (!p_data_)
+  { msg_error_ = STKERROR_NO_ARG(RandomizedSvd::run,data is not set);
+    return false;
+  }
+  Array const& A = *p_data_;
+  const int n = A.sizeRows(), p = A.sizeCols();
+  const int minDim = std::min(n, p);
+  if (dim_ <= 0 || minDim == 0)
+  { msg_error_ = STKERROR_NO_ARG(RandomizedSvd::run,dimension must be positive);
+    return false;
+  }
+  if ( (!center_.empty() && center_.range() != A.cols())
+     ||(!rowsScale_.empty() && rowsScale_.range() != A.rows())
+     ||(!colsScale_.empty() && colsScale_.range() != A.cols())
+     )
+  { msg_error_ = STKERROR_NO_ARG(RandomizedSvd::run,center or scaling with wrong range);
+    return false;
+  }
+  dim_ = std::min(dim_, minDim);
+  const int l = std::min(dim_ + std::max(nbOverSampling_, 0), minDim);
+  // random projection of the range of A
+  CArrayXX Z(p, l), Y(n, l);
+  Z.shift(A.beginCols(), 0);
+  Y.shift(A.beginRows(), 0);
+  Z.randGauss();
+  multiply(Z, Y);
+  gramSchmidt(Y);
+  // subspace iterations
+  for (int iter = 0; iter < nbPowerIter_; ++iter)
+  {
+    multiplyTranspose(Y, Z);
+    gramSchmidt(Z);
+    multiply(Z, Y);
+    gramSchmidt(Y);
+  }
+  // project A on the range found and decompose the small array Z = A'Y
+  multiplyTranspose(Y, Z);
+  Z.shift(0, 0);
+  Svd<CArrayXX> svd(Z, false, true, true);
+  if (!svd.run())
+  { msg_error_ = svd.error();
+    return false;
+  }
+  // A = Y Z' = (Y V_Z) D U_Z'
+  Range range(0, dim_);
+  U_.resize(A.rows(), range);
+  V_.resize(A.cols(), range);
+  D_.resize(range);
+  for (int k = 0; k < dim_; ++k)
+  {
+    const int kd = svd.getD().begin() + k;
+    D_[k] = svd.getD()[kd];
+    for (int j = 0; j < p; ++j)
+    { V_(A.beginCols() + j, k) = svd.getU()(svd.getU().beginRows() + j, svd.getU().beginCols() + k);}
+    for (int i = A.beginRows(); i < A.endRows(); ++i)
+    {
+      Real sum = 0.;
+      for (int m = 0; m < l; ++m)
+      { sum += Y(i, m) * svd.getV()(svd.getV().beginRows() + m, svd.getV().beginCols() + k);}
+      U_(i, k) = sum;
+    }
+  }
+  norm_ = (dim_ > 0) ? D_[0] : 0.;
+  rank_ = 0;
+  const Real tol = Arithmetic<Real>::epsilon() * std::max(n, p) * norm_;
+  for (int k = 0; k < dim_; ++k) { if (D_[k] > tol) ++rank_;}
+  return true;
+}
+
+template<class Array>
+void RandomizedSvd<Array>::multiply(CArrayXX const& Z, CArrayXX& Y) const
+{
+  Array const& A = *p_data_;
+  const int l = Z.sizeCols();
+  // scale Z by the columns factors and compute the contribution of the center
+  CArrayXX Zs(Z);
+  if (!colsScale_.empty())
+  {
+    for (int j = A.beginCols(); j < A.endCols(); ++j)
+    { Zs.row(j) *= colsScale_[j];}
+  }
+  CPointX muZ(l, 0.);
+  if (!center_.empty())
+  {
+    for (int k = 0; k < l; ++k)
+    {
+      Real sum = 0.;
+      for (int j = A.beginCols(); j < A.endCols(); ++j) { sum += center_[j] * Zs(j, k);}
+      muZ[k] = sum;
+    }
+  }
+  // Y = A Zs by blocks of rows
+  const int nbBlocks = (A.sizeRows() + blockSize_ - 1)/blockSize_;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int b = 0; b < nbBlocks; ++b)
+  {
+    const int first = A.beginRows() + b * blockSize_;
+    Range rows(first, std::min(int(blockSize_), A.endRows() - first));
+    Y.row(rows) = A.row(rows) * Zs;
+    for (int k = 0; k < l; ++k)
+    {
+      for (int i = rows.begin(); i < rows.end(); ++i)
+      {
+        Y(i, k) -= muZ[k];
+        if (!rowsScale_.empty()) { Y(i, k) *= rowsScale_[i];}
+      }
+    }
+  }
+}
+
+template<class Array>
+void RandomizedSvd<Array>::multiplyTranspose(CArrayXX const& Y, CArrayXX& Z) const
+{
+  Array const& A = *p_data_;
+  const int l = Y.sizeCols();
+  CArrayXX Ys(Y);
+  if (!rowsScale_.empty())
+  {
+    for (int i = A.beginRows(); i < A.endRows(); ++i)
+    { Ys.row(i) *= rowsScale_[i];}
+  }
+  // Z = A' Ys summed over a fixed number of chunks of rows, so that the
+  // result does not depend on the number of threads
+  const int nbChunks = std::max(1, std::min(int(maxChunks_), A.sizeRows()/int(blockSize_)));
+  const int chunkSize = A.sizeRows()/nbChunks;
+  std::vector<CArrayXX> partial(nbChunks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int c = 0; c < nbChunks; ++c)
+  {
+    const int first = A.beginRows() + c * chunkSize;
+    Range rows(first, (c == nbChunks-1) ? A.endRows() - first : chunkSize);
+    partial[c] = A.row(rows).transpose() * Ys.row(rows);
+  }
+  Z = partial[0];
+  for (int c = 1; c < nbChunks; ++c) { Z += partial[c];}
+  // remove the contribution of the center and scale
+  if (!center_.empty())
+  {
+    for (int k = 0; k < l; ++k)
+    {
+      const Real sum = Ys.col(k).sum();
+      for (int j = A.beginCols(); j < A.endCols(); ++j) { Z(j, k) -= center_[j] * sum;}
+    }
+  }
+  if (!colsScale_.empty())
+  {
+    for (int j = A.beginCols(); j < A.endCols(); ++j)
+    { Z.row(j) *= colsScale_[j];}
+  }
+}
+
+} // namespace STK
+
+#endif /* STK_RANDOMIZEDSVD_H */
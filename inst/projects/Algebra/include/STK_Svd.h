@@ -258,7 +258,7 @@ bool Svd<Array>::computeSvd()
   U_.shift(beginRow, beginCol);
   D_.shift(beginCol);
   V_.shift(beginCol); // U_*D_.diagonalize()*VT_ will work
-  return error;
+  return !error;
 }
 
 
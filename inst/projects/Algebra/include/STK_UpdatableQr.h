@@ -0,0 +1,245 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Algebra
+ * Purpose:  Define the UpdatableQr class.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_UpdatableQr.h
+ *  @brief In this file we define the UpdatableQr class maintaining the
+ *  triangular factor of a QR decomposition when rows are added or removed.
+ **/
+
+#ifndef STK_UPDATABLEQR_H
+#define STK_UPDATABLEQR_H
+
+#include <Arrays/include/STK_CArray.h>
+#include "STK_Givens.h"
+
+namespace STK
+{
+/** @ingroup Algebra
+ *  @brief The UpdatableQr class maintains the upper triangular factor @b R of
+ *  the QR decomposition of a matrix @b A whose rows are given one by one.
+ *  The matrix @b Q is never stored, so that @b R'R = A'A.
+ *
+ *  - A row is added using @c m Givens rotations, in O(m^2) operations, @c m
+ *  being the number of columns of @b A.
+ *  - A row is removed using hyperbolic rotations (Cholesky downdate), in
+ *  O(m^2) operations. The removal fails if the resulting matrix is not
+ *  positive definite anymore.
+ *  - If the forgetting factor @e lambda is lower than 1, the factor is
+ *  multiplied by @f$ \sqrt{\lambda} @f$ before each added row, so that the
+ *  weight of a row decreases exponentially with its age.
+ *
+ *  If the columns of @b A are the @c p regressors followed by the @c q
+ *  responses of a regression, the least square coefficients are the
+ *  solution of the triangular system @f$ R_{11}\beta = R_{12} @f$ and the
+ *  cross-product of the residuals is @f$ R_{22}'R_{22} @f$. These quantities
+ *  are computed by the methods @c leastSquare and @c residualsCrossProduct.
+ **/
+class UpdatableQr
+{
+  public:
+    /** Constructor.
+     *  @param nbCols the number of columns of the matrix
+     *  @param lambda the forgetting factor
+     **/
+    inline UpdatableQr( int nbCols = 0, Real lambda = 1.)
+                      : R_(nbCols, nbCols, 0.), w_(nbCols), lambda_(lambda), sumWeights_(0.)
+    {}
+    /** destructor */
+    inline ~UpdatableQr() {}
+    /** @return the number of columns of the matrix */
+    inline int nbCols() const { return R_.sizeCols();}
+    /** @return the (discounted) sum of the weights of the rows */
+    inline Real sumWeights() const { return sumWeights_;}
+    /** @return the forgetting factor */
+    inline Real forgetting() const { return lambda_;}
+    /** @return the upper triangular factor (with rows and columns starting at 0) */
+    inline CArrayXX const& R() const { return R_;}
+    /** @param lambda the forgetting factor, it should be in ]0,1] */
+    inline void setForgetting( Real lambda) { lambda_ = lambda;}
+    /** clear the factor and set the number of columns
+     *  @param nbCols the number of columns of the matrix
+     **/
+    inline void resize( int nbCols)
+    { R_.resize(nbCols, nbCols); R_ = 0.; w_.resize(nbCols); sumWeights_ = 0.;}
+    /** multiply all the (past) rows by @f$ \sqrt{\lambda} @f$.
+     *  @param lambda the forgetting factor
+     **/
+    inline void forget( Real lambda)
+    {
+      if (lambda == 1.) return;
+      const Real s = std::sqrt(lambda);
+      for (int j=0; j<nbCols(); ++j)
+        for (int i=0; i<=j; ++i) { R_(i, j) *= s;}
+      sumWeights_ *= lambda;
+    }
+    /** add a row to the matrix.
+     *  @param row the row to add
+     *  @param weight the weight of the row
+     **/
+    template<class Row>
+    void addRow( Row const& row, Real weight = 1.)
+    {
+      if (row.size() != nbCols())
+      { STKRUNTIME_ERROR_2ARG(UpdatableQr::addRow,row.size(),nbCols(),sizes mismatch);}
+      forget(lambda_);
+      const Real s = std::sqrt(weight);
+      for (int j=0; j<nbCols(); ++j) { w_[j] = s * row[row.begin() + j];}
+      rotate();
+      sumWeights_ += weight;
+    }
+    /** add the rows of an array to the matrix.
+     *  @param a the rows to add
+     **/
+    template<class Array>
+    void addRows( Array const& a)
+    {
+      for (int i=a.beginRows(); i<a.endRows(); ++i) { addRow(a.row(i));}
+    }
+    /** add the weighted rows of an array to the matrix.
+     *  @param a the rows to add
+     *  @param weights the weights of the rows
+     **/
+    template<class Array, class Weights>
+    void addRows( Array const& a, Weights const& weights)
+    {
+      for (int i=a.beginRows(); i<a.endRows(); ++i) { addRow(a.row(i), weights[i]);}
+    }
+    /** remove a row from the matrix. The forgetting factor is not applied.
+     *  @param row the row to remove, it must have been added with the same
+     *  weight (and must not have been discounted since)
+     *  @param weight the weight of the row
+     *  @return @c false if the resulting matrix is not positive definite, in
+     *  this case the factor is not modified.
+     **/
+    template<class Row>
+    bool removeRow( Row const& row, Real weight = 1.)
+    {
+      if (row.size() != nbCols())
+      { STKRUNTIME_ERROR_2ARG(UpdatableQr::removeRow,row.size(),nbCols(),sizes mismatch);}
+      const Real s = std::sqrt(weight);
+      for (int j=0; j<nbCols(); ++j) { w_[j] = s * row[row.begin() + j];}
+      CArrayXX R(R_);
+      for (int k=0; k<nbCols(); ++k)
+      {
+        if (w_[k] == 0.) continue;
+        const Real rkk = R(k, k), r2 = (rkk - w_[k]) * (rkk + w_[k]);
+        if (r2 <= 0.) return false;
+        const Real r = std::sqrt(r2), c = r / rkk, sn = w_[k] / rkk;
+        R(k, k) = r;
+        for (int j=k+1; j<nbCols(); ++j)
+        {
+          const Real rkj = (R(k, j) - sn * w_[j]) / c;
+          w_[j] = c * w_[j] - sn * rkj;
+          R(k, j) = rkj;
+        }
+      }
+      R_.move(R);
+      sumWeights_ -= weight;
+      return true;
+    }
+    /** compute the least square coefficients of the last columns of the
+     *  matrix regressed on its @c nbVar first columns.
+     *  @param nbVar the number of regressors
+     *  @param coefs the coefficients (with rows and columns starting at 0)
+     *  @param tol the relative tolerance used to detect the rank deficiency.
+     *  The coefficients of the dependent regressors are set to zero.
+     *  @return the rank of the regressors
+     **/
+    int leastSquare( int nbVar, CArrayXX& coefs, Real tol = Arithmetic<Real>::epsilon()) const
+    {
+      const int q = nbCols() - nbVar;
+      coefs.resize(nbVar, q);
+      coefs = 0.;
+      Real maxDiag = 0.;
+      for (int k=0; k<nbVar; ++k) { maxDiag = std::max(maxDiag, std::abs(R_(k, k)));}
+      const Real eps = tol * nbVar * maxDiag;
+      int rank = 0;
+      for (int k=nbVar-1; k>=0; --k)
+      {
+        if (std::abs(R_(k, k)) <= eps) continue;
+        ++rank;
+        for (int l=0; l<q; ++l)
+        {
+          Real sum = R_(k, nbVar + l);
+          for (int j=k+1; j<nbVar; ++j) { sum -= R_(k, j) * coefs(j, l);}
+          coefs(k, l) = sum / R_(k, k);
+        }
+      }
+      return rank;
+    }
+    /** compute the cross-product of the residuals of the least square
+     *  regression of the last columns on the @c nbVar first columns.
+     *  @param nbVar the number of regressors
+     *  @param cross the cross-product (with rows and columns starting at 0)
+     **/
+    void residualsCrossProduct( int nbVar, CArrayXX& cross) const
+    {
+      const int q = nbCols() - nbVar;
+      cross.resize(q, q);
+      for (int l=0; l<q; ++l)
+        for (int m=0; m<=l; ++m)
+        {
+          Real sum = 0.;
+          for (int k=nbVar; k<=nbVar+m; ++k) { sum += R_(k, nbVar+l) * R_(k, nbVar+m);}
+          cross(l, m) = sum; cross(m, l) = sum;
+        }
+    }
+
+  private:
+    /** the upper triangular factor */
+    CArrayXX R_;
+    /** work vector */
+    std::vector<Real> w_;
+    /** forgetting factor */
+    Real lambda_;
+    /** discounted sum of the weights */
+    Real sumWeights_;
+    /** eliminate the work vector in the factor using Givens rotations */
+    void rotate()
+    {
+      for (int k=0; k<nbCols(); ++k)
+      {
+        if (w_[k] == 0.) continue;
+        Real c, s;
+        R_(k, k) = compGivens(R_(k, k), w_[k], c, s);
+        for (int j=k+1; j<nbCols(); ++j)
+        {
+          const Real rkj = R_(k, j), wj = w_[j];
+          R_(k, j) = c * rkj + s * wj;
+          w_[j]    = c * wj  - s * rkj;
+        }
+      }
+    }
+};
+
+} // namespace STK
+
+#endif /* STK_UPDATABLEQR_H */
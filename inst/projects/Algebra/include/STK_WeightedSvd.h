@@ -35,6 +35,13 @@
 #ifndef STK_WEIGHTEDSVD_H
 #define STK_WEIGHTEDSVD_H
 
+#include "STK_ISvd.h"
+#include "STK_Svd.h"
+#include "STK_RandomizedSvd.h"
+#ifdef STKUSELAPACK
+#include "STK_lapack_Svd.h"
+#endif
+
 namespace STK
 {
 // forward declaration
@@ -66,7 +73,9 @@ class WeightedSvd: public ISvd< WeightedSvd<Array, WRows, WCols> >
     /** default constructor.
      *  The matrix U_ will be weigthed by this constructor on the fly.
      *  The decomposition will be achieved using lapack (if present) or STK++
-     *  implementations (otherwise) when the methode @© run is called.
+     *  implementations (otherwise) when the methode @c run is called. If
+     *  @c dim is small compared to the dimensions of the matrix, only the
+     *  @c dim leading singular triplets are computed using a RandomizedSvd.
      *  @param a the matrix to decompose
      *  @param wrows, wcols weights of the rows and columns
      *  @param dim the number of left and right eigenVectors required
@@ -78,48 +87,39 @@ class WeightedSvd: public ISvd< WeightedSvd<Array, WRows, WCols> >
     {
       if (wrows.range() != U_.rows()) { wrows_.resize(U_.rows()).setValue(1./U_.sizeRows());}
       else                            { wrows_ /= wrows.sum();}
-      if (wcols.range() != U_.cols()) { wcols_.resize(U_.cols()).setOne();}
+      if (wcols.range() != U_.cols()) { wcols_.resize(U_.cols()).setOnes();}
       dim_ = std::min(dim_, U_.sizeRows());
       dim_ = std::min(dim_, U_.sizeCols());
     }
     /** destructor */
     virtual ~WeightedSvd() {}
     /** run the weighted svd */
-    virtual bool run()
+    bool runImpl()
     {
       U_ = wrows_.diagonalize() * U_ * wcols_.diagonalize();
+      // compute only the leading triplets if they are few
+      if (dim_ > 0 && 4*(dim_ + 10) < std::min(U_.sizeRows(), U_.sizeCols()))
+      { return runRandomized();}
 #ifdef STKUSELAPACK
       lapack::Svd solver(U_, false, this->withU_, this->withV_);
       // if there is no cv, fall back to STK++ svd
-      if (!solver.run())
-      {
-        Svd<CArrayXX> dec(U_, true, this->withU_, this->withV_);
-        if (!dec.run()) return false;
-        else
-        {
-          U_.move(dec.U_);
-          D_ = dec.D_;
-          V_ = dec.V_;
-        }
-      }
-      else
-      {
-        U_.move(solver.U_);
-        D_.move(solver.D_);
-        V_.move(solver.V_);
-      }
-#else
-      Svd<CArrayXX> solver(U_, true, this->withU_, this->withV_);
-      if (!solver.run()) return false;
-      else
+      if (solver.run())
       {
-        U_.move(dec.U_);
-        D_ = dec.D_;
-        V_ = dec.V_;
+        U_ = solver.getU();
+        D_ = solver.getD();
+        V_ = solver.getV();
+        return true;
       }
-
 #endif
-      // weight back
+      Svd<CArrayXX> dec(U_, false, this->withU_, this->withV_);
+      if (!dec.run())
+      { this->msg_error_ = dec.error();
+        return false;
+      }
+      U_ = dec.getU();
+      D_.resize(dec.getD().range());
+      for (int i=D_.begin(); i<D_.end(); ++i) { D_[i] = dec.getD()[i];}
+      V_ = dec.getV();
       return true;
     }
   private:
@@ -129,6 +129,19 @@ class WeightedSvd: public ISvd< WeightedSvd<Array, WRows, WCols> >
     CPointX wcols_;
     /** number of eigenvectors (left and right)*/
     int dim_;
+    /** compute the @c dim_ leading singular triplets of U_ */
+    bool runRandomized()
+    {
+      RandomizedSvd<CArrayXX> solver(U_, dim_);
+      if (!solver.run())
+      { this->msg_error_ = solver.error();
+        return false;
+      }
+      D_ = solver.getD();
+      V_ = solver.getV();
+      U_ = solver.getU();
+      return true;
+    }
 };
 
 } // namespace STK
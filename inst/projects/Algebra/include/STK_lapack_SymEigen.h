@@ -152,6 +152,20 @@ class SymEigen : public ISymEigen<SymEigen<SquareArray> >
      *  referenced if RANGE_ = 'A' or 'V'.
     **/
     inline void setIlAndIu(int il, int iu) { IL_ = il; IU_ = iu;}
+    /** compute only the @c k largest eigenvalues and the corresponding
+     *  eigenvectors (RANGE_='I'). The eigenvalues found are stored in
+     *  decreasing order in the @c k first places of the eigenvalues and the
+     *  remaining eigenvalues and eigenvectors are set to zero.
+     *  @note in this mode the determinant cannot be computed and @c det()
+     *  is NA, @c norm() is the sum of the eigenvalues found.
+     *  @param k the number of eigenvalues to compute
+     **/
+    inline void setLargestEigenValues(int k)
+    {
+      RANGE_ = 'I';
+      IU_ = range_.size();
+      IL_ = std::max(1, IU_ - k + 1);
+    }
     /** @brief clone pattern */
     inline virtual SymEigen* clone() const { return new SymEigen(*this);}
     /** @brief Run eigenvalues decomposition
@@ -417,6 +431,22 @@ bool SymEigen<SquareArray>::runImpl()
   // recover memory
   delete[] p_work;
   delete[] p_iwork;
+  // partial decomposition: rank_ is the number of eigenvalues found. They
+  // are given in increasing order, store them in decreasing order
+  const int nbFound = rank_;
+  if (RANGE_ != 'A' && info == 0)
+  {
+    for (int i=0; i<nbFound/2; ++i)
+    {
+      eigenValues_.swap(i, nbFound-1-i);
+      eigenVectors_.swapCols(i, nbFound-1-i);
+    }
+    for (int i=nbFound; i<range_.size(); ++i)
+    {
+      eigenValues_[i] = 0.;
+      eigenVectors_.col(i) = 0.;
+    }
+  }
 
   // finalize
   data_.shift(range_.begin());
@@ -426,6 +456,7 @@ bool SymEigen<SquareArray>::runImpl()
 //  stk_cout << _T("eigenValues_  (after shift) =\n") << eigenValues_ << "\n";
   this->SupportEigenVectors_.shift(range_.begin());
   this->finalizeStep();
+  if (RANGE_ != 'A') { rank_ = nbFound; det_ = Arithmetic<Real>::NA();}
   // return the result of the computation
   if (!info) return true;
   if (info>0)
@@ -458,6 +489,12 @@ int SymEigen<SquareArray>::syevr( char jobz, char range, char uplo
           &iu, &abstol, m, w, z, &ldz, isuppz, work,
           &lWork, iwork, &liwork, &info);
 #endif
+#else
+  // lapack is not available
+  (void)jobz; (void)range; (void)uplo; (void)n; (void)a; (void)lda;
+  (void)vl; (void)vu; (void)il; (void)iu; (void)abstol; (void)m; (void)w;
+  (void)z; (void)ldz; (void)isuppz; (void)work; (void)lWork; (void)iwork;
+  (void)liwork;
 #endif
   return info;
 }
@@ -39,6 +39,7 @@
 #include <STKernel/include/STK_Range.h>
 #include <Sdk/include/STK_Macros.h>
 #include "STK_IContainerRef.h"
+#include "STK_MemoryArena.h"
 
 namespace STK
 {
@@ -52,6 +53,13 @@ namespace STK
  *  memory can always be wrapped in some way or be a wrapper of
  *  data stored in memory.
  * 
+ *  The memory is allocated in the heap or, if a MemoryArena is active when the
+ *  allocator is created (see the ArenaScope class), in this arena. The arena
+ *  used by an allocator is fixed at its creation and is not exchanged or
+ *  moved with the data. The wrappers do not look for the active arena: they
+ *  use the arena of the wrapped allocator (or the heap if they wrap a
+ *  pointer).
+ *
  *  This class can also be used as a concrete class.
  *  @tparam Type can be any type of data that can be stored in memory.
  **/
@@ -65,6 +73,7 @@ class AllocatorBase: public IContainerRef
     AllocatorBase() : IContainerRef(false)
                            , p_data_(0)
                            , rangeData_()
+                           , p_arena_(MemoryArena::current())
     {}
     /** constructor with specified Range
      *  @param I range of the data
@@ -72,6 +81,7 @@ class AllocatorBase: public IContainerRef
     AllocatorBase( Range const& I) : IContainerRef(false)
                                    , p_data_(0)
                                    , rangeData_()
+                                   , p_arena_(MemoryArena::current())
     { malloc(I);}
     /** Copy constructor.We don't know, how the user classes want to copy the
      *  data if this is not a reference.
@@ -82,12 +92,14 @@ class AllocatorBase: public IContainerRef
                         : IContainerRef(ref)
                         , p_data_(ref ? T.p_data_: 0)
                         , rangeData_(T.rangeData_)
+                        , p_arena_(ref ? T.p_arena_ : MemoryArena::current())
     {/* derived class have to copy the data if ref==false */}
     template<int OtherSize>
     inline AllocatorBase( AllocatorBase<Type, OtherSize> const& T, bool ref = false)
                         : IContainerRef(ref)
                         , p_data_(ref ? T.p_data(): 0)
                         , rangeData_(T.rangeData())
+                        , p_arena_(ref ? T.p_arena() : MemoryArena::current())
     {/* derived class have to copy the data if ref==false */}
     /** @brief Wrapper or copy constructor. It is set as protected as we don't
      *  know, how the end-user want to copy the data.
@@ -99,6 +111,7 @@ class AllocatorBase: public IContainerRef
                         : IContainerRef(ref)
                         , p_data_(ref ? q : 0)
                         , rangeData_(I)
+                        , p_arena_(ref ? 0 : MemoryArena::current())
     { /* derived class have to copy the data if ref==false */}
     /** Wrapper or copy constructor : second form. This constructor assume the
      *  data as a C-like array. Thus the first index is 0 and the last
@@ -111,6 +124,7 @@ class AllocatorBase: public IContainerRef
                         : IContainerRef(ref)
                         , p_data_(ref ? q : 0)
                         , rangeData_(Range(0,size-1))
+                        , p_arena_(ref ? 0 : MemoryArena::current())
     { /* derived class have to copy the data if ref==false */}
 
     /** destructor. */
@@ -126,6 +140,18 @@ class AllocatorBase: public IContainerRef
     inline int lastData() const { return rangeData_.lastIdx();}
     /** @return the size of the data */
     inline int sizeData() const { return rangeData_.size();}
+    /** @return the arena used for the allocations (0 if the heap is used) */
+    inline MemoryArena* p_arena() const { return p_arena_;}
+    /** @brief Set the arena to use for the next allocations.
+     *  @param p_arena the arena to use (0 for the heap)
+     **/
+    void setArena(MemoryArena* p_arena)
+    {
+      if (p_arena == p_arena_) return;
+      if (isOwner())
+        STKRUNTIME_ERROR_NO_ARG(AllocatorBase::setArena, cannot operate on allocated data.);
+      p_arena_ = p_arena;
+    }
     /** @return a pointer on the constant data set*/
     inline Type* const& p_data() const { return p_data_;}
     /** @return a pointer on the data set */
@@ -178,6 +204,15 @@ class AllocatorBase: public IContainerRef
      **/
     AllocatorBase& exchange(AllocatorBase &T)
     {
+      // data stored in different memory pools are physically exchanged
+      if ((p_arena_ != T.p_arena_)&&(isOwner() || T.isOwner()))
+      {
+        AllocatorBase tmp;
+        tmp.p_arena_ = p_arena_;
+        tmp.assign(T);
+        T.assign(*this);
+        return exchange(tmp);
+      }
       std::swap(p_data_, T.p_data_);
       std::swap(rangeData_, T.rangeData_);
       IContainerRef::exchange(T);
@@ -210,12 +245,15 @@ class AllocatorBase: public IContainerRef
      *
      *  @note the data member ref_ is mutable so that T can be passed as a
      *  constant reference.
+     *  @note if T does not use the same memory pool than this, the data are
+     *  copied and T is unchanged.
      *
      *  @param T the allocator to copy as reference
      **/
     AllocatorBase& move( AllocatorBase const& T)
     {
       if (this == &T) return *this;
+      if ((p_arena_ != T.p_arena_)&&(T.isOwner())) { return copy(T);}
       free();
       setPtrData(T.p_data_, T.rangeData_, T.isRef());
       T.setRef(true);
@@ -248,6 +286,17 @@ class AllocatorBase: public IContainerRef
     { p_data_ = p_data; rangeData_ = rangeData; this->setRef(ref);}
 
   private:
+    /** @return @c true if this allocator owns allocated memory */
+    inline bool isOwner() const { return (!this->isRef())&&(p_data_);}
+    /** share the data of T if T does not own its data, copy them otherwise.
+     *  @param T the allocator to assign
+     **/
+    void assign( AllocatorBase const& T)
+    {
+      if (T.isOwner()) { copy(T); return;}
+      free();
+      setPtrData(T.p_data_, T.rangeData_, T.isRef());
+    }
     /** Set the address of the data : this method is not destined
      *  to the end-user.
      *  @param p_data the address to set
@@ -286,6 +335,8 @@ class AllocatorBase: public IContainerRef
     Type* p_data_;
     /** Range of the data */
     AllocRange rangeData_;
+    /** arena used for the allocations, 0 if the heap is used */
+    MemoryArena* p_arena_;
 };
 
 template<typename Type, int Size>
@@ -305,7 +356,7 @@ void AllocatorBase<Type,Size>::malloc( Range const& I)
     // allocate memory
     try
     {
-      setPtrData(new Type[I.size()], Range(0, I.size()), false);
+      setPtrData(Arrays::allocate<Type>(I.size(), p_arena_), Range(0, I.size()), false);
       decPtrData(I.begin());
     }
     catch (std::bad_alloc const& error)
@@ -331,7 +382,7 @@ void AllocatorBase<Type,Size>::realloc( Range const& I)
   try
   {
     // allocate memory and apply increment
-    Type* p  = new Type[I.size()];
+    Type* p  = Arrays::allocate<Type>(I.size(), p_arena_);
      p -= I.begin();
     // no error: copy data
     const int begin = std::max(rangeData_.begin(), I.begin())
@@ -355,7 +406,7 @@ void AllocatorBase<Type,Size>::free()
   if (p_data_)
   {
     incPtrData(firstData());  // translate
-    delete [] p_data_;        // erase
+    Arrays::deallocate(p_data_, sizeData(), p_arena_); // erase
     setDefault();             // set default values
   }
 }
@@ -207,6 +207,9 @@ class ExprBase : public ITContainer<Derived, hidden::Traits<Derived>::structure_
     Type const sum() const;
     /** @return safely the sum of all the elements of this */
     Type const sumSafe() const;
+    /** @return the sum of all the elements of this computed using the
+     *  compensated (Kahan) summation */
+    Type const sumKahan() const;
     /** @return the norm of this*/
     Type const norm() const;
     /** @return the norm of this*/
@@ -117,6 +117,8 @@ struct ApplyFunctorSelector
 
 /** @ingroup Arrays
  *  @brief  class allowing to apply the Functor Funct on each columns of an expression.
+ *  The columns are processed in parallel if the expression is large and the
+ *  columns are too small for being reduced in parallel.
  **/
 template<typename Derived, typename Funct>
 struct ApplyFunctorByCol
@@ -130,6 +132,10 @@ struct ApplyFunctorByCol
   resultByColType operator()()
   {
     resultByColType res(lhs_.cols());
+#ifdef _OPENMP
+#pragma omp parallel for if (  lhs_.sizeRows() < ParallelThreshold \
+                            && double(lhs_.sizeRows())*double(lhs_.sizeCols()) >= ParallelThreshold)
+#endif
     for (int j= lhs_.beginCols(); j < lhs_.endCols(); ++j)
     { res[j] = Funct(lhs_.col(j))();}
     return res;
@@ -138,6 +144,10 @@ struct ApplyFunctorByCol
   resultByColType operator()(bool option)
   {
     resultByColType res(lhs_.cols());
+#ifdef _OPENMP
+#pragma omp parallel for if (  lhs_.sizeRows() < ParallelThreshold \
+                            && double(lhs_.sizeRows())*double(lhs_.sizeCols()) >= ParallelThreshold)
+#endif
     for (int j= lhs_.beginCols(); j < lhs_.endCols(); ++j)
     { res[j] = Funct(lhs_.col(j))( option);}
     return res;
@@ -149,6 +159,10 @@ struct ApplyFunctorByCol
   if (lhs_.cols() != value.cols()) STKRUNTIME_ERROR_NO_ARG(ApplyFunctorByCol::operator(value,option),lhs_.cols()!=value.cols());
 #endif
     resultByColType res(lhs_.cols());
+#ifdef _OPENMP
+#pragma omp parallel for if (  lhs_.sizeRows() < ParallelThreshold \
+                            && double(lhs_.sizeRows())*double(lhs_.sizeCols()) >= ParallelThreshold)
+#endif
     for (int j= lhs_.beginCols(); j < lhs_.endCols(); ++j)
     { res[j] = Funct(lhs_.col(j))(value[j], option);}
     return res;
@@ -210,6 +224,8 @@ struct ApplyWeightedFunctorByCol
 
 /** @ingroup Arrays
  *  @brief class allowing to apply the Functor Funct on each rows of an expression.
+ *  The rows are processed in parallel if the expression is large and the
+ *  rows are too small for being reduced in parallel.
  **/
 template<typename Derived, typename Funct>
 struct ApplyFunctorByRow
@@ -222,6 +238,10 @@ struct ApplyFunctorByRow
   resultByRowType operator()()
   {
     resultByRowType res(lhs_.rows());
+#ifdef _OPENMP
+#pragma omp parallel for if (  lhs_.sizeCols() < ParallelThreshold \
+                            && double(lhs_.sizeRows())*double(lhs_.sizeCols()) >= ParallelThreshold)
+#endif
     for (int i= lhs_.beginRows(); i < lhs_.endRows(); ++i)
     { res[i] = Funct(lhs_.row(i))();}
     return res;
@@ -229,6 +249,10 @@ struct ApplyFunctorByRow
   resultByRowType operator()(bool option)
   {
     resultByRowType res(lhs_.rows());
+#ifdef _OPENMP
+#pragma omp parallel for if (  lhs_.sizeCols() < ParallelThreshold \
+                            && double(lhs_.sizeRows())*double(lhs_.sizeCols()) >= ParallelThreshold)
+#endif
     for (int j= lhs_.beginRows(); j < lhs_.endRows(); ++j)
     { res[j] = Funct(lhs_.row(j))( option);}
     return res;
@@ -239,6 +263,10 @@ struct ApplyFunctorByRow
   if (lhs_.rows() != value.rows()) STKRUNTIME_ERROR_NO_ARG(ApplyFunctorByRow::operator(value,option),lhs_.rows()!=value.rows());
 #endif
     resultByRowType res(lhs_.rows());
+#ifdef _OPENMP
+#pragma omp parallel for if (  lhs_.sizeCols() < ParallelThreshold \
+                            && double(lhs_.sizeRows())*double(lhs_.sizeCols()) >= ParallelThreshold)
+#endif
     for (int j= lhs_.beginRows(); j < lhs_.endRows(); ++j)
     { res[j] = Funct(lhs_.row(j))(value[j], option);}
     return res;
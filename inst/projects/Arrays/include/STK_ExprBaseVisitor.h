@@ -68,7 +68,7 @@ inline typename Visitor::ReturnType ExprBase<Derived>::visit(Visitor& visitor) c
 template<typename Derived>
 inline int ExprBase<Derived>::count() const
 {
-  hidden::CountVisitor<Type> visitor;
+  hidden::CountVisitor<typename hidden::RemoveConst<Type>::Type> visitor;
   return visit(visitor);
 }
 
@@ -76,7 +76,7 @@ inline int ExprBase<Derived>::count() const
 template<typename Derived>
 inline bool const ExprBase<Derived>::any() const
 {
-  hidden::AnyVisitor<Type> visitor;
+  hidden::AnyVisitor<typename hidden::RemoveConst<Type>::Type> visitor;
   return visit(visitor);
 }
 
@@ -84,7 +84,7 @@ inline bool const ExprBase<Derived>::any() const
 template<typename Derived>
 inline bool const ExprBase<Derived>::all() const
 {
-  hidden::AllVisitor<Type> visitor;
+  hidden::AllVisitor<typename hidden::RemoveConst<Type>::Type> visitor;
   return visit(visitor);
 }
 
@@ -97,7 +97,7 @@ inline int ExprBase<Derived>::nbAvailableValues() const
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::minElt( int& row, int& col) const
 {
-  hidden::MinEltVisitor<Type> visitor;
+  hidden::MinEltVisitor<typename hidden::RemoveConst<Type>::Type> visitor;
   visit(visitor);
   row = visitor.row_;
   col = visitor.col_;
@@ -107,7 +107,7 @@ inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::minElt( i
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::minEltSafe( int& row, int& col) const
 {
-  typedef hidden::MinEltSafeVisitor<Type> Visitor;
+  typedef hidden::MinEltSafeVisitor<typename hidden::RemoveConst<Type>::Type> Visitor;
   Visitor visitor;
   visit(visitor);
   row = visitor.row_;
@@ -118,7 +118,7 @@ inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::minEltSaf
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::maxElt( int& row, int& col) const
 {
-  typedef hidden::MaxEltVisitor<Type> Visitor;
+  typedef hidden::MaxEltVisitor<typename hidden::RemoveConst<Type>::Type> Visitor;
   Visitor visitor;
   visit(visitor);
   row = visitor.row_;
@@ -129,7 +129,7 @@ inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::maxElt( i
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::maxEltSafe( int& row, int& col) const
 {
-  typedef hidden::MaxEltSafeVisitor<Type> Visitor;
+  typedef hidden::MaxEltSafeVisitor<typename hidden::RemoveConst<Type>::Type> Visitor;
   Visitor visitor;
   visit(visitor);
   row = visitor.row_;
@@ -140,7 +140,7 @@ inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::maxEltSaf
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::minElt( int& idx) const
 {
-  typedef hidden::MinEltVisitor<Type> Visitor;
+  typedef hidden::MinEltVisitor<typename hidden::RemoveConst<Type>::Type> Visitor;
   Visitor visitor;
   visit(visitor);
   idx = hidden::GetIdx<Visitor, hidden::Traits<Derived>::structure_ >::idx(visitor);
@@ -149,7 +149,7 @@ inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::minElt( i
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::minEltSafe( int& idx) const
 {
-  typedef hidden::MinEltSafeVisitor<Type> Visitor;
+  typedef hidden::MinEltSafeVisitor<typename hidden::RemoveConst<Type>::Type> Visitor;
   Visitor visitor;
   visit(visitor);
   idx = hidden::GetIdx<Visitor, hidden::Traits<Derived>::structure_ >::idx(visitor);
@@ -159,7 +159,7 @@ inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::minEltSaf
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::maxElt( int& idx) const
 {
-  typedef hidden::MaxEltVisitor<Type> Visitor;
+  typedef hidden::MaxEltVisitor<typename hidden::RemoveConst<Type>::Type> Visitor;
   Visitor visitor;
   visit(visitor);
   idx = hidden::GetIdx<Visitor, hidden::Traits<Derived>::structure_ >::idx(visitor);
@@ -168,7 +168,7 @@ inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::maxElt( i
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::maxEltSafe( int& idx) const
 {
-  typedef hidden::MaxEltSafeVisitor<Type> Visitor;
+  typedef hidden::MaxEltSafeVisitor<typename hidden::RemoveConst<Type>::Type> Visitor;
   Visitor visitor;
   visit(visitor);
   idx = hidden::GetIdx<Visitor, hidden::Traits<Derived>::structure_ >::idx(visitor);
@@ -178,14 +178,14 @@ inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::maxEltSaf
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::minElt() const
 {
-  typedef hidden::MinVisitor<Type> Visitor;
+  typedef hidden::MinVisitor<typename hidden::RemoveConst<Type>::Type> Visitor;
   Visitor visitor;
   return visit(visitor);
 }
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::minEltSafe() const
 {
-  typedef hidden::MinSafeVisitor<Type> Visitor;
+  typedef hidden::MinSafeVisitor<typename hidden::RemoveConst<Type>::Type> Visitor;
   Visitor visitor;
   return visit(visitor);
 }
@@ -193,14 +193,14 @@ inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::minEltSaf
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::maxElt() const
 {
-  typedef hidden::MaxVisitor<Type> Visitor;
+  typedef hidden::MaxVisitor<typename hidden::RemoveConst<Type>::Type> Visitor;
   Visitor visitor;
   return visit(visitor);
 }
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::maxEltSafe() const
 {
-  typedef hidden::MaxSafeVisitor<Type> Visitor;
+  typedef hidden::MaxSafeVisitor<typename hidden::RemoveConst<Type>::Type> Visitor;
   Visitor visitor;
   return visit(visitor);
 }
@@ -209,16 +209,23 @@ inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::maxEltSaf
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::sum() const
 {
-  hidden::SumVisitor<Type> visitor;
+  hidden::SumVisitor<typename hidden::RemoveConst<Type>::Type> visitor;
   return visit(visitor);
 }
 /* sum safely the values of all the array */
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::sumSafe() const
 {
-  hidden::SumVisitor<Type> visitor;
+  hidden::SumVisitor<typename hidden::RemoveConst<Type>::Type> visitor;
   return safe().visit(visitor);
 }
+/* sum the values of all the array using the compensated summation */
+template<typename Derived>
+inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::sumKahan() const
+{
+  hidden::SumKahanVisitor<typename hidden::RemoveConst<Type>::Type> visitor;
+  return visit(visitor);
+}
 /* @return the norm of this*/
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::norm() const
@@ -242,14 +249,14 @@ inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::normInf()
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::mean() const
 {
-  hidden::MeanVisitor<Type> visitor;
+  hidden::MeanVisitor<typename hidden::RemoveConst<Type>::Type> visitor;
   return visit(visitor);
 }
 /* sum safely the values of all the array */
 template<typename Derived>
 inline typename hidden::Traits<Derived>::Type const ExprBase<Derived>::meanSafe() const
 {
-  hidden::MeanSafeVisitor<Type> visitor;
+  hidden::MeanSafeVisitor<typename hidden::RemoveConst<Type>::Type> visitor;
   return visit(visitor);
 }
 
@@ -82,6 +82,19 @@ namespace STK
   *     Derived& pushBackCols(ITContainer1D<Other> const& other);
   * @endcode
   *
+  * By default each column is allocated separately. Using
+  * @c setBlockStorage(true) all the columns are stored in a single
+  * contiguous block of memory with leading dimension @c ldx(): the
+  * element (i,j) is then stored at the position
+  * @code
+  *   p_block()[(i-beginRows()) + (j-beginCols())*ldx()]
+  * @endcode
+  * and the array can be given to a fortran (lapack) routine without copy.
+  * The block have some spare capacity in rows and columns and is
+  * reallocated only when this capacity is exceeded. The ranges of the
+  * columns (@c rangeCols_) keep their meaning, so that triangular and
+  * diagonal arrays can also use this storage.
+  *
   * @tparam Derived is the name of the class implementing an @c IArray2D.
   * @sa Array2D, @sa Array2DDiagonal, @sa Array2DLowerTriangular,
   * @sa Array2DUpperTriangular, @sa Array2DPoint, @sa Array2DVector;
@@ -112,18 +125,27 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
 
  protected:
     /** Default constructor */
-    IArray2D() : Base() {}
+    IArray2D() : Base()
+               , blockStorage_(false), p_block_(0), ldx_(0), blockCols_(0)
+    {}
     /** Constructor with specified ranges
      *  @param I range of the Rows
      *  @param J range of the Cols
      **/
     IArray2D( Range const& I, Range const& J) : Base(I, J)
+                                              , blockStorage_(false), p_block_(0), ldx_(0), blockCols_(0)
     { initializeCols(J);}
-    /** Copy constructor
+    /** Copy constructor. If T use a block storage, the copy will use
+     *  a block storage too.
      *  @param T the array to copy
      *  @param ref true if we wrap T
      **/
-    IArray2D( const IArray2D& T, bool ref =false) : Base(T, ref)
+    IArray2D( const IArray2D& T, bool ref =false)
+            : Base(T, ref)
+            , blockStorage_(T.blockStorage_)
+            , p_block_(ref ? T.p_block_ : 0)
+            , ldx_(ref ? T.ldx_ : 0)
+            , blockCols_(ref ? T.blockCols_ : 0)
     {
       if (!ref)
       {
@@ -133,7 +155,9 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
         { copyColumnForward(T, j, j);}
       }
     }
-    /** constructor by reference, ref_=1.
+    /** constructor by reference, ref_=1. If T use a block storage, the
+     *  block of the sub-array starts at the element (I.begin(), J.begin())
+     *  of T and have the same leading dimension.
      *  @param T the array to copy
      *  @param I range of the Rows to wrap
      *  @param J range of the Col to wrap
@@ -141,20 +165,138 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
     template<class OtherArray>
     IArray2D( IArray2D<OtherArray> const& T, Range const& I, Range const& J)
             : Base(T, I, J)
+            , blockStorage_(T.isBlockStorage())
+            , p_block_( T.p_block() ? T.p_block() + (I.begin()-T.beginRows())
+                                                  + (J.begin()-T.beginCols())*T.ldx()
+                                    : 0)
+            , ldx_(T.ldx())
+            , blockCols_(T.p_block() ? T.blockCols()-(J.begin()-T.beginCols()) : 0)
     {}
     /** Wrapper constructor the Container is a ref.
      *  @param q pointer on data
      *  @param I range of the Rows to wrap
      *  @param J range of the Columns to wrap
      **/
-    IArray2D( Type** q, Range const& I, Range const& J) : Base(q, I, J) {}
+    IArray2D( Type** q, Range const& I, Range const& J)
+            : Base(q, I, J)
+            , blockStorage_(false), p_block_(0), ldx_(0), blockCols_(0)
+    {}
     /** destructor.
      *  free the vertically allocated memory (the columns). The horizontally
      *  allocated memory is handled by the Allocator class.
      **/
-    ~IArray2D() { if (!this->isRef()) this->freeCols(this->cols());}
+    ~IArray2D()
+    {
+      if (!this->isRef())
+      {
+        this->freeCols(this->cols());
+        freeBlock();
+      }
+    }
 
   public:
+    /** @return @c true if the columns are stored in a single block of memory */
+    inline bool isBlockStorage() const { return blockStorage_;}
+    /** @return a pointer on the block of memory storing the columns of the
+     *  array (0 if the array does not use a block storage).
+     **/
+    inline Type* p_block() const { return p_block_;}
+    /** @return the leading dimension of the block storage, i.e. the number
+     *  of elements between two consecutive columns in memory.
+     **/
+    inline int ldx() const { return ldx_;}
+    /** @return the number of columns available in the block storage */
+    inline int blockCols() const { return blockCols_;}
+    /** Set or unset the block storage of the array. If the array is not
+     *  empty, the data are moved in the new storage.
+     *  @param block @c true if the columns have to be stored in a single
+     *  block of memory, @c false if each column is allocated separately
+     **/
+    Derived& setBlockStorage(bool block = true)
+    {
+      if (block == blockStorage_) return this->asDerived();
+      if (this->isRef())
+      { STKRUNTIME_ERROR_1ARG(IArray2D::setBlockStorage,block,cannot operate on reference);}
+      if (block)
+      {
+        // copy the columns in a block and free them
+        if (this->sizeCols() > 0 && this->sizeRows() > 0)
+        { reallocBlock( Arrays::evalSizeCapacity(this->sizeRows())
+                      , std::max(this->availableCols(), this->sizeCols()));
+        }
+        blockStorage_ = true;
+        return this->asDerived();
+      }
+      // allocate each column separately and copy the data of the block
+      blockStorage_ = false;
+      for (int j=this->beginCols(); j<this->endCols(); j++)
+      {
+        Type* p_oldCol(this->data(j));
+        if (!p_oldCol) continue;
+        Range range(this->rangeCols_[j]);
+        initializeCol(j, range);
+        Type* p_newCol(this->data(j));
+        for (int i=range.begin(); i<range.end(); i++) p_newCol[i] = p_oldCol[i];
+      }
+      freeBlock();
+      return this->asDerived();
+    }
+    /** exchange this array with T.
+     *  @param T the array to exchange with this
+     **/
+    void exchange(IArray2D& T)
+    {
+      Base::exchange(T);
+      std::swap(blockStorage_, T.blockStorage_);
+      std::swap(p_block_, T.p_block_);
+      std::swap(ldx_, T.ldx_);
+      std::swap(blockCols_, T.blockCols_);
+    }
+    /** Swapping two columns.
+     *  @param pos1, pos2 positions of the columns to swap
+     **/
+    void swapCols(int pos1, int pos2)
+    {
+      if (!blockStorage_) { Base::swapCols(pos1, pos2); return;}
+      if (this->beginCols() > pos1)
+      { STKOUT_OF_RANGE_2ARG(IArray2D::swapCols,pos1, pos2,beginCols() >pos1);}
+      if (this->endCols() <= pos1)
+      { STKOUT_OF_RANGE_2ARG(IArray2D::swapCols,pos1, pos2,endCols() <= pos1);}
+      if (this->beginCols() > pos2)
+      { STKOUT_OF_RANGE_2ARG(IArray2D::swapCols,pos1, pos2,beginCols() >pos2);}
+      if (this->endCols() <= pos2)
+      { STKOUT_OF_RANGE_2ARG(IArray2D::swapCols,pos1, pos2,endCols() <=pos2);}
+      if (pos1 == pos2) return;
+      // the columns have to stay at their place in the block: swap the values
+      Type *p1 = blockCol(pos1), *p2 = blockCol(pos2);
+      for (int i=this->beginRows(); i<this->endRows(); i++) std::swap(p1[i], p2[i]);
+      std::swap(this->availableRows_[pos1], this->availableRows_[pos2]);
+      std::swap(this->rangeCols_[pos1], this->rangeCols_[pos2]);
+      this->data(pos1) = (this->availableRows_[pos1] > 0) ? p1 : 0;
+      this->data(pos2) = (this->availableRows_[pos2] > 0) ? p2 : 0;
+    }
+    /** Append the container @c other to @c this without copying the data.
+     *  @note Block storage arrays cannot be merged.
+     *  @param other the container to merge with this
+     **/
+    template<class Other>
+    void merge(IArray2D<Other> const& other)
+    {
+      if (blockStorage_ || other.isBlockStorage())
+      { STKRUNTIME_ERROR_NO_ARG(IArray2D::merge(other),cannot merge arrays using a block storage.);}
+      Base::merge(other);
+    }
+    /** Append the vector @c other to @c this without copying the data.
+     *  @note Block storage arrays cannot be merged.
+     *  @param other the vector to merge with this
+     **/
+    template<class Other>
+    void merge(IArray1D<Other> const& other)
+    {
+      if (blockStorage_)
+      { STKRUNTIME_ERROR_NO_ARG(IArray2D::merge(IArray1D),cannot merge arrays using a block storage.);}
+      Base::merge(other);
+    }
     /** set a value to the whole array */
     Derived& setValue(Type const& v)
     {
@@ -172,9 +314,14 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
      Derived& move(Derived const& T)
      {
        if (this->asPtrDerived() == &T) return this->asDerived();
-       if (!this->isRef()) { freeCols(this->cols());}
+       if (!this->isRef()) { freeCols(this->cols()); freeBlock();}
        // move Base part
        Base::move(T);
+       // move block storage part
+       blockStorage_ = T.blockStorage_;
+       p_block_ = T.p_block_;
+       ldx_ = T.ldx_;
+       blockCols_ = T.blockCols_;
        return this->asDerived();
      }
     /** clear the object.
@@ -439,6 +586,9 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
       // is this structure just a pointer?
       if (this->isRef())
       { STKRUNTIME_ERROR_1ARG(IArray2D::pushFrontCols,n,cannot operate on reference);}
+      // columns stored in a block are shifted inside the block
+      if (blockStorage_ && this->sizeCols() > 0)
+      { insertBlockCols(this->beginCols(), n); return;}
       // compute horizontal range of the array after insertion
       Range range_ho(this->cols());
       range_ho.incLast(n);
@@ -496,6 +646,8 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
       { STKOUT_OF_RANGE_2ARG(IArray2D::insertCols,pos,n,beginCols() > pos);}
       if (this->endCols() < pos)
       { STKOUT_OF_RANGE_2ARG(IArray2D::insertCols,pos,n,endCols() < pos);}
+      // columns stored in a block are shifted inside the block
+      if (blockStorage_) { insertBlockCols(pos, n); return;}
       // compute horizontal range of the array after insertion
       Range range_ho(this->cols());
       range_ho.incLast(n);
@@ -581,6 +733,8 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
       { STKOUT_OF_RANGE_2ARG(IArray2D::eraseCols,pos,n,lastIdxCols() < pos);}
       if (this->lastIdxCols() < pos+n-1)
       { STKOUT_OF_RANGE_2ARG(IArray2D::eraseCols,pos,n,lastIdxCols() < pos+n-1);}
+      // columns stored in a block are shifted inside the block
+      if (blockStorage_) { eraseBlockCols(pos, n); return;}
       // delete each col
       this->freeCols(Range(pos, n));
       // update cols_
@@ -816,6 +970,7 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
     void reserve(int sizeRows, int sizeCols)
     {
       this->reserveCols(sizeCols);
+      if (blockStorage_) { reserveBlock(sizeRows, sizeCols); return;}
       reserveRows(sizeRows);
     }
     /** @brief function for reserving memory in all the columns
@@ -855,6 +1010,7 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
       if (this->isRef()) return;
       // free the Rows memory
       this->freeCols(this->cols());
+      freeBlock();
       // liberate horizontally
       this->freeRows();
     }
@@ -886,6 +1042,9 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
      **/
     void initializeCols(Range const& J)
     {
+      // in a block, the columns to initialize have no data
+      if (blockStorage_)
+      { for (int j=J.begin(); j<J.end(); j++) { this->data(j) = 0;}}
       for (int j=J.begin(); j<J.end(); j++)
       {
         try
@@ -924,6 +1083,15 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
         // return
         return;
       }
+      // the column is a part of the block
+      if (blockStorage_)
+      {
+        reserveBlock(I.end()-this->beginRows(), pos-this->beginCols()+1);
+        this->data(pos) = blockCol(pos);
+        this->availableRows_[pos] = ldx_;
+        this->rangeCols_[pos] = I;
+        return;
+      }
       // compute the size necessary (cannot be 0)
       int size = Arrays::evalSizeCapacity(I.size());
       // try to allocate memory
@@ -965,8 +1133,8 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
       {
         // increment the ptr
         this->data(col) += this->rangeCols_[col].begin();
-        // delete allocated mem for the column col
-        delete [] this->data(col);
+        // delete allocated mem for the column col (the block is deleted apart)
+        if (!blockStorage_) delete [] this->data(col);
         // set default value for ptr
         this->data(col) =0;
         // set default value for this->availableRows_[col]
@@ -1000,6 +1168,8 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
     {
       // nothing to do
       if (this->availableRows_[col] > size) return;
+      // reserve rows for all the columns of the block
+      if (blockStorage_) { reserveBlock(size, this->sizeCols()); return;}
       // wrap old Col
       Type* p_oldCol(this->data(col));
       // create new Col
@@ -1039,6 +1209,21 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
     {
       // check if there is something to do
       if (this->rangeCol(col) == I) return;
+      // in a block, copy the values at their new place
+      if (blockStorage_)
+      {
+        if (I.size() <= 0) { freeCol(col); return;}
+        if (!this->data(col)) { initializeCol(col, I); return;}
+        reserveBlock(I.end()-this->beginRows(), this->sizeCols());
+        Type* p_col(this->data(col));
+        Range const oldRange(this->rangeCols_[col]);
+        const int inc = I.begin() - oldRange.begin();
+        const int last = oldRange.begin() + std::min(oldRange.size(), I.size());
+        if (inc < 0) { for (int i=oldRange.begin(); i<last; i++) p_col[i+inc] = p_col[i];}
+        if (inc > 0) { for (int i=last-1; i>=oldRange.begin(); i--) p_col[i+inc] = p_col[i];}
+        this->rangeCols_[col] = I;
+        return;
+      }
       // shift to the desired first index
       shiftCol(col, I.begin());
       // compute difference of size
@@ -1059,6 +1244,9 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
      **/
     void insertRowsToCol( int col, int pos, int n =1)
     {
+      // in a block, be sure there is enough rows available
+      if (blockStorage_ && this->data(col))
+      { reserveBlock(this->rangeCols_[col].end()+n-this->beginRows(), this->sizeCols());}
       // wrap old Column
       Type* p_oldCol(this->data(col));
       // get vertical range of the Column
@@ -1100,6 +1288,9 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
      **/
     void pushBackRowsToCol( int col, int n =1)
     {
+      // in a block, be sure there is enough rows available
+      if (blockStorage_ && this->data(col))
+      { reserveBlock(this->rangeCols_[col].end()+n-this->beginRows(), this->sizeCols());}
       // wrap old Col
       Type* p_oldCol(this->data(col));
       // get vertical range of the Col
@@ -1140,7 +1331,7 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
       // check trivial cases
       if (this->rangeCols_[col].lastIdx() < pos) return;
       if (this->rangeCols_[col].begin()> pos+n-1)
-      { shiftCol( col, this->rangeCols_[col].begin() - n); return;}
+      { translateCol( col, this->rangeCols_[col].begin() - n); return;}
       // find the exisiting rows to delete
       Range rangeDel(pos, n);
       rangeDel.inf(this->rangeCols_[col]);
@@ -1153,7 +1344,7 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
       this->rangeCols_[col].decLast(rangeDel.size());
       // and shift if necessary
       if (pos < rangeDel.begin())
-      { shiftCol( col, this->rangeCols_[col].begin() - (n-rangeDel.size()));}
+      { translateCol( col, this->rangeCols_[col].begin() - (n-rangeDel.size()));}
     }
     /** @brief Internal method for deleting last rows to a specified column.
      *
@@ -1171,6 +1362,169 @@ class IArray2D : public IArray2DBase< typename hidden::Traits<Derived>::Type*, D
       // free mem if necessary
       if (this->rangeCols_[col].size()==0) freeCol(col);
     }
+    /** @brief Internal method for translating the values of a column.
+     *
+     *  If the columns are allocated separately, this method is @c shiftCol.
+     *  If the columns are stored in a block, the values of the column are
+     *  copied at their new place in the block.
+     *  @param col the index of the column to translate
+     *  @param beg new begin of the column
+     **/
+    void translateCol( int col, int beg)
+    {
+      if (!blockStorage_) { shiftCol(col, beg); return;}
+      Type* p_col(this->data(col));
+      Range const& range(this->rangeCols_[col]);
+      const int inc = beg - range.begin();
+      if (p_col)
+      {
+        if (inc < 0) { for (int i=range.begin(); i<range.end(); i++) p_col[i+inc] = p_col[i];}
+        if (inc > 0) { for (int i=range.lastIdx(); i>=range.begin(); i--) p_col[i+inc] = p_col[i];}
+      }
+      this->rangeCols_[col].shift(beg);
+    }
+    /** @return the address of the column @c col in the block. The returned
+     *  pointer is shifted so that it can be indexed using the rows indexes.
+     *  @param col index of the column
+     **/
+    inline Type* blockCol( int col) const
+    { return p_block_ ? p_block_ + (col-this->beginCols())*ldx_ - this->beginRows() : 0;}
+    /** @brief Internal method for reserving memory in the block.
+     *  The block is reallocated only if its capacity is exceeded.
+     *  @param sizeRows,sizeCols the number of rows and columns needed
+     **/
+    void reserveBlock( int sizeRows, int sizeCols)
+    {
+      if ((ldx_ >= sizeRows)&&(blockCols_ >= sizeCols)) return;
+      reallocBlock( (ldx_ >= sizeRows) ? ldx_ : Arrays::evalSizeCapacity(sizeRows)
+                  , (blockCols_ >= sizeCols) ? blockCols_ : std::max(sizeCols, this->availableCols()));
+    }
+    /** @brief Internal method for (re)allocating the block.
+     *  The existing columns are copied at their place in the new block and
+     *  the memory previously used (block or columns) is liberated.
+     *  @param ldx leading dimension of the new block
+     *  @param nbCols number of columns of the new block
+     **/
+    void reallocBlock( int ldx, int nbCols)
+    {
+      Type* p_newBlock = 0;
+      if (ldx*nbCols > 0)
+      {
+        try
+        { p_newBlock = new Type[ldx*nbCols];}
+        catch (std::bad_alloc & error)  // if an alloc error occur
+        { STKRUNTIME_ERROR_2ARG(IArray2D::reallocBlock,ldx,nbCols,memory allocation failed.);}
+      }
+      for (int j=this->beginCols(); j<this->endCols(); j++)
+      {
+        Type* p_oldCol(this->data(j));
+        if (!p_oldCol) continue;
+        Type* p_newCol = p_newBlock + (j-this->beginCols())*ldx - this->beginRows();
+        for (int i=this->rangeCols_[j].begin(); i<this->rangeCols_[j].end(); i++)
+        { p_newCol[i] = p_oldCol[i];}
+        // free the column if it was allocated separately
+        if (!blockStorage_)
+        {
+          p_oldCol += this->rangeCols_[j].begin();
+          delete [] p_oldCol;
+        }
+        this->data(j) = p_newCol;
+        this->availableRows_[j] = ldx;
+      }
+      if (p_block_) delete [] p_block_;
+      p_block_   = p_newBlock;
+      ldx_       = ldx;
+      blockCols_ = nbCols;
+    }
+    /** @brief Internal method for liberating the block. The pointers on the
+     *  columns have to be liberated before.
+     **/
+    void freeBlock()
+    {
+      if (p_block_) delete [] p_block_;
+      p_block_   = 0;
+      ldx_       = 0;
+      blockCols_ = 0;
+    }
+    /** @brief Internal method for moving the column @c src of the block at
+     *  the place of the column @c dst. The column @c src is set to default.
+     *  @param src,dst index of the source and destination columns
+     **/
+    void moveBlockCol( int src, int dst)
+    {
+      Type* p_src(this->data(src));
+      Type* p_dst(p_src ? blockCol(dst) : 0);
+      if (p_src)
+      {
+        for (int i=this->rangeCols_[src].begin(); i<this->rangeCols_[src].end(); i++)
+        { p_dst[i] = p_src[i];}
+      }
+      this->data(dst) = p_dst;
+      this->availableRows_[dst] = this->availableRows_[src];
+      this->rangeCols_[dst] = this->rangeCols_[src];
+      this->data(src) = 0;
+      this->availableRows_[src] = 0;
+      this->rangeCols_[src] = Range();
+    }
+    /** @brief Internal method for inserting columns when the array use a
+     *  block storage. The last columns are translated in the block, which is
+     *  reallocated only if there is not enough place.
+     *  @param pos the position of the inserted Columns
+     *  @param n the number of column to insert
+     **/
+    void insertBlockCols( int pos, int n)
+    {
+      // compute horizontal range of the array after insertion
+      Range range_ho(this->cols());
+      range_ho.incLast(n);
+      // allocate, if necessary, the mem for the ptr of the Cols
+      if (this->availableCols() < range_ho.size())
+      { this->reallocCols(range_ho);}
+      else
+      {
+        Range addRange(this->endCols(), n);
+        this->availableRows_.insert(addRange, 0);
+        this->rangeCols_.insert(addRange, Range());
+      }
+      // enlarge the block if necessary and update range_
+      reserveBlock(ldx_, range_ho.size());
+      this->incLastIdxCols(n);
+      for (int j=this->endCols()-n; j<this->endCols(); j++)
+      {
+        this->data(j) = 0;
+        this->availableRows_[j] = 0;
+        this->rangeCols_[j] = Range();
+      }
+      // translate data
+      for (int k=this->lastIdxCols()-n; k>=pos; k--) { moveBlockCol(k, k+n);}
+      // initialize the rows for the new columns
+      this->initializeCols(Range(pos, n));
+    }
+    /** @brief Internal method for deleting columns when the array use a
+     *  block storage. The last columns are translated in the block.
+     *  @param pos the position of the deleted Columns
+     *  @param n the number of column to delete
+     **/
+    void eraseBlockCols( int pos, int n)
+    {
+      this->freeCols(Range(pos, n));
+      for (int k=pos+n; k<this->endCols(); k++) { moveBlockCol(k, k-n);}
+      // update this->availableRows_, this->rangeCols_ and cols_
+      this->availableRows_.popBack(n);
+      this->rangeCols_.popBack(n);
+      this->decLastIdxCols(n);
+      // if there is no more Cols
+      if (this->sizeCols() == 0) this->freeMem();
+    }
+
+    /** @c true if the columns are stored in a single block of memory */
+    bool blockStorage_;
+    /** pointer on the block of memory (0 if there is no block) */
+    Type* p_block_;
+    /** leading dimension of the block */
+    int ldx_;
+    /** number of columns available in the block */
+    int blockCols_;
 };
 
 } // namespace STK
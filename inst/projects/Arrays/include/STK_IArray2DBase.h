@@ -120,7 +120,7 @@ class IArray2DBase :  protected IContainer2D<SizeRows_, SizeCols_>, public Array
     IArray2DBase(): Base2D(), Base(), allocator_()
                   , availableRows_(), rangeCols_()
                   , availableCols_(0), capacityByCols_(0)
-    { mallocHo(this->cols());}
+    { allocator_.setArena(0); mallocHo(this->cols());}
     /** constructor with specified ranges
      *  @param I range of the Rows
      *  @param J range of the columns
@@ -129,7 +129,7 @@ class IArray2DBase :  protected IContainer2D<SizeRows_, SizeCols_>, public Array
                 : Base2D(I, J), Base(), allocator_()
                 , availableRows_(), rangeCols_()
                 , availableCols_(0), capacityByCols_(0)
-    { mallocHo(this->cols());}
+    { allocator_.setArena(0); mallocHo(this->cols());}
     /** Copy constructor If we want to wrap T, the main ptr will be wrapped
      *  in AllocatorBase class. If we want to copy  T, Allocator is
      *  initialized to default values.
@@ -147,7 +147,7 @@ class IArray2DBase :  protected IContainer2D<SizeRows_, SizeCols_>, public Array
                 , availableRows_(T.availableRows_, ref)
                 , rangeCols_(T.rangeCols_) // we have to copy it again, in case T is a temporary
                 , availableCols_(T.availableCols_), capacityByCols_(T.capacityByCols_)
-    { if (!ref) mallocHo(this->cols());}
+    { if (!ref) { allocator_.setArena(0); mallocHo(this->cols());}}
     /** constructor by reference, ref_=1.
      *  @param T the container to copy
      *  @param I,J ranges of the rows and columns to wrap
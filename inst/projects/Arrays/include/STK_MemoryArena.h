@@ -0,0 +1,247 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Arrays
+ * Purpose:  Define the MemoryArena and ArenaScope classes.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_MemoryArena.h
+ *  @brief In this file we define the MemoryArena class, a bump allocator
+ *  for the temporary containers, and the ArenaScope class activating an arena
+ *  in a scope.
+ **/
+
+#ifndef STK_MEMORYARENA_H
+#define STK_MEMORYARENA_H
+
+#include <new>
+#include <vector>
+#include <cstddef>
+
+#include <Sdk/include/STK_Macros.h>
+
+namespace STK
+{
+
+/** @ingroup Arrays
+ *  @brief A MemoryArena is a bump allocator for short-lived containers.
+ *
+ *  The memory is reserved by large chunks and distributed sequentially.
+ *  Deallocating a block does nothing except if it is the last allocated
+ *  block (the memory is then reused immediately), so that blocks freed in the
+ *  reverse order of their allocation are recycled. All the memory
+ *  is given back at once using @c release() or when the arena is destroyed.
+ *
+ *  An arena is used by the containers when it is the current arena of the
+ *  thread, see the ArenaScope class:
+ *  @code
+ *    MemoryArena arena;
+ *    for (int i=0; i<n; ++i)
+ *    {
+ *      ArenaScope scope(arena); // all containers created in this scope use arena
+ *      CPointX x(K);
+ *      ...
+ *    } // memory of arena is released here
+ *    stk_cout << arena.peakBytes() << _T("\n");
+ *  @endcode
+ *  @warning Only the containers created while the arena is active allocate
+ *  their memory in the arena. They have to be destroyed before the memory of
+ *  the arena is released.
+ **/
+class MemoryArena
+{
+  public:
+    /** default size of the chunks (1Mo) */
+    enum { defaultChunkSize_ = 1<<20 };
+    /** constructor.
+     *  @param chunkSize the minimal size (in bytes) of the chunks
+     **/
+    MemoryArena( size_t chunkSize = defaultChunkSize_)
+               : chunkSize_(chunkSize), chunks_(), sizes_(), current_(0), offset_(0)
+               , nbBytes_(0), nbAllocations_(0), peakBytes_(0)
+    {}
+    /** destructor. The memory is liberated. */
+    ~MemoryArena()
+    { for (size_t k=0; k<chunks_.size(); ++k) ::operator delete(chunks_[k]);}
+    /** @return the number of bytes used actually */
+    inline size_t nbBytes() const { return nbBytes_;}
+    /** @return the number of allocations done since the creation of the arena */
+    inline size_t nbAllocations() const { return nbAllocations_;}
+    /** @return the maximal number of bytes used since the creation of the arena */
+    inline size_t peakBytes() const { return peakBytes_;}
+    /** @return the number of bytes reserved in the chunks */
+    size_t capacity() const
+    {
+      size_t size = 0;
+      for (size_t k=0; k<sizes_.size(); ++k) size += sizes_[k];
+      return size;
+    }
+    /** allocate a block of memory.
+     *  @param bytes the size of the block in bytes
+     *  @return a pointer on the block, aligned for any arithmetic type
+     **/
+    void* allocate(size_t bytes)
+    {
+      bytes = align(bytes);
+      // find a chunk with enough place
+      while (current_ < chunks_.size() && offset_ + bytes > sizes_[current_])
+      { ++current_; offset_ = 0;}
+      if (current_ == chunks_.size())
+      {
+        size_t size = (bytes > chunkSize_) ? bytes : chunkSize_;
+        chunks_.push_back(static_cast<char*>(::operator new(size)));
+        sizes_.push_back(size);
+        offset_ = 0;
+      }
+      char* p = chunks_[current_] + offset_;
+      offset_ += bytes;
+      nbBytes_+= bytes;
+      ++nbAllocations_;
+      if (nbBytes_ > peakBytes_) peakBytes_ = nbBytes_;
+      return p;
+    }
+    /** deallocate a block of memory. If the block is the last one allocated,
+     *  its memory is reused, otherwise nothing is done.
+     *  @param p,bytes the block and its size in bytes
+     **/
+    void deallocate(void* p, size_t bytes)
+    {
+      if (current_ == chunks_.size()) return;
+      bytes = align(bytes);
+      char* q = static_cast<char*>(p);
+      if (q + bytes == chunks_[current_] + offset_)
+      {
+        offset_  = q - chunks_[current_];
+        nbBytes_ = (nbBytes_ > bytes) ? nbBytes_ - bytes : 0;
+      }
+    }
+    /** release all the blocks allocated. The chunks are kept for the next
+     *  allocations.
+     **/
+    void release()
+    { current_ = 0; offset_ = 0; nbBytes_ = 0;}
+    /** @return the arena used by the current thread (0 if none) */
+    static MemoryArena*& current()
+    {
+      static MemoryArena* p_current = 0;
+#ifdef _OPENMP
+#pragma omp threadprivate(p_current)
+#endif
+      return p_current;
+    }
+
+  private:
+    /** minimal size of the chunks */
+    size_t chunkSize_;
+    /** the chunks of memory */
+    std::vector<char*> chunks_;
+    /** the size of the chunks */
+    std::vector<size_t> sizes_;
+    /** index of the chunk in use */
+    size_t current_;
+    /** first free position in the chunk in use */
+    size_t offset_;
+    /** number of bytes used */
+    size_t nbBytes_;
+    /** number of allocations */
+    size_t nbAllocations_;
+    /** maximal number of bytes used */
+    size_t peakBytes_;
+    /** @return the size in bytes rounded to a multiple of the alignment */
+    static size_t align(size_t bytes)
+    {
+      const size_t alignment = 2*sizeof(double);
+      return ((bytes + alignment - 1)/alignment)*alignment;
+    }
+    /** copy is not allowed */
+    MemoryArena(MemoryArena const&);
+    MemoryArena& operator=(MemoryArena const&);
+};
+
+/** @ingroup Arrays
+ *  @brief An ArenaScope set a MemoryArena as the current arena of the thread
+ *  during its life time. The previous arena is restored at the end of the
+ *  scope and the memory of the arena is released if it was not active before.
+ **/
+class ArenaScope
+{
+  public:
+    /** constructor
+     *  @param arena the arena to use in this scope
+     **/
+    ArenaScope( MemoryArena& arena) : p_previous_(MemoryArena::current()), arena_(arena)
+    { MemoryArena::current() = &arena_;}
+    /** destructor. Restore the previous arena. */
+    ~ArenaScope()
+    {
+      MemoryArena::current() = p_previous_;
+      if (p_previous_ != &arena_) arena_.release();
+    }
+  private:
+    /** arena active before this scope */
+    MemoryArena* p_previous_;
+    /** arena used in this scope */
+    MemoryArena& arena_;
+    /** copy is not allowed */
+    ArenaScope(ArenaScope const&);
+    ArenaScope& operator=(ArenaScope const&);
+};
+
+namespace Arrays
+{
+/** allocate and construct an array of @c n elements, in the arena @c p_arena
+ *  or in the heap if @c p_arena is 0.
+ *  @param n number of elements
+ *  @param p_arena arena to use
+ **/
+template<typename Type>
+Type* allocate(int n, MemoryArena* p_arena)
+{
+  if (!p_arena) return new Type[n];
+  Type* p = static_cast<Type*>(p_arena->allocate(n*sizeof(Type)));
+  for (int i=0; i<n; ++i) new (p+i) Type;
+  return p;
+}
+/** destroy and deallocate an array of @c n elements allocated using
+ *  @c allocate.
+ *  @param p the array to deallocate
+ *  @param n number of elements
+ *  @param p_arena arena used for the allocation
+ **/
+template<typename Type>
+void deallocate(Type* p, int n, MemoryArena* p_arena)
+{
+  if (!p_arena) { delete [] p; return;}
+  for (int i=0; i<n; ++i) p[i].~Type();
+  p_arena->deallocate(p, n*sizeof(Type));
+}
+
+} // namespace Arrays
+
+} // namespace STK
+
+#endif /* STK_MEMORYARENA_H */
@@ -35,19 +35,217 @@
 #ifndef STK_SPARSEMATRIX_H
 #define STK_SPARSEMATRIX_H
 
-/** @brief
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <Sdk/include/STK_Macros.h>
+#include <STKernel/include/STK_Real.h>
+#include <STKernel/include/STK_Constants.h>
+#include "STK_Arrays_Util.h"
+
+namespace STK
+{
+
+namespace hidden
+{
+/** @ingroup hidden
+ *  Helper resizing the result of a sparse product to the number of rows of the
+ *  matrix and the columns of the right hand side.
+ **/
+template<class Result, int Structure_ = Result::structure_>
+struct SparseProductResize
+{
+  static void resize(Result& y, Range const& I, Range const& J)
+  { y.resize(I, J);}
+};
+/** specialization for vectors */
+template<class Result>
+struct SparseProductResize<Result, Arrays::vector_>
+{
+  static void resize(Result& y, Range const& I, Range const&)
+  { y.resize(I);}
+};
+
+} // namespace hidden
+
+/** @ingroup Arrays
+ *  @brief A SparseMatrix is a real matrix stored in compressed sparse row
+ *  (CSR) format.
  *
- */
+ *  The non-zero values of the row @c i are stored in @c values()[k] with
+ *  @c k in [rowPtr()[i], rowPtr()[i+1]) and column indexes @c colIdx()[k],
+ *  sorted in increasing order. Indexes are relative to the first row and the
+ *  first column of the matrix, so that the matrix can multiply any array
+ *  whatever its first index.
+ *
+ *  The products computed by @c mult are parallelized on the rows when the
+ *  number of non-zero values is large enough. The class can be used by the
+ *  SparseMultFunctor of the CG classes.
+ **/
 class SparseMatrix
 {
   public:
-    SparseMatrix()
+    /** default constructor: an empty matrix */
+    SparseMatrix(): sizeRows_(0), sizeCols_(0), rowPtr_(1, 0), colIdx_(), values_()
+    {}
+    /** build a sparse matrix from a dense array
+     *  @param a the array to compress
+     *  @param tol the values with an absolute value less or equal to @c tol are
+     *  discarded (except the diagonal)
+     **/
+    template<class Array>
+    explicit SparseMatrix( Array const& a, Real tol = 0.)
+                         : sizeRows_(0), sizeCols_(0), rowPtr_(1, 0), colIdx_(), values_()
+    { setFromDense(a, tol);}
+    /** destructor */
+    ~SparseMatrix() {}
+
+    /** @return the number of rows */
+    inline int sizeRows() const { return sizeRows_;}
+    /** @return the number of columns */
+    inline int sizeCols() const { return sizeCols_;}
+    /** @return the number of stored values */
+    inline int nnz() const { return rowPtr_[sizeRows_];}
+    /** @return the offsets of the rows in the arrays of values */
+    inline std::vector<int> const& rowPtr() const { return rowPtr_;}
+    /** @return the column indexes of the values */
+    inline std::vector<int> const& colIdx() const { return colIdx_;}
+    /** @return the stored values */
+    inline std::vector<Real> const& values() const { return values_;}
+
+    /** @return the value (i,j) of the matrix (0 if not stored)
+     *  @param i,j indexes of the row and column (starting at 0)
+     **/
+    Real elt(int i, int j) const
+    {
+      std::vector<int>::const_iterator first = colIdx_.begin() + rowPtr_[i]
+                                     , last  = colIdx_.begin() + rowPtr_[i+1];
+      std::vector<int>::const_iterator it = std::lower_bound(first, last, j);
+      return (it != last && *it == j) ? values_[it - colIdx_.begin()] : 0.;
+    }
+
+    /** compress a dense array.
+     *  @param a the array to compress
+     *  @param tol the values with an absolute value less or equal to @c tol are
+     *  discarded (except the diagonal)
+     **/
+    template<class Array>
+    void setFromDense( Array const& a, Real tol = 0.)
+    {
+      sizeRows_ = a.sizeRows(); sizeCols_ = a.sizeCols();
+      rowPtr_.assign(sizeRows_+1, 0);
+      colIdx_.clear(); values_.clear();
+      for (int i = 0; i < sizeRows_; ++i)
+      {
+        for (int j = 0; j < sizeCols_; ++j)
+        {
+          Real v = a.elt(a.beginRows()+i, a.beginCols()+j);
+          if (i == j || std::abs(v) > tol)
+          { colIdx_.push_back(j); values_.push_back(v);}
+        }
+        rowPtr_[i+1] = int(colIdx_.size());
+      }
+    }
+    /** build the matrix from a list of triplets (i, j, value). Duplicated
+     *  entries are summed.
+     *  @param sizeRows, sizeCols dimensions of the matrix
+     *  @param rows, cols indexes of the values (starting at 0)
+     *  @param values the values
+     **/
+    void setFromTriplets( int sizeRows, int sizeCols
+                        , std::vector<int> const& rows, std::vector<int> const& cols
+                        , std::vector<Real> const& values)
     {
+      if (rows.size() != cols.size() || rows.size() != values.size())
+      { STKRUNTIME_ERROR_NO_ARG(SparseMatrix::setFromTriplets,sizes mismatch);}
+      sizeRows_ = sizeRows; sizeCols_ = sizeCols;
+      // count the entries of each row
+      std::vector<int> ptr(sizeRows_+1, 0);
+      for (size_t k = 0; k < rows.size(); ++k)
+      {
+        if (rows[k] < 0 || rows[k] >= sizeRows_ || cols[k] < 0 || cols[k] >= sizeCols_)
+        { STKRUNTIME_ERROR_2ARG(SparseMatrix::setFromTriplets,rows[k],cols[k],index out of range);}
+        ++ptr[rows[k]+1];
+      }
+      for (int i = 0; i < sizeRows_; ++i) ptr[i+1] += ptr[i];
+      // bucket the entries by row
+      std::vector<int> pos(ptr.begin(), ptr.end()-1), idx(rows.size());
+      std::vector<Real> val(rows.size());
+      for (size_t k = 0; k < rows.size(); ++k)
+      { idx[pos[rows[k]]] = cols[k]; val[pos[rows[k]]] = values[k]; ++pos[rows[k]];}
+      // sort each row and sum the duplicates
+      rowPtr_.assign(sizeRows_+1, 0);
+      colIdx_.clear(); values_.clear();
+      colIdx_.reserve(rows.size()); values_.reserve(rows.size());
+      std::vector<std::pair<int, Real> > row;
+      for (int i = 0; i < sizeRows_; ++i)
+      {
+        row.clear();
+        for (int k = ptr[i]; k < ptr[i+1]; ++k) row.push_back(std::make_pair(idx[k], val[k]));
+        std::sort(row.begin(), row.end());
+        for (size_t k = 0; k < row.size(); ++k)
+        {
+          if (k > 0 && row[k].first == colIdx_.back()) { values_.back() += row[k].second;}
+          else { colIdx_.push_back(row[k].first); values_.push_back(row[k].second);}
+        }
+        rowPtr_[i+1] = int(colIdx_.size());
+      }
     }
-    ~SparseMatrix()
+
+    /** get the diagonal of the matrix.
+     *  @param d the vector with the diagonal values
+     **/
+    template<class Vector>
+    void diagonal( Vector& d) const
     {
+      const int n = std::min(sizeRows_, sizeCols_);
+      d.resize(n);
+      for (int i = 0; i < n; ++i) d[d.begin()+i] = elt(i, i);
     }
+
+    /** compute the product @b y = @b Ax. If @b x has several columns, all the
+     *  columns are multiplied in the same pass over the matrix.
+     *  @param x the array to multiply
+     *  @param y the result, resized with the rows of @b x (starting at the
+     *  first index of @b x) and the columns of @b x
+     **/
+    template<class Rhs, class Result>
+    void mult( Rhs const& x, Result& y) const
+    {
+      if (x.sizeRows() != sizeCols_)
+      { STKRUNTIME_ERROR_2ARG(SparseMatrix::mult,x.sizeRows(),sizeCols_,sizes mismatch);}
+      const int bx = x.beginRows(), nbCol = x.sizeCols(), bc = x.beginCols();
+      hidden::SparseProductResize<Result>::resize(y, Range(bx, sizeRows_), x.cols());
+      const int by = y.beginRows(), byc = y.beginCols();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (double(nnz())*nbCol > ParallelThreshold)
+#endif
+      for (int i = 0; i < sizeRows_; ++i)
+      {
+        for (int c = 0; c < nbCol; ++c)
+        {
+          Real sum = 0.;
+          for (int k = rowPtr_[i]; k < rowPtr_[i+1]; ++k)
+          { sum += values_[k] * x.elt(bx + colIdx_[k], bc + c);}
+          y.elt(by + i, byc + c) = sum;
+        }
+      }
+    }
+
   private:
+    /** number of rows */
+    int sizeRows_;
+    /** number of columns */
+    int sizeCols_;
+    /** offsets of the rows */
+    std::vector<int> rowPtr_;
+    /** column indexes */
+    std::vector<int> colIdx_;
+    /** values */
+    std::vector<Real> values_;
 };
 
+} // namespace STK
+
 #endif /* STK_SPARSEMATRIX_H */
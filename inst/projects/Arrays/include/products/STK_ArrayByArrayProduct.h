@@ -108,8 +108,9 @@ struct bp<Lhs, Rhs, Result, (bool)Arrays::by_row_>
     if (nbInnerLoop)
     {
       // create panels and blocks
-      Panel<Type>* tabPanel = new Panel<Type>[nbPanels+1];
-      Block<Type>* tabBlock = new Block<Type>[nbBlocks+1];
+      MemoryArena* p_arena = MemoryArena::current();
+      Panel<Type>* tabPanel = Arrays::allocate<Panel<Type> >(nbPanels+1, p_arena);
+      Block<Type>* tabBlock = Arrays::allocate<Block<Type> >(nbBlocks+1, p_arena);
       // start blocks by panel
       for (int k = 0; k<nbInnerLoop; ++k)
       {
@@ -153,8 +154,8 @@ struct bp<Lhs, Rhs, Result, (bool)Arrays::by_row_>
         }
         blockByPanel( tabBlock[nbBlocks], tabPanel[nbPanels], res, iLastRow, jLastCol, pSize, bSize);
       } // InnerLoop
-      delete[] tabBlock;
-      delete[] tabPanel;
+      Arrays::deallocate(tabBlock, nbBlocks+1, p_arena);
+      Arrays::deallocate(tabPanel, nbPanels+1, p_arena);
     } // if IneerLoop
     // treat the remaining rows, columns
     switch (tSize)
@@ -350,8 +351,9 @@ struct bp<Lhs, Rhs, Result, (bool)Arrays::by_col_>
     if (nbInnerLoop)
     {
       // create panels
-      Panel<Type>* tabPanel = new Panel<Type>[nbPanels+1];
-      Block<Type>* tabBlock = new Block<Type>[nbBlocks+1];
+      MemoryArena* p_arena = MemoryArena::current();
+      Panel<Type>* tabPanel = Arrays::allocate<Panel<Type> >(nbPanels+1, p_arena);
+      Block<Type>* tabBlock = Arrays::allocate<Block<Type> >(nbBlocks+1, p_arena);
       // start blocks by panel
       for (int k = 0; k<nbInnerLoop; ++k)
       {
@@ -392,8 +394,8 @@ struct bp<Lhs, Rhs, Result, (bool)Arrays::by_col_>
         }
         panelByBlock( tabPanel[nbPanels],  tabBlock[nbBlocks], res, lastRow, lastCol, pSize, bSize);
       } // k loop
-      delete[] tabPanel;
-      delete[] tabBlock;
+      Arrays::deallocate(tabBlock, nbBlocks+1, p_arena);
+      Arrays::deallocate(tabPanel, nbPanels+1, p_arena);
     }
     // treat the remaining rows, columns
     switch (tSize)
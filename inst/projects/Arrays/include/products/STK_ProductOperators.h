@@ -48,6 +48,24 @@ namespace STK
 template<typename> class Array2DUpperTriangular;
 template<typename> class Array2DLowerTriangular;
 
+// forward declarations (needed by the ProductOperand class)
+template< typename Type, int SizeRows_, int SizeCols_, bool Orient_> class CArray;
+template< typename Type, int Size_, bool Orient_> class CArraySquare;
+template< typename Type, int SizeRows_, bool Orient_> class CArrayVector;
+template< typename Type, int SizeCols_, bool Orient_> class CArrayPoint;
+template<typename UnaryOp, typename Lhs> class UnaryOperator;
+template<typename BinaryOp, typename Lhs, typename Rhs> class BinaryOperator;
+template<typename Lhs> class TransposeOperator;
+template<typename Lhs> class RowOperator;
+template<typename Lhs> class ColOperator;
+template<typename Lhs, int structure_> class SubOperator;
+
+namespace Const
+{
+template< typename Type_, int Size_> class Vector;
+template< typename Type_, int Size_> class Point;
+}
+
 namespace hidden
 {
 
@@ -80,7 +98,7 @@ struct ProductTraits<Lhs, Rhs, Arrays::array2D_, RStructure_>
               ? int(Arrays::dense_) : int(Arrays::sparse_)
   };
 
-  typedef typename hidden::Promote< typename Lhs::Type, typename Rhs::Type>::result_type Type;
+  typedef typename RemoveConst<typename hidden::Promote<typename Lhs::Type, typename Rhs::Type>::result_type>::Type Type;
   typedef typename RemoveConst<Type>::Type const& ReturnType;
   typedef CAllocator<Type, sizeRows_, sizeCols_, orient_> Allocator;
 };
@@ -103,7 +121,7 @@ struct ProductTraits<Lhs, Rhs, Arrays::square_, RStructure_>
     storage_  = ( Traits<Lhs>::storage_ == int(Arrays::dense_)) || (Traits<Rhs>::storage_ == int(Arrays::dense_))
               ? int(Arrays::dense_) : int(Arrays::sparse_)
   };
-  typedef typename hidden::Promote< typename Lhs::Type, typename Rhs::Type>::result_type Type;
+  typedef typename RemoveConst<typename hidden::Promote<typename Lhs::Type, typename Rhs::Type>::result_type>::Type Type;
   typedef typename RemoveConst<Type>::Type const& ReturnType;
 
   typedef CAllocator<Type, sizeRows_,sizeCols_, orient_> Allocator;
@@ -125,7 +143,7 @@ struct ProductTraits<Lhs, Rhs, Arrays::square_, Arrays::square_>
     storage_  = ( Traits<Lhs>::storage_ == int(Arrays::dense_)) || (Traits<Rhs>::storage_ == int(Arrays::dense_))
               ? int(Arrays::dense_) : int(Arrays::sparse_)
   };
-  typedef typename hidden::Promote< typename Lhs::Type, typename Rhs::Type>::result_type Type;
+  typedef typename RemoveConst<typename hidden::Promote<typename Lhs::Type, typename Rhs::Type>::result_type>::Type Type;
   typedef typename RemoveConst<Type>::Type const& ReturnType;
 
   typedef CAllocator<Type, sizeRows_, sizeCols_, orient_> Allocator;
@@ -149,7 +167,7 @@ struct ProductTraits<Lhs, Rhs, Arrays::lower_triangular_, RStructure_>
     storage_  = ( Traits<Lhs>::storage_ == int(Arrays::dense_)) || (Traits<Rhs>::storage_ == int(Arrays::dense_))
               ? int(Arrays::dense_) : int(Arrays::sparse_)
   };
-  typedef typename hidden::Promote< typename Lhs::Type, typename Rhs::Type>::result_type Type;
+  typedef typename RemoveConst<typename hidden::Promote<typename Lhs::Type, typename Rhs::Type>::result_type>::Type Type;
   typedef typename RemoveConst<Type>::Type const& ReturnType;
 
   typedef CAllocator<Type, sizeRows_, sizeCols_, orient_> Allocator;
@@ -171,7 +189,7 @@ struct ProductTraits<Lhs, Rhs, Arrays::lower_triangular_, Arrays::lower_triangul
     storage_  = ( Traits<Lhs>::storage_ == int(Arrays::dense_)) || (Traits<Rhs>::storage_ == int(Arrays::dense_))
               ? int(Arrays::dense_) : int(Arrays::sparse_)
   };
-  typedef typename hidden::Promote< typename Lhs::Type, typename Rhs::Type>::result_type Type;
+  typedef typename RemoveConst<typename hidden::Promote<typename Lhs::Type, typename Rhs::Type>::result_type>::Type Type;
   typedef typename RemoveConst<Type>::Type const& ReturnType;
 
   typedef Array2DLowerTriangular<Type> Allocator; // no CAllocator
@@ -195,7 +213,7 @@ struct ProductTraits<Lhs, Rhs, Arrays::upper_triangular_, RStructure_>
     storage_  = ( Traits<Lhs>::storage_ == int(Arrays::dense_)) || (Traits<Rhs>::storage_ == int(Arrays::dense_))
               ? int(Arrays::dense_) : int(Arrays::sparse_)
   };
-  typedef typename hidden::Promote< typename Lhs::Type, typename Rhs::Type>::result_type Type;
+  typedef typename RemoveConst<typename hidden::Promote<typename Lhs::Type, typename Rhs::Type>::result_type>::Type Type;
   typedef typename RemoveConst<Type>::Type const& ReturnType;
 
   typedef CAllocator<Type, sizeRows_ , sizeCols_, orient_> Allocator;
@@ -217,12 +235,186 @@ struct ProductTraits<Lhs, Rhs, Arrays::upper_triangular_, Arrays::upper_triangul
     storage_  = ( Traits<Lhs>::storage_ == int(Arrays::dense_)) || (Traits<Rhs>::storage_ == int(Arrays::dense_))
               ? int(Arrays::dense_) : int(Arrays::sparse_)
   };
-  typedef typename hidden::Promote< typename Lhs::Type, typename Rhs::Type>::result_type Type;
+  typedef typename RemoveConst<typename hidden::Promote<typename Lhs::Type, typename Rhs::Type>::result_type>::Type Type;
   typedef typename RemoveConst<Type>::Type const& ReturnType;
 
   typedef Array2DUpperTriangular<Type> Allocator;  // no CAllocator
 };
 
+/** @ingroup hidden
+ *  @brief Traits class telling if an operand of a product is a lazy
+ *  expression, i.e. an expression computing its elements each time they are
+ *  accessed. Containers, constant arrays and products (which are evaluated
+ *  at construction) are not lazy.
+ **/
+template<typename Expr>
+struct IsLazyOperand { enum { yes_ = false }; };
+
+template<typename UnaryOp, typename Lhs>
+struct IsLazyOperand< UnaryOperator<UnaryOp, Lhs> > { enum { yes_ = true }; };
+
+template<typename BinaryOp, typename Lhs, typename Rhs>
+struct IsLazyOperand< BinaryOperator<BinaryOp, Lhs, Rhs> > { enum { yes_ = true }; };
+
+template<typename Lhs>
+struct IsLazyOperand< TransposeOperator<Lhs> > { enum { yes_ = IsLazyOperand<Lhs>::yes_ }; };
+
+template<typename Lhs>
+struct IsLazyOperand< RowOperator<Lhs> > { enum { yes_ = IsLazyOperand<Lhs>::yes_ }; };
+
+template<typename Lhs>
+struct IsLazyOperand< ColOperator<Lhs> > { enum { yes_ = IsLazyOperand<Lhs>::yes_ }; };
+
+template<typename Lhs, int structure_>
+struct IsLazyOperand< SubOperator<Lhs, structure_> > { enum { yes_ = IsLazyOperand<Lhs>::yes_ }; };
+
+/** @ingroup hidden
+ *  @brief Traits class giving the container to use in order to evaluate an
+ *  operand of a product. Only the general, square, vector and point structures
+ *  are evaluated, other structures are used as they are.
+ **/
+template<typename Expr, int Structure_ = Traits<Expr>::structure_>
+struct ProductOperandTraits
+{
+  enum { isEvaluable_ = false };
+  typedef Expr Container;
+};
+
+template<typename Expr>
+struct ProductOperandTraits<Expr, Arrays::array2D_>
+{
+  enum { isEvaluable_ = IsLazyOperand<Expr>::yes_ };
+  typedef typename RemoveConst<typename Traits<Expr>::Type>::Type Type;
+  typedef CArray<Type, Traits<Expr>::sizeRows_, Traits<Expr>::sizeCols_, (bool)Traits<Expr>::orient_> Container;
+  /** set the ranges of the evaluated operand */
+  static inline void shift(Container& cache, Expr const& expr) { cache.shift(expr.beginRows(), expr.beginCols());}
+};
+
+template<typename Expr>
+struct ProductOperandTraits<Expr, Arrays::square_>
+{
+  enum { isEvaluable_ = IsLazyOperand<Expr>::yes_ };
+  typedef typename RemoveConst<typename Traits<Expr>::Type>::Type Type;
+  typedef CArraySquare<Type, Traits<Expr>::sizeRows_, (bool)Traits<Expr>::orient_> Container;
+  /** set the ranges of the evaluated operand */
+  static inline void shift(Container& cache, Expr const& expr) { cache.shift(expr.beginRows());}
+};
+
+template<typename Expr>
+struct ProductOperandTraits<Expr, Arrays::vector_>
+{
+  enum { isEvaluable_ = IsLazyOperand<Expr>::yes_ };
+  typedef typename RemoveConst<typename Traits<Expr>::Type>::Type Type;
+  typedef CArrayVector<Type, Traits<Expr>::sizeRows_, (bool)Traits<Expr>::orient_> Container;
+  /** set the ranges of the evaluated operand */
+  static inline void shift(Container& cache, Expr const& expr) { cache.shift(expr.begin());}
+};
+
+template<typename Expr>
+struct ProductOperandTraits<Expr, Arrays::point_>
+{
+  enum { isEvaluable_ = IsLazyOperand<Expr>::yes_ };
+  typedef typename RemoveConst<typename Traits<Expr>::Type>::Type Type;
+  typedef CArrayPoint<Type, Traits<Expr>::sizeCols_, (bool)Traits<Expr>::orient_> Container;
+  /** set the ranges of the evaluated operand */
+  static inline void shift(Container& cache, Expr const& expr) { cache.shift(expr.begin());}
+};
+
+/** @ingroup hidden
+ *  @brief Wrapper of an operand of a product.
+ *
+ *  The product kernels access the elements of their operands several times.
+ *  If the operand is a lazy expression (e.g. <tt>(x - mu)</tt>), each access
+ *  would evaluate the expression again. In this case the ProductOperand class
+ *  evaluates the expression once in a container which is used by the kernels.
+ *  Otherwise the operand is used directly without copy.
+ *
+ *  @tparam Expr the type of the operand
+ *  @tparam isCached_ @c true if the operand has to be evaluated
+ **/
+template<typename Expr, bool isCached_ = ProductOperandTraits<Expr>::isEvaluable_>
+class ProductOperand
+{
+  public:
+    /** type of the operand used by the kernels */
+    typedef Expr Operand;
+    /** constructor
+     *  @param expr the operand of the product
+     **/
+    inline ProductOperand( Expr const& expr): expr_(expr) {}
+    /** @return the operand to use in the kernels */
+    inline Operand const& operand() const { return expr_;}
+
+  private:
+    /** the operand */
+    Expr const& expr_;
+};
+
+/** @ingroup hidden
+ *  @brief Specialization of the ProductOperand class when the operand is
+ *  evaluated. The ranges of the operand are preserved.
+ **/
+template<typename Expr>
+class ProductOperand<Expr, true>
+{
+  public:
+    /** type of the operand used by the kernels */
+    typedef typename ProductOperandTraits<Expr>::Container Operand;
+    /** constructor. Evaluate the operand.
+     *  @param expr the operand of the product
+     **/
+    inline ProductOperand( Expr const& expr): cache_(expr)
+    { ProductOperandTraits<Expr>::shift(cache_, expr);}
+    /** copy constructor.
+     *  @param op the operand to copy
+     **/
+    inline ProductOperand( ProductOperand const& op): cache_(op.cache_)
+    { ProductOperandTraits<Operand>::shift(cache_, op.cache_);}
+    /** @return the operand to use in the kernels */
+    inline Operand const& operand() const { return cache_;}
+
+  private:
+    /** the evaluated operand */
+    Operand cache_;
+};
+
+/** @ingroup hidden
+ *  @brief Compute the element (i,j) of the rank-one product of a vector
+ *  by a point. If one of the operand is a constant (unit) array, the product
+ *  is a simple broadcast of the other operand.
+ **/
+template<typename Lhs, typename Rhs>
+struct OuterProductElt
+{
+  typedef typename RemoveConst<typename hidden::Promote<typename Lhs::Type, typename Rhs::Type>::result_type>::Type Type;
+  static inline Type run(Lhs const& lhs, Rhs const& rhs, int i, int j)
+  { return lhs.elt(i)*rhs.elt(j);}
+};
+
+template<typename Type_, int Size_, typename Rhs>
+struct OuterProductElt< Const::Vector<Type_, Size_>, Rhs>
+{
+  typedef typename RemoveConst<typename Promote<Type_, typename Rhs::Type>::result_type>::Type Type;
+  static inline Type run(Const::Vector<Type_, Size_> const&, Rhs const& rhs, int, int j)
+  { return rhs.elt(j);}
+};
+
+template<typename Lhs, typename Type_, int Size_>
+struct OuterProductElt< Lhs, Const::Point<Type_, Size_> >
+{
+  typedef typename RemoveConst<typename Promote<typename Lhs::Type, Type_>::result_type>::Type Type;
+  static inline Type run(Lhs const& lhs, Const::Point<Type_, Size_> const&, int i, int)
+  { return lhs.elt(i);}
+};
+
+template<typename Type1, int Size1, typename Type2, int Size2>
+struct OuterProductElt< Const::Vector<Type1, Size1>, Const::Point<Type2, Size2> >
+{
+  typedef typename RemoveConst<typename Promote<Type1, Type2>::result_type>::Type Type;
+  static inline Type run(Const::Vector<Type1, Size1> const&, Const::Point<Type2, Size2> const&, int, int)
+  { return Type(1);}
+};
+
 } // namespace hidden
 
 /** @ingroup Arrays
@@ -348,7 +540,7 @@ struct Traits< DiagonalByArrayProduct < Lhs, Rhs> >
     orient_    = Rhs::orient_,
     storage_   = Rhs::storage_
   };
-  typedef typename Promote<typename Lhs::Type, typename Rhs::Type>::result_type Type;
+  typedef typename RemoveConst<typename hidden::Promote<typename Lhs::Type, typename Rhs::Type>::result_type>::Type Type;
   typedef typename RemoveConst<Type>::Type ReturnType;
 };
 /** @ingroup hidden
@@ -367,7 +559,7 @@ struct Traits< PointByArrayProduct < Lhs, Rhs> >
                   ? int(Arrays::dense_) : int(Arrays::sparse_)
    };
 
-  typedef typename hidden::Promote< typename Lhs::Type, typename Rhs::Type>::result_type Type;
+  typedef typename RemoveConst<typename hidden::Promote<typename Lhs::Type, typename Rhs::Type>::result_type>::Type Type;
   typedef typename RemoveConst<Type>::Type const& ReturnType;
 
   typedef CAllocator<Type, sizeRows_, sizeCols_, orient_> Allocator;
@@ -390,7 +582,7 @@ struct Traits< ArrayByVectorProduct < Lhs, Rhs> >
    };
 
   typedef ProductTraits<Lhs, Rhs, Lhs::structure_, Rhs::structure_> Base;
-  typedef typename hidden::Promote< typename Lhs::Type, typename Rhs::Type>::result_type Type;
+  typedef typename RemoveConst<typename hidden::Promote<typename Lhs::Type, typename Rhs::Type>::result_type>::Type Type;
   typedef typename RemoveConst<Type>::Type const& ReturnType;
 
   typedef CAllocator<Type, sizeRows_, sizeCols_, orient_> Allocator;
@@ -410,7 +602,7 @@ struct Traits< VectorByPointProduct < Lhs, Rhs> >
     storage_   = ( Traits<Lhs>::storage_ == int(Arrays::dense_)) || (Traits<Rhs>::storage_ == int(Arrays::dense_))
                  ? int(Arrays::dense_) : int(Arrays::sparse_)
   };
-  typedef typename Promote<typename Lhs::Type, typename Rhs::Type>::result_type Type;
+  typedef typename RemoveConst<typename hidden::Promote<typename Lhs::Type, typename Rhs::Type>::result_type>::Type Type;
   typedef Type ReturnType;
 };
 /** @ingroup hidden
@@ -434,7 +626,7 @@ struct Traits< ArrayByArrayProduct<Lhs, Rhs> >
     storage_  = ( Traits<Lhs>::storage_ == int(Arrays::dense_)) || (Traits<Rhs>::storage_ == int(Arrays::dense_))
                   ? int(Arrays::dense_) : int(Arrays::sparse_)
   };
-  typedef typename hidden::Promote< typename Lhs::Type, typename Rhs::Type>::result_type Type;
+  typedef typename RemoveConst<typename hidden::Promote<typename Lhs::Type, typename Rhs::Type>::result_type>::Type Type;
   typedef typename RemoveConst<Type>::Type const& ReturnType;
   typedef typename Base::Allocator Allocator;
 };
@@ -549,6 +741,8 @@ class PointByArrayProduct : public ExprBase< PointByArrayProduct<Lhs, Rhs> >
     typedef typename hidden::Traits<PointByArrayProduct>::Type Type;
     typedef typename hidden::Traits<PointByArrayProduct>::ReturnType ReturnType;
     typedef typename hidden::Traits<PointByArrayProduct>::Allocator Allocator;
+    /** lhs operand used in the computation */
+    typedef hidden::ProductOperand<Lhs> LhsOperand;
 
     enum
     {
@@ -570,7 +764,9 @@ class PointByArrayProduct : public ExprBase< PointByArrayProduct<Lhs, Rhs> >
       if (lhs.range() != rhs.rows())
       { STKRUNTIME_ERROR_2ARG(PointByArrayProduct, lhs.range(), rhs.rows(), sizes mismatch);}
       result_.shift(lhs_.beginRows(), rhs_.beginCols());
-      hidden::ProductDispatcher<Lhs, Rhs, Allocator>::run(lhs, rhs, result_);
+      // the elements of lhs are used for each column of rhs
+      LhsOperand lhsOp(lhs);
+      hidden::ProductDispatcher<typename LhsOperand::Operand, Rhs, Allocator>::run(lhsOp.operand(), rhs, result_);
     }
     /**  @return the range of the rows */
     inline RowRange const& rowsImpl() const { return result_.rows();}
@@ -610,6 +806,8 @@ class ArrayByVectorProduct : public ExprBase< ArrayByVectorProduct<Lhs, Rhs> >
     typedef typename hidden::Traits<ArrayByVectorProduct>::Type Type;
     typedef typename hidden::Traits<ArrayByVectorProduct>::ReturnType ReturnType;
     typedef typename hidden::Traits<ArrayByVectorProduct>::Allocator Allocator;
+    /** rhs operand used in the computation */
+    typedef hidden::ProductOperand<Rhs> RhsOperand;
     enum
     {
       structure_ = hidden::Traits<ArrayByVectorProduct>::structure_,
@@ -630,7 +828,9 @@ class ArrayByVectorProduct : public ExprBase< ArrayByVectorProduct<Lhs, Rhs> >
       if (lhs.cols() != rhs.range())
       { STKRUNTIME_ERROR_NO_ARG(ArrayByVectorProduct, sizes mismatch);}
       result_.shift(lhs_.beginRows(), rhs_.beginCols());
-      hidden::ProductDispatcher<Lhs, Rhs, Allocator>::run(lhs, rhs, result_);
+      // the elements of rhs are used for each row of lhs
+      RhsOperand rhsOp(rhs);
+      hidden::ProductDispatcher<Lhs, typename RhsOperand::Operand, Allocator>::run(lhs, rhsOp.operand(), result_);
     }
     /**  @return the range of the rows */
     inline RowRange const& rowsImpl() const { return result_.rows();}
@@ -681,8 +881,19 @@ class VectorByPointProduct : public ExprBase< VectorByPointProduct<Lhs, Rhs> >
     /** Type of the Range for the columns */
     typedef TRange<sizeCols_> ColRange;
 
+    /** lhs and rhs operands used in the computation */
+    typedef hidden::ProductOperand<Lhs> LhsOperand;
+    typedef hidden::ProductOperand<Rhs> RhsOperand;
+    /** rank one product of the operands */
+    typedef hidden::OuterProductElt<typename LhsOperand::Operand, typename RhsOperand::Operand> OuterProduct;
+
+    /** constructor. The lazy operands are evaluated once, the product itself
+     *  is never stored: the elements are computed on the fly.
+     *  @param lhs,rhs the vector and the point to multiply
+     **/
     VectorByPointProduct( const Lhs& lhs, const Rhs& rhs)
                                : Base(), lhs_(lhs), rhs_(rhs)
+                               , lhsOp_(lhs), rhsOp_(rhs)
     {}
     /**  @return the range of the rows */
     inline RowRange const& rowsImpl() const { return lhs_.rows();}
@@ -690,7 +901,8 @@ class VectorByPointProduct : public ExprBase< VectorByPointProduct<Lhs, Rhs> >
     inline ColRange const&colsImpl() const { return rhs_.cols();}
 
     /** @return the element (i,j) */
-    inline ReturnType elt2Impl(int i, int j) const { return lhs_.elt(i)*rhs_.elt(j);}
+    inline ReturnType elt2Impl(int i, int j) const
+    { return OuterProduct::run(lhsOp_.operand(), rhsOp_.operand(), i, j);}
     /** @return the element */
     inline ReturnType elt0Impl() const { return lhs_.elt()*rhs_.elt();}
 
@@ -702,6 +914,12 @@ class VectorByPointProduct : public ExprBase< VectorByPointProduct<Lhs, Rhs> >
   protected:
     Lhs const& lhs_;
     Rhs const& rhs_;
+
+  private:
+    /** the lhs operand (evaluated if needed) */
+    LhsOperand lhsOp_;
+    /** the rhs operand (evaluated if needed) */
+    RhsOperand rhsOp_;
 };
 // forward declaration
 template< typename Lhs, typename Rhs> class ArrayByArrayProductBase;
@@ -726,6 +944,11 @@ class ArrayByArrayProduct : public ArrayByArrayProductBase< Lhs, Rhs >, public T
                || (EGAL(Lhs,vector_) && EGAL(Rhs,point_) )
                || (EGAL(Lhs,point_)  && !EGAL(Rhs,point_) && !EGAL(Rhs,vector_) && !EGAL(Rhs,number_) && !EGAL(Rhs,diagonal_) )
                ),
+      // the dense kernels copy the operands by blocks and read them once,
+      // the other kernels access the elements of the operands many times
+      isDense_ = (  (EGAL(Lhs,array2D_) || EGAL(Lhs,square_))
+                 && (EGAL(Rhs,array2D_) || EGAL(Rhs,square_))
+                 ),
 
       structure_ = hidden::Traits<ArrayByArrayProduct>::structure_,
       orient_    = hidden::Traits<ArrayByArrayProduct>::orient_,
@@ -737,6 +960,11 @@ class ArrayByArrayProduct : public ArrayByArrayProductBase< Lhs, Rhs >, public T
     typedef TRange<sizeRows_> RowRange;
     /** Type of the Range for the columns */
     typedef TRange<sizeCols_> ColRange;
+    /** lhs and rhs operands used in the computation */
+    typedef hidden::ProductOperand<Lhs, !isDense_ && hidden::ProductOperandTraits<Lhs>::isEvaluable_> LhsOperand;
+    typedef hidden::ProductOperand<Rhs, !isDense_ && hidden::ProductOperandTraits<Rhs>::isEvaluable_> RhsOperand;
+    /** dispatcher to use */
+    typedef hidden::ProductDispatcher<typename LhsOperand::Operand, typename RhsOperand::Operand, Allocator> Dispatcher;
 
     inline ArrayByArrayProduct( const Lhs& lhs, const Rhs& rhs)
                               : Base(), lhs_(lhs), rhs_(rhs)
@@ -746,8 +974,10 @@ class ArrayByArrayProduct : public ArrayByArrayProductBase< Lhs, Rhs >, public T
       if (lhs.cols() != rhs.rows())
       { STKRUNTIME_ERROR_NO_ARG(ArrayByArrayProduct,sizes mismatch for 2D array);}
       result_.shift(lhs_.beginRows(), rhs_.beginCols());
-      (orient_) ? hidden::ProductDispatcher<Lhs, Rhs, Allocator>::runpb(lhs, rhs, result_)
-                : hidden::ProductDispatcher<Lhs, Rhs, Allocator>::runbp(lhs, rhs, result_);
+      LhsOperand lhsOp(lhs);
+      RhsOperand rhsOp(rhs);
+      (orient_) ? Dispatcher::runpb(lhsOp.operand(), rhsOp.operand(), result_)
+                : Dispatcher::runbp(lhsOp.operand(), rhsOp.operand(), result_);
     }
     /**  @return the range of the rows */
     inline RowRange const& rowsImpl() const { return lhs_.rows();}
@@ -130,10 +130,16 @@ class VisitorByCol : public VisitorByColBase< Derived, Visitor >, public TRef<1>
     /** Type of the Range for the columns */
     typedef TRange<sizeCols_> ColRange;
 
-    /** constructor */
+    /** constructor. The columns are visited in parallel if the array is
+     *  large and the columns are too small for being visited in parallel.
+     **/
     VisitorByCol( Derived const& lhs) : lhs_(lhs), result_(1,lhs_.sizeCols())
     {
       result_.shift(lhs_.beginCols());
+#ifdef _OPENMP
+#pragma omp parallel for if (  lhs_.sizeRows() < ParallelThreshold \
+                            && double(lhs_.sizeRows())*double(lhs_.sizeCols()) >= ParallelThreshold)
+#endif
       for (int j= lhs_.beginCols(); j < lhs_.endCols(); ++j)
       {
         Visitor<Type_> visit;
@@ -245,10 +251,16 @@ class VisitorByRow : public VisitorByRowBase< Derived, Visitor >, public TRef<1>
     /** Type of the Range for the columns */
     typedef TRange<sizeCols_> ColRange;
 
-    /** constructor */
+    /** constructor. The rows are visited in parallel if the array is
+     *  large and the rows are too small for being visited in parallel.
+     **/
     VisitorByRow( Derived const& lhs): lhs_(lhs), result_(lhs_.sizeRows(), 1)
     {
       result_.shift(lhs_.beginRows());
+#ifdef _OPENMP
+#pragma omp parallel for if (  lhs_.sizeCols() < ParallelThreshold \
+                            && double(lhs_.sizeRows())*double(lhs_.sizeCols()) >= ParallelThreshold)
+#endif
       for (int i= lhs_.beginRows(); i < lhs_.endRows(); ++i)
       {
         Visitor<Type_> visit;
@@ -309,7 +321,7 @@ struct ApplyVisitor
   inline ApplyVisitor( ExprBase<Derived> const& lhs) : lhs_(lhs.asDerived())
   {
     Visitor<Type_> visit;
-    lhs_.visit(visit);
+    result_ = lhs_.visit(visit);
   }
   /** overload cast operator */
   inline operator Type () const { return result_;}
@@ -390,6 +402,14 @@ STK_SLICEVISITORS(MaxVisitor,max)
  *  @sa STK::min, STK::max, STK::mean, STK::count, STK::all, STK::any.
  **/
 STK_SLICEVISITORS(SumVisitor,sum)
+/** @ingroup SlicingVisitors
+ *  If A is a row-vector or a column-vector then the function will return the
+ *  sum of the vector computed using the compensated (Kahan) summation. If A is
+ *  a two-dimensional array, the function will return a STK::VisitorByCol or
+ *  a STK::VisitorByRow structure with the sums.
+ *  @sa STK::sum
+ **/
+STK_SLICEVISITORS(SumKahanVisitor,sumKahan)
 /** @ingroup SlicingVisitors
  *  If A is a row-vector or a column-vector then the function will return the
  *  usual mean value of the vector. If A is a two-dimensional array, the
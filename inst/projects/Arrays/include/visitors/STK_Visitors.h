@@ -74,6 +74,9 @@ struct EltVisitor2DBase
   int row_, col_;
   Type res_;
   inline ReturnType result() const { return res_;}
+  /** set the result and its indexes of this with the ones of other */
+  inline void set(EltVisitor2DBase const& other)
+  { res_ = other.res_; row_ = other.row_; col_ = other.col_;}
 };
 
 /** @ingroup hidden
@@ -91,6 +94,9 @@ struct MinEltVisitor : EltVisitor2DBase<Type>
     if (value < this->res_)
     { this->res_ = value; this->row_ = i; this->col_ = j;}
   }
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( MinEltVisitor const& other)
+  { if (other.res_ < this->res_) { this->set(other);} }
 };
 
 /** @ingroup hidden
@@ -109,6 +115,9 @@ struct MinEltSafeVisitor : EltVisitor2DBase<Type>
     if (Arithmetic<Type>::isFinite(value) && (value < this->res_))
     { this->res_ = value; this->row_ = i; this->col_ = j;}
   }
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( MinEltSafeVisitor const& other)
+  { if (other.res_ < this->res_) { this->set(other);} }
 };
 /** @ingroup hidden
  *  @brief Visitor computing the maximal coefficient of the Array
@@ -125,6 +134,9 @@ struct MaxEltVisitor : EltVisitor2DBase<Type>
     if (value > this->res_)
     { this->res_ = value; this->row_ = i; this->col_ = j;}
   }
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( MaxEltVisitor const& other)
+  { if (other.res_ > this->res_) { this->set(other);} }
 };
 /** @ingroup hidden
  *  @brief Visitor computing safely the maximal coefficient of the Array
@@ -142,6 +154,9 @@ struct MaxEltSafeVisitor : EltVisitor2DBase<Type>
       if(value > this->res_)
       { this->res_ = value; this->row_ = i; this->col_ = j;}
   }
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( MaxEltSafeVisitor const& other)
+  { if (other.res_ > this->res_) { this->set(other);} }
 };
 /** @ingroup hidden
  *  @brief Visitor computing the min of all the coefficients of the Array
@@ -160,6 +175,8 @@ struct MinVisitor
   inline void operator() ( Type const& value, int i)
   { res_ = std::min(res_,value);}
   inline ReturnType result() const { return res_;}
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( MinVisitor const& other) { res_ = std::min(res_, other.res_);}
 };
 /** @ingroup hidden
  *  @brief Visitor computing safely the min of all the coefficients of the Array
@@ -178,6 +195,8 @@ struct MinSafeVisitor
   inline void operator() ( Type const& value, int i)
   { if (Arithmetic<Type>::isFinite(value)) { res_ = std::min(res_,value);}}
   inline ReturnType result() const { return res_;}
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( MinSafeVisitor const& other) { res_ = std::min(res_, other.res_);}
 };
 /** @ingroup hidden
  *  @brief Visitor computing the max of all the coefficients of the Array
@@ -196,6 +215,8 @@ struct MaxVisitor
   inline void operator() ( Type const& value, int i)
   { res_ = std::max(res_,value);}
   inline ReturnType result() const { return res_;}
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( MaxVisitor const& other) { res_ = std::max(res_, other.res_);}
 };
 /** @ingroup hidden
  *  @brief Visitor computing safely the max of all the coefficients of the Array
@@ -214,6 +235,8 @@ struct MaxSafeVisitor
   inline void operator() ( Type const& value, int i)
   { if (Arithmetic<Type>::isFinite(value)) { res_ = std::max(res_,value);}}
   inline ReturnType result() const { return res_;}
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( MaxSafeVisitor const& other) { res_ = std::max(res_, other.res_);}
 };
 /** @ingroup hidden
  *  @brief Visitor computing the sum of all the coefficients of the Array
@@ -232,6 +255,36 @@ struct SumVisitor
   inline void operator() ( Type const& value, int i)
   { res_ += value;}
   inline ReturnType result() const { return res_;}
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( SumVisitor const& other) { res_ += other.res_;}
+};
+/** @ingroup hidden
+ *  @brief Visitor computing the sum of all the coefficients of the Array
+ *  using the compensated (Kahan) summation algorithm.
+ *
+ * @sa ExprBase::sumKahan()
+ */
+template <typename Type_>
+struct SumKahanVisitor
+{
+  typedef Type_ Type;
+  typedef typename hidden::RemoveConst<Type>::Type const& ReturnType;
+  Type res_;
+  /** running compensation of the lost low-order bits */
+  Type c_;
+  inline SumKahanVisitor(): res_(Type(0)), c_(Type(0)) {}
+  inline void operator() ( Type const& value, int i, int j) { add(value);}
+  inline void operator() ( Type const& value, int i) { add(value);}
+  inline ReturnType result() const { return res_;}
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( SumKahanVisitor const& other) { add(other.res_); add(-other.c_);}
+  /** add a value to the sum */
+  inline void add( Type const& value)
+  {
+    Type const y = value - c_, t = res_ + y;
+    c_ = (t - res_) - y;
+    res_ = t;
+  }
 };
 /** @ingroup hidden
  *  @brief Visitor computing the mean of all the coefficients of the Array
@@ -251,6 +304,8 @@ struct MeanVisitor
   inline void operator() ( Type const& value, int i)
   { res_ += value; nb_++;}
   inline ReturnType result() const { return nb_ == 0  ? Arithmetic<Type>::NA() : res_/nb_;}
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( MeanVisitor const& other) { res_ += other.res_; nb_ += other.nb_;}
 };
 /** @ingroup hidden
  *  @brief Visitor computing safely the mean of all the coefficients of the Array
@@ -276,6 +331,8 @@ struct MeanSafeVisitor
     {  res_ += value; nb_++;}
   }
   inline ReturnType result() const { return nb_ == 0  ? Arithmetic<Type>::NA() : res_/nb_;}
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( MeanSafeVisitor const& other) { res_ += other.res_; nb_ += other.nb_;}
 };
 /** @ingroup hidden
  *  @brief Visitor counting the number of not-zero element in an array
@@ -300,6 +357,8 @@ struct CountVisitor
   inline void operator() ( Type_ const& value, int i)
   { if (value) ++res_;}
   inline ReturnType result() const { return res_;}
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( CountVisitor const& other) { res_ += other.res_;}
 };
 
 /** @ingroup hidden
@@ -324,6 +383,8 @@ struct AllVisitor
   inline void operator() ( Type_ const& value, int i)
   { res_ &= (value);}
   inline ReturnType result() const { return res_;}
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( AllVisitor const& other) { res_ &= other.res_;}
 };
 /** @ingroup hidden
  *  @brief Visitor checking if at least, one element of an array is different
@@ -345,6 +406,8 @@ struct AnyVisitor
   inline void operator() ( Type_ const& value, int i, int j) { res_ |= (value);}
   inline void operator() ( Type_ const& value, int i) { res_ |= (value);}
   inline ReturnType result() const { return res_;}
+  /** merge the result of a visitor applied on the next elements */
+  inline void join( AnyVisitor const& other) { res_ |= other.res_;}
 };
 
 /** @ingroup hidden
@@ -393,6 +456,32 @@ struct ValueApplier
   { value = value_;}
 };
 
+/** @ingroup hidden
+ *  @brief The visitors below can be applied in parallel on blocks of
+ *  elements, the partial results being merged using their @c join method.
+ **/
+#define STK_PARALLEL_VISITOR(VISITOR) \
+template <typename Type> \
+struct IsParallelVisitor< VISITOR<Type> > { enum { yes_ = true }; };
+
+STK_PARALLEL_VISITOR(MinEltVisitor)
+STK_PARALLEL_VISITOR(MinEltSafeVisitor)
+STK_PARALLEL_VISITOR(MaxEltVisitor)
+STK_PARALLEL_VISITOR(MaxEltSafeVisitor)
+STK_PARALLEL_VISITOR(MinVisitor)
+STK_PARALLEL_VISITOR(MinSafeVisitor)
+STK_PARALLEL_VISITOR(MaxVisitor)
+STK_PARALLEL_VISITOR(MaxSafeVisitor)
+STK_PARALLEL_VISITOR(SumVisitor)
+STK_PARALLEL_VISITOR(SumKahanVisitor)
+STK_PARALLEL_VISITOR(MeanVisitor)
+STK_PARALLEL_VISITOR(MeanSafeVisitor)
+STK_PARALLEL_VISITOR(CountVisitor)
+STK_PARALLEL_VISITOR(AllVisitor)
+STK_PARALLEL_VISITOR(AnyVisitor)
+
+#undef STK_PARALLEL_VISITOR
+
 } //namespace hidden
 
 } // namespace STK
@@ -36,6 +36,8 @@
 #ifndef STK_VISITORSIMPL_H
 #define STK_VISITORSIMPL_H
 
+#include <vector>
+
 #define Idx(size) baseIdx + size - 1
 
 namespace STK
@@ -67,6 +69,150 @@ struct VisitorUpperImpl;
 template<typename Visitor, typename Derived, int orient_>
 struct VisitorLowerImpl;
 
+/** @ingroup hidden
+ *  @brief Traits class allowing to know if a visitor can be applied in
+ *  parallel. A parallel visitor have to provide a method
+ *  @code
+ *    void join(Visitor const& other);
+ *  @endcode
+ *  merging in this the result of a visitor applied on the next elements.
+ **/
+template<typename Visitor>
+struct IsParallelVisitor
+{ enum { yes_ = false }; };
+
+/** @ingroup hidden
+ *  @brief Parallel implementation of the visitation of large arrays.
+ *
+ *  The elements are split in blocks of (at most) ReductionBlockSize elements
+ *  in a fixed way. Each block is visited by its own visitor and the partial
+ *  results are merged pairwise in the order of the blocks, so that the result
+ *  is reproducible whatever the number of threads.
+ *
+ *  The methods return @c false, and do nothing, if the visitor cannot be
+ *  applied in parallel or if the array has less than ParallelThreshold
+ *  elements.
+ **/
+template<typename Visitor, bool isParallel_ = IsParallelVisitor<Visitor>::yes_>
+struct VisitorParallelImpl
+{
+  template<typename Derived>
+  inline static bool runByCol( Derived const&, Visitor&) { return false;}
+  template<typename Derived>
+  inline static bool runByRow( Derived const&, Visitor&) { return false;}
+  template<typename Derived>
+  inline static bool runVector( Derived const&, Visitor&) { return false;}
+  template<typename Derived>
+  inline static bool runPoint( Derived const&, Visitor&) { return false;}
+};
+
+/** @ingroup hidden
+ *  @brief Specialization for the visitors which can be applied in parallel.
+ **/
+template<typename Visitor>
+struct VisitorParallelImpl<Visitor, true>
+{
+  /** visit a column oriented array by blocks of rows */
+  template<typename Derived>
+  static bool runByCol( Derived const& tab, Visitor& visitor)
+  {
+#ifdef _OPENMP
+    if (double(tab.sizeRows())*double(tab.sizeCols()) < ParallelThreshold) return false;
+    const int nbBlocksByCol = (tab.sizeRows() + ReductionBlockSize - 1)/ReductionBlockSize;
+    const int nbBlocks = nbBlocksByCol * tab.sizeCols();
+    std::vector<Visitor> partial(nbBlocks);
+#pragma omp parallel for
+    for (int b = 0; b < nbBlocks; ++b)
+    {
+      const int j = tab.beginCols() + b / nbBlocksByCol;
+      const int first = tab.beginRows() + (b % nbBlocksByCol) * ReductionBlockSize;
+      const int end = std::min(first + ReductionBlockSize, tab.endRows());
+      for (int i = first; i < end; ++i) { partial[b](tab.elt(i, j), i, j);}
+    }
+    merge(partial, visitor);
+    return true;
+#else
+    return false;
+#endif
+  }
+  /** visit a row oriented array by blocks of columns */
+  template<typename Derived>
+  static bool runByRow( Derived const& tab, Visitor& visitor)
+  {
+#ifdef _OPENMP
+    if (double(tab.sizeRows())*double(tab.sizeCols()) < ParallelThreshold) return false;
+    const int nbBlocksByRow = (tab.sizeCols() + ReductionBlockSize - 1)/ReductionBlockSize;
+    const int nbBlocks = nbBlocksByRow * tab.sizeRows();
+    std::vector<Visitor> partial(nbBlocks);
+#pragma omp parallel for
+    for (int b = 0; b < nbBlocks; ++b)
+    {
+      const int i = tab.beginRows() + b / nbBlocksByRow;
+      const int first = tab.beginCols() + (b % nbBlocksByRow) * ReductionBlockSize;
+      const int end = std::min(first + ReductionBlockSize, tab.endCols());
+      for (int j = first; j < end; ++j) { partial[b](tab.elt(i, j), i, j);}
+    }
+    merge(partial, visitor);
+    return true;
+#else
+    return false;
+#endif
+  }
+  /** visit a vector by blocks of elements */
+  template<typename Derived>
+  static bool runVector( Derived const& tab, Visitor& visitor)
+  {
+#ifdef _OPENMP
+    if (tab.size() < ParallelThreshold) return false;
+    const int nbBlocks = (tab.size() + ReductionBlockSize - 1)/ReductionBlockSize;
+    std::vector<Visitor> partial(nbBlocks);
+#pragma omp parallel for
+    for (int b = 0; b < nbBlocks; ++b)
+    {
+      const int first = tab.begin() + b * ReductionBlockSize;
+      const int end = std::min(first + ReductionBlockSize, tab.end());
+      for (int i = first; i < end; ++i) { partial[b](tab.elt(i), i, tab.colIdx());}
+    }
+    merge(partial, visitor);
+    return true;
+#else
+    return false;
+#endif
+  }
+  /** visit a point by blocks of elements */
+  template<typename Derived>
+  static bool runPoint( Derived const& tab, Visitor& visitor)
+  {
+#ifdef _OPENMP
+    if (tab.size() < ParallelThreshold) return false;
+    const int nbBlocks = (tab.size() + ReductionBlockSize - 1)/ReductionBlockSize;
+    std::vector<Visitor> partial(nbBlocks);
+#pragma omp parallel for
+    for (int b = 0; b < nbBlocks; ++b)
+    {
+      const int first = tab.begin() + b * ReductionBlockSize;
+      const int end = std::min(first + ReductionBlockSize, tab.end());
+      for (int j = first; j < end; ++j) { partial[b](tab.elt(j), tab.rowIdx(), j);}
+    }
+    merge(partial, visitor);
+    return true;
+#else
+    return false;
+#endif
+  }
+  /** merge pairwise the partial results in the order of the blocks */
+  static void merge( std::vector<Visitor>& partial, Visitor& visitor)
+  {
+    const int nbBlocks = partial.size();
+    for (int step = 1; step < nbBlocks; step *= 2)
+    {
+      for (int b = 0; b + step < nbBlocks; b += 2*step)
+      { partial[b].join(partial[b+step]);}
+    }
+    if (nbBlocks > 0) visitor.join(partial[0]);
+  }
+};
+
 
 /** @ingroup hidden
  *  @brief Specialization for general 2D arrays, data stored by column and
@@ -76,6 +222,7 @@ struct VisitorArrayNoUnrollImpl<Visitor, Derived, Arrays::by_col_, UnknownSize,
 {
   static void run( Derived const& tab, Visitor& visitor)
   {
+    if (VisitorParallelImpl<Visitor>::runByCol(tab, visitor)) return;
     for(int j = tab.beginCols(); j < tab.endCols(); ++j)
       for(int i = tab.beginRows(); i < tab.endRows(); ++i)
         visitor(tab.elt(i, j), i, j);
@@ -96,6 +243,7 @@ struct VisitorArrayNoUnrollImpl<Visitor, Derived, Arrays::by_row_, UnknownSize,
 {
   static void run( Derived const& tab, Visitor& visitor)
   {
+    if (VisitorParallelImpl<Visitor>::runByRow(tab, visitor)) return;
     for(int i = tab.beginRows(); i < tab.endRows(); ++i)
       for(int j = tab.beginCols(); j < tab.endCols(); ++j)
         visitor(tab.elt(i, j), i, j);
@@ -328,8 +476,11 @@ template<typename Visitor, typename Derived>
 struct VisitorVectorImpl<Visitor, Derived, UnknownSize>
 {
   static void run( Derived const& tab, Visitor& visitor)
-  { for(int i = tab.begin(); i < tab.end(); ++i)
-    visitor(tab.elt(i), i, tab.colIdx());}
+  {
+    if (VisitorParallelImpl<Visitor>::runVector(tab, visitor)) return;
+    for(int i = tab.begin(); i < tab.end(); ++i)
+    visitor(tab.elt(i), i, tab.colIdx());
+  }
   static void apply( Derived& tab, Visitor& applier)
   { for(int i = tab.begin(); i < tab.end(); ++i) applier(tab.elt(i));}
 };
@@ -369,7 +520,10 @@ template<typename Visitor, typename Derived>
 struct VisitorPointImpl<Visitor, Derived, UnknownSize>
 {
   static void run( Derived const& tab, Visitor& visitor)
-  { for(int j = tab.begin(); j < tab.end(); ++j) visitor(tab.elt(j), tab.rowIdx(),j);}
+  {
+    if (VisitorParallelImpl<Visitor>::runPoint(tab, visitor)) return;
+    for(int j = tab.begin(); j < tab.end(); ++j) visitor(tab.elt(j), tab.rowIdx(),j);
+  }
   static void apply( Derived& tab, Visitor& applier)
   { for(int j = tab.begin(); j < tab.end(); ++j) applier(tab.elt(j));}
 };
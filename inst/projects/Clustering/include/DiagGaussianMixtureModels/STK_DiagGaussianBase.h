@@ -37,6 +37,7 @@
 
 #include "../STK_IMixtureModel.h"
 #include "../STK_MixtureParameters.h"
+#include "STK_DiagGaussianKernels.h"
 #include <STatistiK/include/STK_Law_Normal.h>
 #include <STatistiK/include/STK_Law_Uniform.h>
 
@@ -0,0 +1,195 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015 Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._DOT_I..._AT_stkpp.org (see copyright for ...)
+*/
+
+
+/*
+ * Project:  stkpp::Clustering
+ * Purpose:  Implementation of the fixed size kernels used by the diagonal
+ *           Gaussian mixture models.
+ * Author:   Serge Iovleff
+ **/
+
+/** @file STK_DiagGaussianKernels.h
+ *  @brief In this file we implement the kernels computing the log-density of
+ *  a sample in a component of a diagonal Gaussian mixture.
+ *
+ *  The variables are processed by blocks of fixed size, so that the loops
+ *  are unrolled at compile time and the parameters of a block are kept in
+ *  registers. The size of the last (partial) block is dispatched at runtime.
+ **/
+
+#ifndef STK_DIAGGAUSSIANKERNELS_H
+#define STK_DIAGGAUSSIANKERNELS_H
+
+#include <cmath>
+#include <Analysis/include/STK_Const_Math.h>
+#include <STatistiK/include/STK_Law_Normal.h>
+
+namespace STK
+{
+
+namespace hidden
+{
+/** @ingroup hidden
+ *  Standard deviation used when the standard deviation is a scalar
+ *  which is applied outside the kernel.
+ **/
+struct UnitSigma
+{
+  inline Real operator[](int) const { return 1.;}
+};
+
+/** @ingroup hidden
+ *  Compute, for Size_ consecutive variables beginning at j, the sum of the
+ *  squared standardized values and the product of the standard deviations.
+ *  The recursion is resolved at compile time.
+ **/
+template<int Size_>
+struct DiagGaussianBlockImpl
+{
+  template<class Array, class Mean, class Sigma>
+  static inline void run( Array const& data, int i, int j
+                        , Mean const& mu, Sigma const& sigma
+                        , Real& quad, Real& prod)
+  {
+    Real const d = (data.elt(i,j) - mu[j])/sigma[j];
+    quad += d*d;
+    prod *= sigma[j];
+    DiagGaussianBlockImpl<Size_-1>::run(data, i, j+1, mu, sigma, quad, prod);
+  }
+};
+
+/** @ingroup hidden
+ *  Specialization ending the recursion.
+ **/
+template<>
+struct DiagGaussianBlockImpl<0>
+{
+  template<class Array, class Mean, class Sigma>
+  static inline void run( Array const&, int, int, Mean const&, Sigma const&, Real&, Real&)
+  {}
+};
+
+/** @ingroup hidden
+ *  Kernel computing the sum of the squared standardized values and of the
+ *  logarithms of the standard deviations of a sample.
+ **/
+struct DiagGaussianKernel
+{
+  enum
+  {
+    /** number of variables processed in the unrolled loops */
+    blockSize_ = 8
+  };
+  /** Compute the sums for the variables in the range J.
+   *  @param data the data set
+   *  @param i index of the sample
+   *  @param J range of the variables
+   *  @param mu,sigma mean and standard deviation of the variables
+   *  @param[out] quad sum of the squared standardized values
+   *  @param[out] lnSigma sum of the logarithms of the standard deviations
+   *  @return @c false if a standard deviation is not positive or the
+   *  computations overflow
+   **/
+  template<class Array, class Mean, class Sigma>
+  static bool run( Array const& data, int i, Range const& J
+                 , Mean const& mu, Sigma const& sigma
+                 , Real& quad, Real& lnSigma)
+  {
+    quad = 0.; lnSigma = 0.;
+    int j = J.begin();
+    for (; j + blockSize_ <= J.end(); j += blockSize_)
+    {
+      Real prod = 1.;
+      DiagGaussianBlockImpl<blockSize_>::run(data, i, j, mu, sigma, quad, prod);
+      if (!(prod > 0.) || !Arithmetic<Real>::isFinite(prod)) return false;
+      lnSigma += std::log(prod);
+    }
+    Real prod = 1.;
+    switch (J.end() - j)
+    {
+      case 1: DiagGaussianBlockImpl<1>::run(data, i, j, mu, sigma, quad, prod); break;
+      case 2: DiagGaussianBlockImpl<2>::run(data, i, j, mu, sigma, quad, prod); break;
+      case 3: DiagGaussianBlockImpl<3>::run(data, i, j, mu, sigma, quad, prod); break;
+      case 4: DiagGaussianBlockImpl<4>::run(data, i, j, mu, sigma, quad, prod); break;
+      case 5: DiagGaussianBlockImpl<5>::run(data, i, j, mu, sigma, quad, prod); break;
+      case 6: DiagGaussianBlockImpl<6>::run(data, i, j, mu, sigma, quad, prod); break;
+      case 7: DiagGaussianBlockImpl<7>::run(data, i, j, mu, sigma, quad, prod); break;
+      default: break;
+    }
+    if (!(prod > 0.) || !Arithmetic<Real>::isFinite(prod)) return false;
+    lnSigma += std::log(prod);
+    return Arithmetic<Real>::isFinite(quad);
+  }
+};
+
+} // namespace hidden
+
+namespace Clust
+{
+/** @ingroup Clustering
+ *  Compute the log-density of the i-th sample of a data set in a diagonal
+ *  Gaussian component with a standard deviation for each variable.
+ *  @param data the data set
+ *  @param i index of the sample
+ *  @param mu,sigma the means and the standard deviations of the component
+ **/
+template<class Array, class Mean, class Sigma>
+Real diagGaussianLnDensity( Array const& data, int i, Mean const& mu, Sigma const& sigma)
+{
+  Real quad, lnSigma;
+  if (hidden::DiagGaussianKernel::run(data, i, data.cols(), mu, sigma, quad, lnSigma))
+  { return -(data.sizeCols()*Const::_LNSQRT2PI_ + lnSigma + 0.5*quad);}
+  // degenerate parameters: use the general density
+  Real sum = 0.;
+  for (int j=data.beginCols(); j<data.endCols(); ++j)
+  { sum += Law::Normal::lpdf(data.elt(i,j), mu[j], sigma[j]);}
+  return sum;
+}
+/** @ingroup Clustering
+ *  Compute the log-density of the i-th sample of a data set in a diagonal
+ *  Gaussian component with the same standard deviation for all the variables.
+ *  @param data the data set
+ *  @param i index of the sample
+ *  @param mu,sigma the means and the standard deviation of the component
+ **/
+template<class Array, class Mean>
+Real diagGaussianLnDensity( Array const& data, int i, Mean const& mu, Real const& sigma)
+{
+  Real quad, lnSigma;
+  if ( (sigma > 0.) && Arithmetic<Real>::isFinite(sigma)
+     && hidden::DiagGaussianKernel::run(data, i, data.cols(), mu, hidden::UnitSigma(), quad, lnSigma))
+  { return -data.sizeCols()*(Const::_LNSQRT2PI_ + std::log(sigma)) - 0.5*quad/(sigma*sigma);}
+  // degenerate parameters: use the general density
+  Real sum = 0.;
+  for (int j=data.beginCols(); j<data.endCols(); ++j)
+  { sum += Law::Normal::lpdf(data.elt(i,j), mu[j], sigma);}
+  return sum;
+}
+
+} // namespace Clust
+
+} // namespace STK
+
+#endif /* STK_DIAGGAUSSIANKERNELS_H */
@@ -167,10 +167,7 @@ class Gaussian_sjk : public DiagGaussianBase<Gaussian_sjk<Array> >
      **/
     inline Real lnComponentProbability(int i, int k) const
     {
-      Real sum =0.;
-      for (int j=p_data()->beginCols(); j<p_data()->endCols(); ++j)
-      { sum += Law::Normal::lpdf(p_data()->elt(i,j), param_.mean_[k][j], param_.sigma_[k][j]);}
-      return sum;
+      return Clust::diagGaussianLnDensity(*p_data(), i, param_.mean_[k], param_.sigma_[k]);
     }
     /** Initialize randomly the parameters of the Gaussian mixture. The centers
      *  will be selected randomly among the data set and the standard-deviation
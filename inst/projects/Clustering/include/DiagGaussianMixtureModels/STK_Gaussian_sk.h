@@ -159,14 +159,7 @@ class Gaussian_sk : public DiagGaussianBase<Gaussian_sk<Array> >
      **/
     inline Real lnComponentProbability(int i, int k) const
     {
-      Real sum =0.;
-      for (int j=p_data()->beginCols(); j<p_data()->endCols(); ++j)
-      {
-        Real mean  = param_.mean_[k][j];
-        Real sigma = param_.sigma_[k];
-        sum += Law::Normal::lpdf(p_data()->elt(i,j), mean, sigma);
-      }
-      return sum;
+      return Clust::diagGaussianLnDensity(*p_data(), i, param_.mean_[k], param_.sigma_[k]);
     }
     /** Initialize randomly the parameters of the Gaussian mixture. The centers
      *  will be selected randomly among the data set and the standard-deviations
@@ -0,0 +1,623 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015 Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._DOT_I..._AT_stkpp.org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Clustering
+ * Purpose:  Base classes of the Gaussian mixture models with full
+ *           covariance matrices.
+ * Author:   Serge Iovleff
+ **/
+
+/** @file STK_FullGaussianBase.h
+ *  @brief In this file we implement the base classes for the Gaussian models
+ *  with full covariance matrices.
+ **/
+
+#ifndef STK_FULLGAUSSIANBASE_H
+#define STK_FULLGAUSSIANBASE_H
+
+#include <cmath>
+#include <map>
+#include <algorithm>
+#include <vector>
+
+#include "../STK_IMixtureModel.h"
+#include "../STK_MixtureParameters.h"
+
+#include <Arrays/include/STK_CArray.h>
+#include <Arrays/include/STK_CArrayPoint.h>
+#include <Analysis/include/STK_Const_Math.h>
+#include <Algebra/include/STK_BatchSymmetric.h>
+#include <STatistiK/include/STK_Law_Normal.h>
+#include <STatistiK/include/STK_Law_Uniform.h>
+
+namespace STK
+{
+
+/** @ingroup Clustering
+ *  Base class for the parameters handlers of the Gaussian models with full
+ *  covariance matrices. The means and the covariance matrices of all the
+ *  components are stored, together with the Cholesky factors of the
+ *  covariance matrices, which are used by the E-step.
+ *
+ *  The parameters are stored in an array of size (d+1)K by d: for each
+ *  component, the first row is the mean and the next d rows are the
+ *  covariance matrix.
+ **/
+template<class Derived>
+struct FullGaussianHandlerBase: public IRecursiveTemplate<Derived>
+{
+  /** means and statistics */
+  MixtureParametersSet<PointX> mean_;
+  /** covariance matrices and statistics */
+  MixtureParametersSet<ArrayXX> sigma_;
+  /** Cholesky factors of the covariance matrices */
+  BatchSymmetric chol_;
+
+  /** @return the mean of the kth cluster and jth variable */
+  inline Real const& meanImpl(int k, int j) const { return mean_[k][j];}
+  /** @return the covariance of the kth cluster between the variables i and j */
+  inline Real const& sigmaImpl(int k, int i, int j) const { return sigma_[k](i,j);}
+  /** @return the log-determinant of the covariance matrix of the kth cluster */
+  inline Real logDet(int k) const { return chol_.logDet()[k-mean_().begin()];}
+  /** @return a pointer on the Cholesky factor of the kth cluster */
+  inline Real const* p_chol(int k) const { return chol_.p_matrix(k-mean_().begin());}
+
+  /** Initialize the parameters of the model.
+   *  The means are set to zero and the covariance matrices to the identity.
+   *  @param range range of the variables
+   **/
+  void resize(Range const& range)
+  {
+    mean_.resize(range);
+    mean_.initialize(0.);
+    sigma_.resize(range, range);
+    sigma_.initialize(0.);
+    for (int k= sigma_().begin(); k < sigma_().end(); ++k)
+    {
+      for (int j= range.begin(); j < range.end(); ++j) { sigma_[k](j,j) = 1.;}
+    }
+    computeFactors();
+  }
+  /** Compute the Cholesky factors and the log-determinants of the covariance
+   *  matrices.
+   *  @return @c false if a covariance matrix is not positive definite
+   **/
+  bool computeFactors()
+  {
+    const int nbCluster = sigma_().size(), p = mean_[mean_().begin()].size();
+    if (chol_.nbMatrix() != nbCluster || chol_.dim() != p) { chol_.resize(nbCluster, p);}
+    for (int k= sigma_().begin(); k < sigma_().end(); ++k)
+    { chol_.setMatrix(k - sigma_().begin(), sigma_[k]);}
+    return chol_.cholesky();
+  }
+  /** Store the intermediate results of the Mixture.
+   *  @param iteration Provides the iteration number beginning after the burn-in period.
+   **/
+  inline void storeIntermediateResults(int iteration)
+  { mean_.storeIntermediateResults(iteration); sigma_.storeIntermediateResults(iteration);}
+  /** Release the stored results. This is usually used if the estimation
+   *  process failed.
+   **/
+  inline void releaseIntermediateResults()
+  { mean_.releaseIntermediateResults(); sigma_.releaseIntermediateResults();}
+  /** set the parameters stored in stat_proba_ and release stat_proba_. */
+  inline void setParameters()
+  { mean_.setParameters(); sigma_.setParameters(); computeFactors();}
+
+  protected:
+    /** default constructor */
+    FullGaussianHandlerBase(int nbCluster): mean_(nbCluster), sigma_(nbCluster), chol_() {}
+    /** copy constructor */
+    FullGaussianHandlerBase(FullGaussianHandlerBase const& param)
+                           : mean_(param.mean_), sigma_(param.sigma_), chol_(param.chol_)
+    {}
+    /** destructor */
+    inline ~FullGaussianHandlerBase() {}
+    /** copy operator */
+    inline FullGaussianHandlerBase& operator=( FullGaussianHandlerBase const& other)
+    { mean_ = other.mean_; sigma_ = other.sigma_; chol_ = other.chol_; return *this;}
+    /** set the parameters using an array/expression storing the values
+     *  @param param the array of size (d+1)K by d with the parameters
+     **/
+    template<class Array>
+    void setParam( ExprBase<Array> const& param)
+    {
+      const int p = param.sizeCols();
+      if (mean_[mean_().begin()].range() != param.cols())
+      {
+        mean_.resize(param.cols());
+        sigma_.resize(param.cols(), param.cols());
+      }
+      for (int k= mean_().begin(), k2 = param.beginRows(); k < mean_().end(); ++k, k2+=p+1)
+      {
+        for (int j= param.beginCols();  j< param.endCols(); ++j)
+        {
+          mean_[k][j] = param(k2, j);
+          for (int i= param.beginCols(), i2 = k2+1;  i< param.endCols(); ++i, ++i2)
+          { sigma_[k](i, j) = param(i2, j);}
+        }
+      }
+      computeFactors();
+    }
+};
+
+/** @ingroup Clustering
+ *  Base class for the Gaussian models with full covariance matrices.
+ *
+ *  The covariance matrices are factorized once at the end of each M-step
+ *  using the BatchSymmetric class. The log-densities of all the samples are
+ *  then computed at once by blocks of rows, the Mahalanobis distances being
+ *  obtained by solving triangular systems with all the (centered) rows of a
+ *  block as right hand side. The values are cached and returned by
+ *  @c lnComponentProbability.
+ *
+ *  Derived classes have to call @c updateFactors() when the covariance
+ *  matrices are modified.
+ **/
+template<class Derived>
+class FullGaussianBase : public IMixtureModel<Derived >
+{
+  public:
+    typedef IMixtureModel<Derived > Base;
+    typedef typename Clust::MixtureTraits<Derived>::ParamHandler ParamHandler;
+    using Base::p_tik; using Base::param_;
+    using Base::p_data;
+
+  protected:
+    /** default constructor
+     * @param nbCluster number of cluster in the model
+     **/
+    inline FullGaussianBase( int nbCluster) : Base(nbCluster), lnComp_(), missing_() {}
+    /** copy constructor
+     *  @param model The model to copy
+     **/
+    inline FullGaussianBase( FullGaussianBase const& model)
+                           : Base(model), lnComp_(model.lnComp_), missing_(model.missing_)
+    {}
+    /** destructor */
+    inline ~FullGaussianBase() {}
+
+  public:
+    /** @return mean of the kth cluster and jth variable */
+    inline Real const& mean(int k, int j) const { return param_.meanImpl(k,j);}
+    /** @return covariance of the kth cluster between the variables i and j */
+    inline Real const& sigma(int k, int i, int j) const { return param_.sigmaImpl(k,i,j);}
+    /** @return the value of the probability of the i-th sample in the k-th component.
+     *  @param i,k indexes of the sample and of the component
+     **/
+    inline Real lnComponentProbability(int i, int k) const { return lnComp_(i,k);}
+    /** Initialize the parameters of the model. */
+    inline void initializeModelImpl()
+    {
+      param_.resize(p_data()->cols());
+      lnComp_.resize(p_data()->sizeRows(), this->nbCluster());
+      lnComp_.shift(p_data()->beginRows(), baseIdx);
+      computeLnComponentProbabilities();
+    }
+    /** Compute the Cholesky factors when the parameters are set using the
+     *  stored intermediate results.
+     **/
+    inline void setParametersImpl() { computeLnComponentProbabilities();}
+    /** set the parameter handler of the model */
+    inline void setParamHandler(ParamHandler const& param)
+    { param_ = param; computeLnComponentProbabilities();}
+    /** set the parameter handler using an array/expression storing the values */
+    template<class Array>
+    inline void setParamHandler(ExprBase<Array> const& param)
+    { param_ = param; computeLnComponentProbabilities();}
+    /** set the coordinates of the missing values of the data set. The
+     *  missing values are imputed and simulated using their conditional
+     *  distribution given the observed values of the sample.
+     *  @param v_missing the coordinates (i,j) of the missing values
+     **/
+    void setMissing(std::vector<std::pair<int,int> > const& v_missing);
+    /** @return the missing variables of each sample with missing values */
+    inline std::map<int, std::vector<int> > const& missing() const { return missing_;}
+    /** @return an imputation value for the jth variable of the ith sample,
+     *  i.e. the tik weighted conditional expectations of the components
+     *  @f$ \mu_m + \Sigma_{mo}\Sigma_{oo}^{-1}(x_o-\mu_o) @f$ given the
+     *  observed values @f$ x_o @f$ of the sample.
+     *  @param i,j indexes of the data to impute */
+    Real impute(int i, int j) const;
+    /** @return a simulated value for the jth variable of the ith sample
+     *  in the kth cluster, using the conditional distribution of the
+     *  variable given the observed values of the sample.
+     *  @param i,j,k indexes of the data to simulate */
+    Real rand(int i, int j, int k) const;
+    /** compute the imputation values of all the missing variables of the ith
+     *  sample.
+     *  @param i index of the sample
+     *  @param[out] values the values of the variables in @c missing()
+     **/
+    void imputeRow(int i, CVectorX& values) const;
+    /** simulate jointly all the missing variables of the ith sample: the
+     *  component is simulated using the tik and the values using the
+     *  conditional distribution given the observed values of the sample.
+     *  @param i index of the sample
+     *  @param[out] values the values of the variables in @c missing()
+     **/
+    void sampleRow(int i, CVectorX& values) const;
+    /** Compute the log-densities of all the samples in all the components
+     *  using the current Cholesky factors. This method has to be called
+     *  when the data set is modified.
+     **/
+    void computeLnComponentProbabilities();
+
+  protected:
+    /** cached log-densities of the samples in the components */
+    CArrayXX lnComp_;
+    /** missing variables of the samples with missing values */
+    std::map<int, std::vector<int> > missing_;
+    /** @return the mean of the kth cluster */
+    inline PointX& mean(int k) { return param_.mean_[k];}
+    /** @return the covariance matrix of the kth cluster */
+    inline ArrayXX& sigma(int k) { return param_.sigma_[k];}
+    /** sample randomly the mean of each component by sampling randomly a row
+     *  of the data set.
+     **/
+    void randomMean();
+    /** compute the weighted mean of a Gaussian mixture. */
+    bool updateMean();
+    /** compute the weighted scatter matrix of the kth cluster.
+     *  @param k index of the cluster
+     *  @param[out] w the scatter matrix @f$ \sum_i t_{ik}(x_i-\mu_k)(x_i-\mu_k)' @f$
+     *  with the ranges of the variables
+     *  @return the sum of the weights of the kth cluster
+     **/
+    Real scatter(int k, ArrayXX& w) const;
+    /** compute the Cholesky factors of the covariance matrices and the
+     *  log-densities of the samples.
+     *  @return @c false if a covariance matrix is not positive definite
+     **/
+    bool updateFactors()
+    {
+      if (!param_.computeFactors()) return false;
+      computeLnComponentProbabilities();
+      return true;
+    }
+
+  private:
+    /** @return the missing variables of the ith sample, or the variable j if
+     *  the sample have no registered missing values.
+     *  @param i,j indexes of the sample and of the variable
+     *  @param[out] pos position of j in the returned variables
+     **/
+    std::vector<int> missingCols(int i, int j, int& pos) const;
+    /** compute the conditional distribution of the variables @c miss of the
+     *  ith sample in the kth component, given its other variables. Using the
+     *  Cholesky factor L of the covariance matrix, the columns @c miss of the
+     *  precision matrix @f$ Q=L^{-T}L^{-1} @f$ are computed and the conditional
+     *  distribution is @f$ N(\mu_m - Q_{mm}^{-1}Q_{mo}(x_o-\mu_o), Q_{mm}^{-1}) @f$.
+     *  @param i,k indexes of the sample and of the component
+     *  @param miss the missing variables
+     *  @param[out] mu the conditional mean
+     *  @param[out] c the Cholesky factor of the conditional precision
+     *  matrix @f$ Q_{mm} @f$ (lower triangular)
+     *  @return @c false if the covariance matrix is not positive definite
+     **/
+    bool conditional( int i, int k, std::vector<int> const& miss
+                    , CVectorX& mu, CArrayXX& c) const;
+};
+
+template<class Derived>
+void FullGaussianBase<Derived>::setMissing(std::vector<std::pair<int,int> > const& v_missing)
+{
+  missing_.clear();
+  for (size_t m=0; m<v_missing.size(); ++m)
+  { missing_[v_missing[m].first].push_back(v_missing[m].second);}
+  for (std::map<int, std::vector<int> >::iterator it = missing_.begin(); it != missing_.end(); ++it)
+  { std::sort(it->second.begin(), it->second.end());}
+}
+
+template<class Derived>
+std::vector<int> FullGaussianBase<Derived>::missingCols(int i, int j, int& pos) const
+{
+  std::map<int, std::vector<int> >::const_iterator it = missing_.find(i);
+  if (it != missing_.end())
+  {
+    std::vector<int>::const_iterator itj = std::lower_bound(it->second.begin(), it->second.end(), j);
+    if (itj != it->second.end() && *itj == j)
+    {
+      pos = int(itj - it->second.begin());
+      return it->second;
+    }
+  }
+  pos = 0;
+  return std::vector<int>(1, j);
+}
+
+template<class Derived>
+bool FullGaussianBase<Derived>::conditional( int i, int k, std::vector<int> const& miss
+                                           , CVectorX& mu, CArrayXX& c) const
+{
+  if (param_.chol_.info()[k-p_tik()->beginCols()] != 0) return false;
+  const int p = p_data()->sizeCols(), q = int(miss.size());
+  const int firstCol = p_data()->beginCols();
+  Real const* l = param_.p_chol(k);
+  PointX const& muk = param_.mean_[k];
+  // columns miss of the precision matrix: solve L y = e_j and L' x = y
+  CArrayXX prec(p, q);
+  CVectorX y(p);
+  for (int a=0; a<q; ++a)
+  {
+    const int ja = miss[a] - firstCol;
+    for (int r=0; r<ja; ++r) { y[r] = 0.;}
+    y[ja] = 1./l[ja+ja*p];
+    for (int r=ja+1; r<p; ++r)
+    {
+      Real sum = 0.;
+      for (int s=ja; s<r; ++s) { sum += l[r+s*p]*y[s];}
+      y[r] = -sum/l[r+r*p];
+    }
+    for (int r=p-1; r>=0; --r)
+    {
+      Real sum = y[r];
+      for (int s=r+1; s<p; ++s) { sum -= l[s+r*p]*prec(s, a);}
+      prec(r, a) = sum/l[r+r*p];
+    }
+  }
+  // Q_mo (x_o - mu_o), the missing variables are removed from the sum
+  CVectorX res(q);
+  for (int a=0; a<q; ++a)
+  {
+    Real sum = 0.;
+    for (int r=0; r<p; ++r)
+    { sum += prec(r, a) * (p_data()->elt(i, firstCol+r) - muk[firstCol+r]);}
+    for (int b=0; b<q; ++b)
+    { sum -= prec(miss[b]-firstCol, a) * (p_data()->elt(i, miss[b]) - muk[miss[b]]);}
+    res[a] = sum;
+  }
+  // Cholesky factor of Q_mm
+  c.resize(q, q);
+  c = 0.;
+  for (int b=0; b<q; ++b)
+  {
+    Real d = prec(miss[b]-firstCol, b);
+    for (int s=0; s<b; ++s) { d -= c(b, s)*c(b, s);}
+    if (d <= 0.) return false;
+    c(b, b) = std::sqrt(d);
+    for (int a=b+1; a<q; ++a)
+    {
+      Real sum = prec(miss[a]-firstCol, b);
+      for (int s=0; s<b; ++s) { sum -= c(a, s)*c(b, s);}
+      c(a, b) = sum/c(b, b);
+    }
+  }
+  // mu_m - Q_mm^{-1} Q_mo (x_o - mu_o)
+  for (int a=0; a<q; ++a)
+  {
+    for (int s=0; s<a; ++s) { res[a] -= c(a, s)*res[s];}
+    res[a] /= c(a, a);
+  }
+  for (int a=q-1; a>=0; --a)
+  {
+    for (int s=a+1; s<q; ++s) { res[a] -= c(s, a)*res[s];}
+    res[a] /= c(a, a);
+  }
+  mu.resize(q);
+  for (int a=0; a<q; ++a) { mu[a] = muk[miss[a]] - res[a];}
+  return true;
+}
+
+template<class Derived>
+Real FullGaussianBase<Derived>::impute(int i, int j) const
+{
+  int pos;
+  std::vector<int> miss = missingCols(i, j, pos);
+  CVectorX mu;
+  CArrayXX c;
+  Real sum = 0.;
+  for (int k= p_tik()->beginCols(); k < p_tik()->endCols(); ++k)
+  { sum += p_tik()->elt(i,k) * (conditional(i, k, miss, mu, c) ? mu[pos] : mean(k,j));}
+  return sum;
+}
+
+template<class Derived>
+Real FullGaussianBase<Derived>::rand(int i, int j, int k) const
+{
+  int pos;
+  std::vector<int> miss = missingCols(i, j, pos);
+  CVectorX mu;
+  CArrayXX c;
+  if (!conditional(i, k, miss, mu, c))
+  { return Law::Normal::rand(mean(k, j), std::sqrt(sigma(k,j,j)));}
+  // variance of the variable: squared norm of the column pos of c^{-1}
+  const int q = int(miss.size());
+  CVectorX w(q);
+  Real var = 0.;
+  for (int a=0; a<q; ++a)
+  {
+    Real sum = (a == pos) ? 1. : 0.;
+    for (int s=pos; s<a; ++s) { sum -= c(a, s)*w[s];}
+    w[a] = (a < pos) ? 0. : sum/c(a, a);
+    var += w[a]*w[a];
+  }
+  return Law::Normal::rand(mu[pos], std::sqrt(var));
+}
+
+template<class Derived>
+void FullGaussianBase<Derived>::imputeRow(int i, CVectorX& values) const
+{
+  std::map<int, std::vector<int> >::const_iterator it = missing_.find(i);
+  if (it == missing_.end()) { values.resize(0); return;}
+  std::vector<int> const& miss = it->second;
+  const int q = int(miss.size());
+  CVectorX mu;
+  CArrayXX c;
+  values.resize(q);
+  values = 0.;
+  for (int k= p_tik()->beginCols(); k < p_tik()->endCols(); ++k)
+  {
+    Real const tik = p_tik()->elt(i,k);
+    if (conditional(i, k, miss, mu, c))
+    { for (int a=0; a<q; ++a) { values[a] += tik * mu[a];}}
+    else
+    { for (int a=0; a<q; ++a) { values[a] += tik * mean(k, miss[a]);}}
+  }
+}
+
+template<class Derived>
+void FullGaussianBase<Derived>::sampleRow(int i, CVectorX& values) const
+{
+  std::map<int, std::vector<int> >::const_iterator it = missing_.find(i);
+  if (it == missing_.end()) { values.resize(0); return;}
+  std::vector<int> const& miss = it->second;
+  const int q = int(miss.size());
+  const int k = Law::Categorical::rand(p_tik()->row(i));
+  CVectorX mu;
+  CArrayXX c;
+  values.resize(q);
+  if (!conditional(i, k, miss, mu, c))
+  {
+    for (int a=0; a<q; ++a)
+    { values[a] = Law::Normal::rand(mean(k, miss[a]), std::sqrt(sigma(k, miss[a], miss[a])));}
+    return;
+  }
+  // x_m = mu + c^{-T} z has the covariance Q_mm^{-1}
+  for (int a=0; a<q; ++a) { values[a] = Law::Normal::rand(0., 1.);}
+  for (int a=q-1; a>=0; --a)
+  {
+    for (int s=a+1; s<q; ++s) { values[a] -= c(s, a)*values[s];}
+    values[a] /= c(a, a);
+  }
+  for (int a=0; a<q; ++a) { values[a] += mu[a];}
+}
+
+template<class Derived>
+void FullGaussianBase<Derived>::randomMean()
+{
+  // indexes array
+  VectorXi indexes(p_data()->rows());
+  for(int i=p_data()->beginRows(); i< p_data()->endRows(); ++i) { indexes[i] = i;}
+  Range rind = p_data()->rows();
+  // sample without repetition
+  for (int k= p_tik()->beginCols(); k < p_tik()->endCols(); ++k)
+  {
+    // random number in [0, end-k[
+    int i = (int)Law::Uniform::rand(rind.begin(), rind.end());
+    // get ith individuals
+    mean(k).copy(p_data()->row(indexes[i]));
+    // exchange it with nth
+    indexes.swap(i, rind.lastIdx());
+    // decrease
+    rind.decLast(1);
+  }
+}
+
+template<class Derived>
+bool FullGaussianBase<Derived>::updateMean()
+{
+  for (int k= p_tik()->beginCols(); k < p_tik()->endCols(); ++k)
+  {
+    for (int j=p_data()->beginCols(); j< p_data()->endCols(); ++j)
+    { mean(k)[j] = p_data()->col(j).wmean(p_tik()->col(k));}
+  }
+  return true;
+}
+
+template<class Derived>
+Real FullGaussianBase<Derived>::scatter(int k, ArrayXX& w) const
+{
+  const int n = p_data()->sizeRows(), p = p_data()->sizeCols();
+  const int firstRow = p_data()->beginRows(), firstCol = p_data()->beginCols();
+  PointX const& mu = param_.mean_[k];
+  // centered and weighted centered data
+  CArrayXX xc(n, p), wxc(n, p);
+  Real nk = 0.;
+  for (int i=0; i<n; ++i) { nk += p_tik()->elt(firstRow+i, k);}
+  for (int j=0; j<p; ++j)
+  {
+    for (int i=0; i<n; ++i)
+    {
+      xc(i,j)  = p_data()->elt(firstRow+i, firstCol+j) - mu[firstCol+j];
+      wxc(i,j) = p_tik()->elt(firstRow+i, k) * xc(i,j);
+    }
+  }
+  CArrayXX s = xc.transpose() * wxc;
+  w.resize(p_data()->cols(), p_data()->cols());
+  for (int j=0; j<p; ++j)
+  {
+    for (int i=0; i<j; ++i)
+    { w(firstCol+i, firstCol+j) = w(firstCol+j, firstCol+i) = 0.5*(s(i,j)+s(j,i));}
+    w(firstCol+j, firstCol+j) = s(j,j);
+  }
+  return nk;
+}
+
+template<class Derived>
+void FullGaussianBase<Derived>::computeLnComponentProbabilities()
+{
+  const int n = p_data()->sizeRows(), p = p_data()->sizeCols();
+  const int firstRow = p_data()->beginRows(), firstCol = p_data()->beginCols();
+  const int nbCluster = this->nbCluster(), blockSize = 256;
+  const int nbBlock = (n + blockSize - 1)/blockSize;
+  int b;
+#ifdef _OPENMP
+#pragma omp parallel for if (n*p*nbCluster > ParallelThreshold)
+#endif
+  for (b = 0; b < nbBlock; ++b)
+  {
+    const int first = b*blockSize, size = std::min(blockSize, n - first);
+    CArrayXX y(size, p);
+    Real* py = y.p_data();
+    for (int k= lnComp_.beginCols(); k < lnComp_.endCols(); ++k)
+    {
+      if (param_.chol_.info()[k-lnComp_.beginCols()] != 0)
+      {
+        for (int i=0; i<size; ++i) { lnComp_(firstRow+first+i, k) = -Arithmetic<Real>::infinity();}
+        continue;
+      }
+      Real const* l = param_.p_chol(k);
+      PointX const& mu = param_.mean_[k];
+      // solve Y L' = X - mu using forward substitution on the columns
+      for (int j=0; j<p; ++j)
+      {
+        Real* yj = py + j*size;
+        for (int i=0; i<size; ++i)
+        { yj[i] = p_data()->elt(firstRow+first+i, firstCol+j) - mu[firstCol+j];}
+        for (int m=0; m<j; ++m)
+        {
+          Real const ljm = l[j+m*p];
+          Real const* ym = py + m*size;
+          for (int i=0; i<size; ++i) { yj[i] -= ljm*ym[i];}
+        }
+        Real const ljj = l[j+j*p];
+        for (int i=0; i<size; ++i) { yj[i] /= ljj;}
+      }
+      // sum of the squared values by rows
+      Real const c = -p*Const::_LNSQRT2PI_ - 0.5*param_.logDet(k);
+      for (int i=0; i<size; ++i)
+      {
+        Real quad = 0.;
+        for (int j=0; j<p; ++j) { quad += py[i+j*size]*py[i+j*size];}
+        lnComp_(firstRow+first+i, k) = c - 0.5*quad;
+      }
+    }
+  }
+}
+
+} // namespace STK
+
+#endif /* STK_FULLGAUSSIANBASE_H */
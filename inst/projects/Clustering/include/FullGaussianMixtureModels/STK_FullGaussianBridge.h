@@ -0,0 +1,332 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015 Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._DOT_I..._AT_stkpp.org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Clustering
+ * Purpose:  Bridge classes between the Gaussian mixtures with full
+ *           covariance matrices and the composer.
+ * Author:   Serge Iovleff
+ **/
+
+/** @file STK_FullGaussianBridge.h
+ *  @brief In this file we define the bridge classes between the Gaussian
+ *  mixtures with full covariance matrices and the composer.
+ **/
+
+#ifndef STK_FULLGAUSSIANBRIDGE_H
+#define STK_FULLGAUSSIANBRIDGE_H
+
+#include "STK_Gaussian_Lk_Ck.h"
+#include "STK_Gaussian_L_C.h"
+#include "STK_Gaussian_Lk_C.h"
+#include "STK_Gaussian_Lk_Dk_A_Dk.h"
+
+#include "../STK_MixtureData.h"
+#include "../STK_IMixtureBridge.h"
+
+namespace STK
+{
+
+// forward declaration
+template<int Id, class Data> class FullGaussianBridge;
+
+namespace hidden
+{
+/** @ingroup hidden
+ *  Partial specialization of the MixtureBridgeTraits for the Gaussian_Lk_Ck model
+ **/
+template<class Data_>
+struct MixtureBridgeTraits< FullGaussianBridge< Clust::Gaussian_Lk_Ck_, Data_> >
+{
+  typedef Data_ Data;
+  /** Type of the mixture model */
+  typedef Gaussian_Lk_Ck<Data> Mixture;
+  /** Type of the parameter handler */
+  typedef ParametersHandler<Clust::Gaussian_Lk_Ck_> ParamHandler;
+  /** Structure storing Parameters */
+  typedef ArrayXX Parameters;
+  enum
+  {
+    idMixtureClass_ = Clust::Gaussian_
+  };
+};
+/** @ingroup hidden
+ *  Partial specialization of the MixtureBridgeTraits for the Gaussian_L_C model
+ **/
+template<class Data_>
+struct MixtureBridgeTraits< FullGaussianBridge< Clust::Gaussian_L_C_, Data_> >
+{
+  typedef Data_ Data;
+  /** Type of the mixture model */
+  typedef Gaussian_L_C<Data> Mixture;
+  /** Type of the parameter handler */
+  typedef ParametersHandler<Clust::Gaussian_L_C_> ParamHandler;
+  /** Structure storing Parameters */
+  typedef ArrayXX Parameters;
+  enum
+  {
+    idMixtureClass_ = Clust::Gaussian_
+  };
+};
+/** @ingroup hidden
+ *  Partial specialization of the MixtureBridgeTraits for the Gaussian_Lk_C model
+ **/
+template<class Data_>
+struct MixtureBridgeTraits< FullGaussianBridge< Clust::Gaussian_Lk_C_, Data_> >
+{
+  typedef Data_ Data;
+  /** Type of the mixture model */
+  typedef Gaussian_Lk_C<Data> Mixture;
+  /** Type of the parameter handler */
+  typedef ParametersHandler<Clust::Gaussian_Lk_C_> ParamHandler;
+  /** Structure storing Parameters */
+  typedef ArrayXX Parameters;
+  enum
+  {
+    idMixtureClass_ = Clust::Gaussian_
+  };
+};
+/** @ingroup hidden
+ *  Partial specialization of the MixtureBridgeTraits for the Gaussian_Lk_Dk_A_Dk model
+ **/
+template<class Data_>
+struct MixtureBridgeTraits< FullGaussianBridge< Clust::Gaussian_Lk_Dk_A_Dk_, Data_> >
+{
+  typedef Data_ Data;
+  /** Type of the mixture model */
+  typedef Gaussian_Lk_Dk_A_Dk<Data> Mixture;
+  /** Type of the parameter handler */
+  typedef ParametersHandler<Clust::Gaussian_Lk_Dk_A_Dk_> ParamHandler;
+  /** Structure storing Parameters */
+  typedef ArrayXX Parameters;
+  enum
+  {
+    idMixtureClass_ = Clust::Gaussian_
+  };
+};
+
+} // namespace hidden
+
+} // namespace STK
+
+namespace STK
+{
+/** @ingroup Clustering
+ *  @brief Templated implementation of the IMixture interface allowing
+ *  to bridge a STK++ mixture with the composer.
+ *
+ *  This class inherit from the interface IMixture and delegate almost
+ *  all the treatments to the wrapped class.
+ *
+ * @tparam Id is any identifier of a concrete model deriving from the
+ * interface STK::IMixtureModel class.
+ */
+template<int Id, class Data>
+class FullGaussianBridge: public IMixtureBridge< FullGaussianBridge<Id,Data> >
+{
+  public:
+    // Base class
+    typedef IMixtureBridge< FullGaussianBridge<Id,Data> > Base;
+    // type of Mixture
+    typedef typename hidden::MixtureBridgeTraits< FullGaussianBridge<Id,Data> >::Mixture Mixture;
+    typedef typename hidden::MixtureBridgeTraits< FullGaussianBridge<Id,Data> >::ParamHandler ParamHandler;
+    typedef typename hidden::MixtureBridgeTraits< FullGaussianBridge<Id,Data> >::Parameters Parameters;
+    // type of data
+    typedef typename Data::Type Type;
+    // class of mixture
+    enum
+    {
+      idMixtureClass_ = Clust::Gaussian_
+    };
+    typedef std::vector<std::pair<int,int> >::const_iterator ConstIterator;
+    using Base::mixture_;
+    using Base::p_data_;
+    using Base::p_tik;
+
+    /** default constructor. Remove the missing values from the data set and
+     *  initialize the mixture by setting the data set.
+     *  @param p_data pointer on the MixtureData that will be used by the bridge.
+     *  @param idData id name of the mixture model
+     *  @param nbCluster number of cluster
+     **/
+    FullGaussianBridge( MixtureData<Data>* p_data, std::string const& idData, int nbCluster)
+                      : Base( p_data, idData, nbCluster)
+    { removeMissing(); initializeMixture();}
+    /** copy constructor */
+    FullGaussianBridge( FullGaussianBridge const& bridge): Base(bridge)
+    { initializeMixture();}
+    /** destructor */
+    virtual ~FullGaussianBridge() {}
+    /** This is a standard clone function in usual sense. It must be defined to
+     *  provide new object of your class with values of various parameters
+     *  equal to the values of calling object. In other words, this is
+     *  equivalent to polymorphic copy constructor.
+     *  @return New instance of class as that of calling object.
+     */
+    virtual FullGaussianBridge* clone() const { return new FullGaussianBridge(*this);}
+    /** This is a standard create function in usual sense. It must be defined to
+     *  provide new object of your class with correct dimensions and state.
+     *  In other words, this is equivalent to virtual constructor.
+     *  @return New instance of class as that of calling object.
+     */
+    virtual FullGaussianBridge* create() const
+    {
+      FullGaussianBridge* p_bridge = new FullGaussianBridge( mixture_, this->idName(), this->nbCluster());
+      p_bridge->p_data_ = p_data_;
+      // Bug Fix: set the correct data set
+      p_bridge->mixture_.setData(p_bridge->p_data_->dataij());
+      return p_bridge;
+    }
+    /** This function is used in order to get the current values of the
+     *  parameters in an array.
+     *  @param[out] params the array with the parameters of the mixture.
+     */
+    void getParameters(Parameters& params) const;
+    /** Write the parameters on the output stream os */
+    void writeParameters(ostream& os) const;
+    /** Impute the missing values of each sample by their conditional
+     *  expectation given the observed values and update the log-densities
+     *  of the samples.
+     **/
+    virtual void imputationStep();
+    /** Simulate jointly the missing values of each sample given the observed
+     *  values and update the log-densities of the samples.
+     **/
+    virtual void samplingStep();
+
+  private:
+    /** This function will be used for the imputation of the missing data
+     *  at the initialization.
+     **/
+    void removeMissing();
+    /** This function will be used in order to initialize the mixture model
+     *  using informations stored by the MixtureData. For example the missing
+     *  values in the case of a MixtureData instance.
+     **/
+    void initializeMixture()
+    {
+      mixture_.setMissing(p_data_->v_missing());
+      mixture_.setData(p_data_->dataij());
+    }
+    /** protected constructor to use in order to create a bridge.
+     *  @param mixture the mixture to copy
+     *  @param idData id name of the mixture
+     *  @param nbCluster number of cluster
+     **/
+    FullGaussianBridge( Mixture const& mixture, std::string const& idData, int nbCluster)
+                      : Base(mixture, idData, nbCluster)
+    {}
+};
+
+// implementation
+template<int Id, class Data>
+void FullGaussianBridge<Id, Data>::removeMissing()
+{
+  Type value = Type();
+  int j, old_j = Arithmetic<int>::NA();
+  for(ConstIterator it = p_data_->v_missing().begin(); it!= p_data_->v_missing().end(); ++it)
+  {
+    j = it->second; // get column
+    if (j != old_j)
+    {
+      old_j = j;
+      value =  p_data_->dataij_.col(j).safe().mean();
+    }
+    p_data_->dataij_(it->first, j) = value;
+  }
+}
+
+template<int Id, class Data>
+void FullGaussianBridge<Id, Data>::imputationStep()
+{
+  if (p_data_->v_missing().empty()) return;
+  CVectorX values;
+  // the values of a sample are computed before being modified
+  for ( std::map<int, std::vector<int> >::const_iterator it = mixture_.missing().begin()
+      ; it != mixture_.missing().end(); ++it)
+  {
+    mixture_.imputeRow(it->first, values);
+    for (size_t m=0; m<it->second.size(); ++m)
+    { p_data_->dataij_(it->first, it->second[m]) = values[int(m)];}
+  }
+  mixture_.computeLnComponentProbabilities();
+}
+
+template<int Id, class Data>
+void FullGaussianBridge<Id, Data>::samplingStep()
+{
+  if (p_data_->v_missing().empty()) return;
+  CVectorX values;
+  for ( std::map<int, std::vector<int> >::const_iterator it = mixture_.missing().begin()
+      ; it != mixture_.missing().end(); ++it)
+  {
+    mixture_.sampleRow(it->first, values);
+    for (size_t m=0; m<it->second.size(); ++m)
+    { p_data_->dataij_(it->first, it->second[m]) = values[int(m)];}
+  }
+  mixture_.computeLnComponentProbabilities();
+}
+
+template<int Id, class Data>
+void FullGaussianBridge<Id, Data>::getParameters(Parameters& params) const
+{
+  int nbClust = this->nbCluster();
+  Range cols = mixture_.p_data()->cols();
+  int p = cols.size();
+  params.resize((p+1)*nbClust, cols);
+  for (int k= 0; k < nbClust; ++k)
+  {
+    for (int j= cols.begin();  j< cols.end(); ++j)
+    {
+      params(baseIdx+(p+1)*k, j) = mixture_.mean(baseIdx + k, j);
+      for (int i= cols.begin(), i2= baseIdx+(p+1)*k+1;  i< cols.end(); ++i, ++i2)
+      { params(i2, j) = mixture_.sigma(baseIdx + k, i, j);}
+    }
+  }
+}
+
+/** Write the parameters on the output stream os */
+template<int Id, class Data>
+void FullGaussianBridge<Id, Data>::writeParameters(ostream& os) const
+{
+  Range cols = mixture_.p_data()->cols();
+  PointX m(cols);
+  ArrayXX s(cols, cols);
+  for (int k= p_tik()->beginCols(); k < p_tik()->endCols(); ++k)
+  {
+    // store the values in arrays for a nice output
+    for (int j= cols.begin();  j < cols.end(); ++j)
+    {
+      m[j] = mixture_.mean(k,j);
+      for (int i= cols.begin();  i < cols.end(); ++i) { s(i,j) = mixture_.sigma(k,i,j);}
+    }
+    os << _T("---> Component ") << k << _T("\n");
+    os << _T("mean = ") << m;
+    os << _T("sigma = \n")<< s;
+  }
+}
+
+} // namespace STK
+
+#endif /* STK_FULLGAUSSIANBRIDGE_H */
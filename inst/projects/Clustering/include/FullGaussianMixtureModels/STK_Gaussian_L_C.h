@@ -0,0 +1,170 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015 Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._DOT_I..._AT_stkpp.org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Clustering
+ * Purpose:  Implementation of the Gaussian_L_C model.
+ * Author:   Serge Iovleff
+ **/
+
+/** @file STK_Gaussian_L_C.h
+ *  @brief In this file we implement the Gaussian_L_C class
+ **/
+
+#ifndef STK_GAUSSIAN_L_C_H
+#define STK_GAUSSIAN_L_C_H
+
+#include "STK_FullGaussianBase.h"
+
+namespace STK
+{
+
+//forward declaration, to allow for recursive template
+template<class Array>class Gaussian_L_C;
+
+namespace Clust
+{
+/** @ingroup Clustering
+ *  Traits class for the Gaussian_L_C traits policy. */
+template<class _Array>
+struct MixtureTraits< Gaussian_L_C<_Array> >
+{
+  typedef _Array Array;
+  typedef ParametersHandler<Clust::Gaussian_L_C_> ParamHandler;
+};
+
+} // namespace Clust
+
+/** Specialization of the ParametersHandler struct for Gaussian_L_C model */
+template <>
+struct ParametersHandler<Clust::Gaussian_L_C_>: public FullGaussianHandlerBase< ParametersHandler<Clust::Gaussian_L_C_> >
+{
+  typedef FullGaussianHandlerBase< ParametersHandler<Clust::Gaussian_L_C_> > Base;
+  /** default constructor */
+  ParametersHandler(int nbCluster): Base(nbCluster) {}
+  /** copy constructor */
+  ParametersHandler(ParametersHandler const& model): Base(model) {}
+  /** Initialize the parameters with an array/expression of value */
+  template<class Array>
+  inline ParametersHandler( int nbCluster, ExprBase<Array> const& param): Base(nbCluster)
+  { this->setParam(param);}
+  /** destructor */
+  inline ~ParametersHandler() {}
+  /** copy operator */
+  inline ParametersHandler& operator=( ParametersHandler const& other)
+  { Base::operator=(other); return *this;}
+  /** copy operator using an array/expression storing the values */
+  template<class Array>
+  inline ParametersHandler& operator=( ExprBase<Array> const& param)
+  { this->setParam(param); return *this;}
+};
+
+/** @ingroup Clustering
+ *  The Gaussian mixture model @c Gaussian_L_C has the same covariance matrix
+ *  for all the components. Its density function is of the form
+ * \f[
+ *  f(\mathbf{x}|\theta) = \sum_{k=1}^K p_k
+ *    \frac{1}{(2\pi)^{d/2}|\Sigma|^{1/2}}
+ *    \exp\left\{-\frac{1}{2}(\mathbf{x}-\mu_k)'\Sigma^{-1}(\mathbf{x}-\mu_k)\right\}.
+ * \f]
+ **/
+template<class Array>
+class Gaussian_L_C : public FullGaussianBase<Gaussian_L_C<Array> >
+{
+  public:
+    typedef FullGaussianBase<Gaussian_L_C<Array> > Base;
+    using Base::p_tik;
+    using Base::param_;
+    using Base::p_data;
+
+    /** default constructor
+     * @param nbCluster number of cluster in the model
+     **/
+    Gaussian_L_C( int nbCluster) : Base(nbCluster) {}
+    /** copy constructor
+     *  @param model The model to copy
+     **/
+    Gaussian_L_C( Gaussian_L_C const& model) : Base(model) {}
+    /** destructor */
+    ~Gaussian_L_C() {}
+    /** Initialize randomly the parameters of the Gaussian mixture. The centers
+     *  will be selected randomly among the data set and the covariance
+     *  matrices will be estimated using the current posterior probabilities.
+     */
+    void randomInit();
+    /** Compute the weighted means and the common covariance matrix. */
+    bool mStep();
+    /** @return the number of free parameters of the model */
+    inline int computeNbFreeParameters() const
+    {
+      const int p = this->nbVariable();
+      return this->nbCluster()*p + (p*(p+1))/2;
+    }
+  private:
+    /** compute the common covariance matrix */
+    void updateSigma();
+};
+
+/* Initialize randomly the parameters of the Gaussian mixture. */
+template<class Array>
+void Gaussian_L_C<Array>::randomInit()
+{
+  this->randomMean();
+  updateSigma();
+  if (!this->updateFactors()) throw Clust::randomParamInitFail_;
+#ifdef STK_MIXTURE_VERY_VERBOSE
+  stk_cout << _T("Gaussian_L_C<Array>::randomInit() done\n");
+#endif
+}
+
+/* Compute the weighted means and the weighted covariance matrices. */
+template<class Array>
+bool Gaussian_L_C<Array>::mStep()
+{
+  // compute the means
+  if (!this->updateMean()) return false;
+  updateSigma();
+  return this->updateFactors();
+}
+
+template<class Array>
+void Gaussian_L_C<Array>::updateSigma()
+{
+  const int first = p_tik()->beginCols();
+  ArrayXX w;
+  Real n = 0.;
+  param_.sigma_[first] = 0.;
+  for (int k= first; k < p_tik()->endCols(); ++k)
+  {
+    n += this->scatter(k, w);
+    param_.sigma_[first] += w;
+  }
+  if (n > 0.) { param_.sigma_[first] /= n;}
+  for (int k= first+1; k < p_tik()->endCols(); ++k)
+  { param_.sigma_[k] = param_.sigma_[first];}
+}
+
+} // namespace STK
+
+#endif /* STK_GAUSSIAN_L_C_H */
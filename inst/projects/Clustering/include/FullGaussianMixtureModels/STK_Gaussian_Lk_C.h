@@ -0,0 +1,206 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015 Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._DOT_I..._AT_stkpp.org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Clustering
+ * Purpose:  Implementation of the Gaussian_Lk_C model.
+ * Author:   Serge Iovleff
+ **/
+
+/** @file STK_Gaussian_Lk_C.h
+ *  @brief In this file we implement the Gaussian_Lk_C class
+ **/
+
+#ifndef STK_GAUSSIAN_LK_C_H
+#define STK_GAUSSIAN_LK_C_H
+
+#include "STK_FullGaussianBase.h"
+
+namespace STK
+{
+
+//forward declaration, to allow for recursive template
+template<class Array>class Gaussian_Lk_C;
+
+namespace Clust
+{
+/** @ingroup Clustering
+ *  Traits class for the Gaussian_Lk_C traits policy. */
+template<class _Array>
+struct MixtureTraits< Gaussian_Lk_C<_Array> >
+{
+  typedef _Array Array;
+  typedef ParametersHandler<Clust::Gaussian_Lk_C_> ParamHandler;
+};
+
+} // namespace Clust
+
+/** Specialization of the ParametersHandler struct for Gaussian_Lk_C model */
+template <>
+struct ParametersHandler<Clust::Gaussian_Lk_C_>: public FullGaussianHandlerBase< ParametersHandler<Clust::Gaussian_Lk_C_> >
+{
+  typedef FullGaussianHandlerBase< ParametersHandler<Clust::Gaussian_Lk_C_> > Base;
+  /** default constructor */
+  ParametersHandler(int nbCluster): Base(nbCluster) {}
+  /** copy constructor */
+  ParametersHandler(ParametersHandler const& model): Base(model) {}
+  /** Initialize the parameters with an array/expression of value */
+  template<class Array>
+  inline ParametersHandler( int nbCluster, ExprBase<Array> const& param): Base(nbCluster)
+  { this->setParam(param);}
+  /** destructor */
+  inline ~ParametersHandler() {}
+  /** copy operator */
+  inline ParametersHandler& operator=( ParametersHandler const& other)
+  { Base::operator=(other); return *this;}
+  /** copy operator using an array/expression storing the values */
+  template<class Array>
+  inline ParametersHandler& operator=( ExprBase<Array> const& param)
+  { this->setParam(param); return *this;}
+};
+
+/** @ingroup Clustering
+ *  The Gaussian mixture model @c Gaussian_Lk_C has proportional covariance
+ *  matrices @f$ \Sigma_k = \lambda_k C @f$ with @f$ |C| = 1 @f$. Its density
+ *  function is of the form
+ * \f[
+ *  f(\mathbf{x}|\theta) = \sum_{k=1}^K p_k
+ *    \frac{1}{(2\pi\lambda_k)^{d/2}}
+ *    \exp\left\{-\frac{1}{2\lambda_k}(\mathbf{x}-\mu_k)'C^{-1}(\mathbf{x}-\mu_k)\right\}.
+ * \f]
+ *  The volumes @f$ \lambda_k @f$ and the matrix C are estimated using the
+ *  fixed point algorithm of Celeux and Govaert (1995).
+ **/
+template<class Array>
+class Gaussian_Lk_C : public FullGaussianBase<Gaussian_Lk_C<Array> >
+{
+  public:
+    typedef FullGaussianBase<Gaussian_Lk_C<Array> > Base;
+    using Base::p_tik;
+    using Base::param_;
+    using Base::p_data;
+
+    /** default constructor
+     * @param nbCluster number of cluster in the model
+     **/
+    Gaussian_Lk_C( int nbCluster) : Base(nbCluster) {}
+    /** copy constructor
+     *  @param model The model to copy
+     **/
+    Gaussian_Lk_C( Gaussian_Lk_C const& model) : Base(model) {}
+    /** destructor */
+    ~Gaussian_Lk_C() {}
+    /** Initialize randomly the parameters of the Gaussian mixture. The centers
+     *  will be selected randomly among the data set and the covariance
+     *  matrices will be estimated using the current posterior probabilities.
+     */
+    void randomInit();
+    /** Compute the weighted means, the volumes and the common shape matrix. */
+    bool mStep();
+    /** @return the number of free parameters of the model */
+    inline int computeNbFreeParameters() const
+    {
+      const int p = this->nbVariable();
+      return this->nbCluster()*(p+1) + (p*(p+1))/2 - 1;
+    }
+  private:
+    /** compute the covariance matrices
+     *  @return @c false if the scatter matrices are degenerated
+     **/
+    bool updateSigma();
+};
+
+/* Initialize randomly the parameters of the Gaussian mixture. */
+template<class Array>
+void Gaussian_Lk_C<Array>::randomInit()
+{
+  this->randomMean();
+  if (!updateSigma() || !this->updateFactors()) throw Clust::randomParamInitFail_;
+#ifdef STK_MIXTURE_VERY_VERBOSE
+  stk_cout << _T("Gaussian_Lk_C<Array>::randomInit() done\n");
+#endif
+}
+
+/* Compute the weighted means and the weighted covariance matrices. */
+template<class Array>
+bool Gaussian_Lk_C<Array>::mStep()
+{
+  // compute the means
+  if (!this->updateMean()) return false;
+  if (!updateSigma()) return false;
+  return this->updateFactors();
+}
+
+template<class Array>
+bool Gaussian_Lk_C<Array>::updateSigma()
+{
+  const int p = this->nbVariable(), first = p_tik()->beginCols();
+  Range cols = p_data()->cols();
+  Array1D<ArrayXX> w(p_tik()->cols());
+  CPointX nk(p_tik()->cols()), lambda(p_tik()->cols());
+  ArrayXX c(cols, cols, 0.), cinv(cols, cols);
+  Real n = 0.;
+  for (int k= first; k < p_tik()->endCols(); ++k)
+  {
+    nk[k] = this->scatter(k, w[k]);
+    if (!(nk[k] > 0.)) return false;
+    c += w[k];
+    n += nk[k];
+  }
+  c /= n;
+  BatchSymmetric batch(1, p);
+  for (int iter = 0; iter < 100; ++iter)
+  {
+    // update the shape matrix using the current volumes
+    if (iter > 0)
+    {
+      c = 0.;
+      for (int k= first; k < p_tik()->endCols(); ++k) { c += w[k]/lambda[k];}
+    }
+    // normalize C and compute its inverse
+    batch.setMatrix(0, c);
+    if (!batch.inverse()) return false;
+    c /= std::exp(batch.logDet()[0]/p);
+    batch.getMatrix(0, cinv);
+    cinv *= std::exp(batch.logDet()[0]/p);
+    // update the volumes
+    Real delta = 0.;
+    for (int k= first; k < p_tik()->endCols(); ++k)
+    {
+      Real lk = w[k].prod(cinv).sum()/(p*nk[k]);
+      if (!(lk > 0.)) return false;
+      if (iter > 0) { delta = std::max(delta, std::abs(lk - lambda[k])/lk);}
+      lambda[k] = lk;
+    }
+    // stop when the volumes are stable, C is normalized and consistent with them
+    if (iter > 0 && delta < 1e-10) break;
+  }
+  for (int k= first; k < p_tik()->endCols(); ++k)
+  { param_.sigma_[k] = c * lambda[k];}
+  return true;
+}
+
+} // namespace STK
+
+#endif /* STK_GAUSSIAN_LK_C_H */
@@ -0,0 +1,221 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015 Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._DOT_I..._AT_stkpp.org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Clustering
+ * Purpose:  Implementation of the Gaussian_Lk_Dk_A_Dk model.
+ * Author:   Serge Iovleff
+ **/
+
+/** @file STK_Gaussian_Lk_Dk_A_Dk.h
+ *  @brief In this file we implement the Gaussian_Lk_Dk_A_Dk class
+ **/
+
+#ifndef STK_GAUSSIAN_LK_DK_A_DK_H
+#define STK_GAUSSIAN_LK_DK_A_DK_H
+
+#include "STK_FullGaussianBase.h"
+
+namespace STK
+{
+
+//forward declaration, to allow for recursive template
+template<class Array>class Gaussian_Lk_Dk_A_Dk;
+
+namespace Clust
+{
+/** @ingroup Clustering
+ *  Traits class for the Gaussian_Lk_Dk_A_Dk traits policy. */
+template<class _Array>
+struct MixtureTraits< Gaussian_Lk_Dk_A_Dk<_Array> >
+{
+  typedef _Array Array;
+  typedef ParametersHandler<Clust::Gaussian_Lk_Dk_A_Dk_> ParamHandler;
+};
+
+} // namespace Clust
+
+/** Specialization of the ParametersHandler struct for Gaussian_Lk_Dk_A_Dk model */
+template <>
+struct ParametersHandler<Clust::Gaussian_Lk_Dk_A_Dk_>: public FullGaussianHandlerBase< ParametersHandler<Clust::Gaussian_Lk_Dk_A_Dk_> >
+{
+  typedef FullGaussianHandlerBase< ParametersHandler<Clust::Gaussian_Lk_Dk_A_Dk_> > Base;
+  /** default constructor */
+  ParametersHandler(int nbCluster): Base(nbCluster) {}
+  /** copy constructor */
+  ParametersHandler(ParametersHandler const& model): Base(model) {}
+  /** Initialize the parameters with an array/expression of value */
+  template<class Array>
+  inline ParametersHandler( int nbCluster, ExprBase<Array> const& param): Base(nbCluster)
+  { this->setParam(param);}
+  /** destructor */
+  inline ~ParametersHandler() {}
+  /** copy operator */
+  inline ParametersHandler& operator=( ParametersHandler const& other)
+  { Base::operator=(other); return *this;}
+  /** copy operator using an array/expression storing the values */
+  template<class Array>
+  inline ParametersHandler& operator=( ExprBase<Array> const& param)
+  { this->setParam(param); return *this;}
+};
+
+/** @ingroup Clustering
+ *  The Gaussian mixture model @c Gaussian_Lk_Dk_A_Dk has covariance
+ *  matrices with a common shape given by their eigenvalues decomposition
+ *  @f$ \Sigma_k = \lambda_k D_k A D_k' @f$, where @f$ D_k @f$ are orthogonal
+ *  matrices and @f$ A @f$ is a diagonal matrix with @f$ |A| = 1 @f$. Its
+ *  density function is of the form
+ * \f[
+ *  f(\mathbf{x}|\theta) = \sum_{k=1}^K p_k
+ *    \frac{1}{(2\pi\lambda_k)^{d/2}}
+ *    \exp\left\{-\frac{1}{2\lambda_k}(\mathbf{x}-\mu_k)'D_kA^{-1}D_k'(\mathbf{x}-\mu_k)\right\}.
+ * \f]
+ *  The orientations @f$ D_k @f$ are the eigenvectors of the scatter matrices
+ *  (computed at once using the BatchSymmetric class) and the volumes and
+ *  the shape are estimated using the fixed point algorithm of Celeux and
+ *  Govaert (1995).
+ **/
+template<class Array>
+class Gaussian_Lk_Dk_A_Dk : public FullGaussianBase<Gaussian_Lk_Dk_A_Dk<Array> >
+{
+  public:
+    typedef FullGaussianBase<Gaussian_Lk_Dk_A_Dk<Array> > Base;
+    using Base::p_tik;
+    using Base::param_;
+    using Base::p_data;
+
+    /** default constructor
+     * @param nbCluster number of cluster in the model
+     **/
+    Gaussian_Lk_Dk_A_Dk( int nbCluster) : Base(nbCluster) {}
+    /** copy constructor
+     *  @param model The model to copy
+     **/
+    Gaussian_Lk_Dk_A_Dk( Gaussian_Lk_Dk_A_Dk const& model) : Base(model) {}
+    /** destructor */
+    ~Gaussian_Lk_Dk_A_Dk() {}
+    /** Initialize randomly the parameters of the Gaussian mixture. The centers
+     *  will be selected randomly among the data set and the covariance
+     *  matrices will be estimated using the current posterior probabilities.
+     */
+    void randomInit();
+    /** Compute the weighted means, the volumes, the orientations and the common shape. */
+    bool mStep();
+    /** @return the number of free parameters of the model */
+    inline int computeNbFreeParameters() const
+    {
+      const int p = this->nbVariable();
+      const int K = this->nbCluster();
+      return K*(p + (p*(p+1))/2) - (K-1)*(p-1);
+    }
+  private:
+    /** compute the covariance matrices
+     *  @return @c false if the scatter matrices are degenerated
+     **/
+    bool updateSigma();
+};
+
+/* Initialize randomly the parameters of the Gaussian mixture. */
+template<class Array>
+void Gaussian_Lk_Dk_A_Dk<Array>::randomInit()
+{
+  this->randomMean();
+  if (!updateSigma() || !this->updateFactors()) throw Clust::randomParamInitFail_;
+#ifdef STK_MIXTURE_VERY_VERBOSE
+  stk_cout << _T("Gaussian_Lk_Dk_A_Dk<Array>::randomInit() done\n");
+#endif
+}
+
+/* Compute the weighted means and the weighted covariance matrices. */
+template<class Array>
+bool Gaussian_Lk_Dk_A_Dk<Array>::mStep()
+{
+  // compute the means
+  if (!this->updateMean()) return false;
+  if (!updateSigma()) return false;
+  return this->updateFactors();
+}
+
+template<class Array>
+bool Gaussian_Lk_Dk_A_Dk<Array>::updateSigma()
+{
+  const int p = this->nbVariable(), K = this->nbCluster(), first = p_tik()->beginCols();
+  Range cols = p_data()->cols();
+  // eigenvalues decomposition of the scatter matrices
+  BatchSymmetric batch(K, p);
+  CPointX nk(K), lambda(K);
+  ArrayXX w;
+  for (int k= 0; k < K; ++k)
+  {
+    nk[k] = this->scatter(first+k, w);
+    if (!(nk[k] > 0.)) return false;
+    batch.setMatrix(k, w);
+  }
+  batch.eigen();
+  CArrayXX const& omega = batch.eigenValues();
+  for (int k= 0; k < K; ++k) { lambda[k] = omega.col(k).sum()/(p*nk[k]);}
+  CVectorX a(p);
+  for (int iter = 0; iter < 100; ++iter)
+  {
+    // update the shape
+    a = 0.;
+    for (int k= 0; k < K; ++k) { a += omega.col(k)/lambda[k];}
+    Real lnDet = 0.;
+    for (int j= 0; j < p; ++j)
+    {
+      if (!(a[j] > 0.)) return false;
+      lnDet += std::log(a[j]);
+    }
+    a /= std::exp(lnDet/p);
+    // update the volumes
+    Real delta = 0.;
+    for (int k= 0; k < K; ++k)
+    {
+      Real lk = (omega.col(k)/a).sum()/(p*nk[k]);
+      if (!(lk > 0.)) return false;
+      delta = std::max(delta, std::abs(lk - lambda[k])/lk);
+      lambda[k] = lk;
+    }
+    if (delta < 1e-10) break;
+  }
+  // Sigma_k = lambda_k D_k A D_k'
+  for (int k= 0; k < K; ++k)
+  {
+    ArrayXX& sigma = param_.sigma_[first+k];
+    for (int j= 0; j < p; ++j)
+    {
+      for (int i= 0; i <= j; ++i)
+      {
+        Real sum = 0.;
+        for (int l= 0; l < p; ++l) { sum += batch(k, i, l) * a[l] * batch(k, j, l);}
+        sigma(cols.begin()+i, cols.begin()+j) = sigma(cols.begin()+j, cols.begin()+i) = lambda[k]*sum;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace STK
+
+#endif /* STK_GAUSSIAN_LK_DK_A_DK_H */
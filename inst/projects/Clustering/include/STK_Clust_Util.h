@@ -207,6 +207,10 @@ enum Mixture
   Poisson_ljlk_,
   KernelGaussian_sk_,
   KernelGaussian_s_,
+  Gaussian_Lk_Ck_,
+  Gaussian_L_C_,
+  Gaussian_Lk_C_,
+  Gaussian_Lk_Dk_A_Dk_,
   unknown_mixture_
 };
 
@@ -244,6 +248,10 @@ MixtureClass mixtureToMixtureClass( Mixture const& type);
  * <tr> <td> "Poisson_ljlk"    </td></tr>
  * <tr> <td> "KernelGaussian_sk" </td></tr>
  * <tr> <td> "KernelGaussian_s"  </td></tr>
+ * <tr> <td> "Gaussian_Lk_Ck"  </td></tr>
+ * <tr> <td> "Gaussian_L_C"    </td></tr>
+ * <tr> <td> "Gaussian_Lk_C"   </td></tr>
+ * <tr> <td> "Gaussian_Lk_Dk_A_Dk" </td></tr>
  * </table>
  *  @param type the String we want to convert
  *  @return the Mixture represented by the String @c type. if the string
@@ -279,6 +287,10 @@ Mixture stringToMixture( std::string const& type);
  * <tr> <td> "Poisson_pk_ljlk"    </td><td> "Poisson_p_ljlk"    </td> </tr>
  * <tr> <td> "KernelGaussian_pk_sk" </td><td> "KernelGaussian_p_sk"    </td> </tr>
  * <tr> <td> "KernelGaussian_pk_s" </td><td> "KernelGaussian_p_s"    </td> </tr>
+ * <tr> <td> "Gaussian_pk_Lk_Ck"  </td><td> "Gaussian_p_Lk_Ck"  </td> </tr>
+ * <tr> <td> "Gaussian_pk_L_C"    </td><td> "Gaussian_p_L_C"    </td> </tr>
+ * <tr> <td> "Gaussian_pk_Lk_C"   </td><td> "Gaussian_p_Lk_C"   </td> </tr>
+ * <tr> <td> "Gaussian_pk_Lk_Dk_A_Dk" </td><td> "Gaussian_p_Lk_Dk_A_Dk" </td> </tr>
  * </table>
  *  @param type the String we want to convert
  *  @param[out] freeProp @c true if the model have free proportions, @c false otherwise.
@@ -41,6 +41,7 @@
 #include <Arrays/include/STK_CArrayPoint.h>
 #include <Arrays/include/STK_CArrayVector.h>
 #include <Arrays/include/STK_CArray.h>
+#include <Arrays/include/STK_Array2D.h>
 
 namespace STK
 {
@@ -160,6 +161,11 @@ class IMixture
     stk_cout<< _T("You need to override this method in your mixture!");
 #endif
     }
+    /** This function can be used to get the parameters in an array. It is used
+     *  by the composer for recording the parameters at each iteration.
+     *  @param params the array with the parameters (empty by default)
+     */
+    inline virtual void getParameters(ArrayXX& params) const { params.clear();}
 
   protected:
     /** This function can be used in derived classes to get number of samples.
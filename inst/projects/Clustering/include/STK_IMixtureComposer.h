@@ -248,7 +248,9 @@ class IMixtureComposer : public IStatModelBase
      **/
     int sStep();
     /** compute the zi, the lnLikelihood of the current estimates
-     *  and the next value of the tik.
+     *  and the next value of the tik. The temporary containers created by
+     *  eStep(i) are allocated in the current MemoryArena of the thread if
+     *  any, in a local arena otherwise.
      *  @return the minimal value of tk
      **/
     Real eStep();
@@ -277,6 +279,8 @@ class IMixtureComposer : public IStatModelBase
     int randomFuzzyTik();
 
   private:
+    /** size of the chunks of the arenas used in the eStep */
+    enum { arenaChunkSize_ = 1<<16 };
     /** state of the model*/
     Clust::modelState state_;
     /** Auxiliary array used in the eStep */
@@ -41,6 +41,7 @@
 
 #include "STK_IMixtureComposer.h"
 #include "STK_IMixtureManager.h"
+#include "STK_MixtureTrace.h"
 
 namespace STK
 {
@@ -86,6 +87,15 @@ class MixtureComposer : public IMixtureComposer
 
     /** @return a constant reference on the vector of mixture */
     inline std::vector<IMixture*> const& v_mixtures() const { return v_mixtures_;}
+    /** @return a pointer on the trace recorder (can be null) */
+    inline MixtureTraceRecorder* p_trace() const { return p_trace_;}
+    /** set a trace recorder. If the recorder is not null, the log-likelihood,
+     *  the proportions and the parameters of the mixtures are recorded by
+     *  @c storeIntermediateResults. The recorder is not owned by the composer
+     *  and is not copied by the copy constructor.
+     *  @param p_trace a pointer on the recorder
+     **/
+    inline void setTrace(MixtureTraceRecorder* p_trace) { p_trace_ = p_trace;}
     /** Utility lookup function allowing to find a Mixture from its idData
      *  @param idData the id name of the data
      *  @return a pointer on the mixture, NULL if the mixture is not found
@@ -135,7 +145,8 @@ class MixtureComposer : public IMixtureComposer
     virtual void samplingStep();
     /**@brief This step can be used to signal to the mixtures that they must
      * store results. This is usually called after a burn-in phase. The composer
-     * store the current value of the log-Likelihood.
+     * store the current value of the log-Likelihood and record the current
+     * parameters in the trace recorder if any.
      **/
     virtual void storeIntermediateResults(int iteration);
     /**@brief This step can be used to signal to the mixtures that they must
@@ -218,6 +229,8 @@ class MixtureComposer : public IMixtureComposer
      *  storeIntermediateResults method.
      **/
     Real meanlnLikelihood_;
+    /** the trace recorder, if any */
+    MixtureTraceRecorder* p_trace_;
 };
 
 /** @brief specialization of the composer for the fixed proportion case.
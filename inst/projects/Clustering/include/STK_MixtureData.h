@@ -40,6 +40,23 @@
 namespace STK
 {
 
+namespace hidden
+{
+/** @ingroup hidden
+ *  @brief Give to a MixtureData the ownership of its data set before the
+ *  missing values are imputed. The STK++ containers own their data and there
+ *  is nothing to do. The containers wrapping a memory owned by an other
+ *  application (like RMatrix) have to specialize this class in order to copy
+ *  the data.
+ **/
+template<class Data>
+struct MixtureDataOwner
+{
+  static inline void run( Data&) {}
+};
+
+} // namespace hidden
+
 /** @ingroup Clustering
  *  @brief bridge a data set for a MixtureBridge.
  *
@@ -79,6 +96,8 @@ class MixtureData : public IMixtureData
          { v_missing_.push_back(std::pair<int,int>(i,j));}
        }
      }
+     // the missing values will be imputed in the data set
+     if (v_missing_.size() > 0) { hidden::MixtureDataOwner<Data>::run(dataij_);}
 #ifdef STK_MIXTURE_VERBOSE
      stk_cout << _T("findMissing() terminated, nbMiss= ") << v_missing_.size() << _T("\n");
 #endif
@@ -41,6 +41,7 @@
 #include "CategoricalMixtureModels/STK_CategoricalMixtureManager.h"
 #include "GammaMixtureModels/STK_GammaMixtureManager.h"
 #include "DiagGaussianMixtureModels/STK_DiagGaussianMixtureManager.h"
+#include "FullGaussianMixtureModels/STK_FullGaussianMixtureManager.h"
 #include "PoissonMixtureModels/STK_PoissonMixtureManager.h"
 #include "KernelMixtureModels/STK_KernelMixtureManager.h"
 
@@ -101,6 +102,11 @@ class MixtureManager : public IMixtureManager<DataHandler>
     typedef DiagGaussianBridge<Clust::Gaussian_sk_,  DataReal> MixtureBridge_sk;
     typedef DiagGaussianBridge<Clust::Gaussian_sj_,  DataReal> MixtureBridge_sj;
     typedef DiagGaussianBridge<Clust::Gaussian_s_,   DataReal> MixtureBridge_s;
+    // All full Gaussian bridges
+    typedef FullGaussianBridge<Clust::Gaussian_Lk_Ck_,      DataReal> MixtureBridge_Lk_Ck;
+    typedef FullGaussianBridge<Clust::Gaussian_L_C_,        DataReal> MixtureBridge_L_C;
+    typedef FullGaussianBridge<Clust::Gaussian_Lk_C_,       DataReal> MixtureBridge_Lk_C;
+    typedef FullGaussianBridge<Clust::Gaussian_Lk_Dk_A_Dk_, DataReal> MixtureBridge_Lk_Dk_A_Dk;
     // All Categorical bridges
     typedef CategoricalBridge<Clust::Categorical_pjk_, DataInt> MixtureBridge_pjk;
     typedef CategoricalBridge<Clust::Categorical_pk_,  DataInt> MixtureBridge_pk;
@@ -181,6 +187,18 @@ class MixtureManager : public IMixtureManager<DataHandler>
         case Clust::Gaussian_s_:
         { static_cast<MixtureBridge_s*>(p_mixture)->getParameters(param);}
         break;
+        case Clust::Gaussian_Lk_Ck_:
+        { static_cast<MixtureBridge_Lk_Ck*>(p_mixture)->getParameters(param);}
+        break;
+        case Clust::Gaussian_L_C_:
+        { static_cast<MixtureBridge_L_C*>(p_mixture)->getParameters(param);}
+        break;
+        case Clust::Gaussian_Lk_C_:
+        { static_cast<MixtureBridge_Lk_C*>(p_mixture)->getParameters(param);}
+        break;
+        case Clust::Gaussian_Lk_Dk_A_Dk_:
+        { static_cast<MixtureBridge_Lk_Dk_A_Dk*>(p_mixture)->getParameters(param);}
+        break;
         // Categorical models
         case Clust::Categorical_pjk_:
         { static_cast<MixtureBridge_pjk*>(p_mixture)->getParameters(param);}
@@ -267,6 +285,18 @@ class MixtureManager : public IMixtureManager<DataHandler>
         case Clust::Gaussian_s_:
         { static_cast<MixtureBridge_s*>(p_mixture)->setParameters(param);}
         break;
+        case Clust::Gaussian_Lk_Ck_:
+        { static_cast<MixtureBridge_Lk_Ck*>(p_mixture)->setParameters(param);}
+        break;
+        case Clust::Gaussian_L_C_:
+        { static_cast<MixtureBridge_L_C*>(p_mixture)->setParameters(param);}
+        break;
+        case Clust::Gaussian_Lk_C_:
+        { static_cast<MixtureBridge_Lk_C*>(p_mixture)->setParameters(param);}
+        break;
+        case Clust::Gaussian_Lk_Dk_A_Dk_:
+        { static_cast<MixtureBridge_Lk_Dk_A_Dk*>(p_mixture)->setParameters(param);}
+        break;
         // Categorical models
         case Clust::Categorical_pjk_:
         { static_cast<MixtureBridge_pjk*>(p_mixture)->setParameters(param);}
@@ -361,6 +391,18 @@ class MixtureManager : public IMixtureManager<DataHandler>
         case Clust::Gaussian_s_:
         { STK_CREATE_MIXTURE(MixtureDataReal, MixtureBridge_s)}
         break;
+        case Clust::Gaussian_Lk_Ck_:
+        { STK_CREATE_MIXTURE(MixtureDataReal, MixtureBridge_Lk_Ck)}
+        break;
+        case Clust::Gaussian_L_C_:
+        { STK_CREATE_MIXTURE(MixtureDataReal, MixtureBridge_L_C)}
+        break;
+        case Clust::Gaussian_Lk_C_:
+        { STK_CREATE_MIXTURE(MixtureDataReal, MixtureBridge_Lk_C)}
+        break;
+        case Clust::Gaussian_Lk_Dk_A_Dk_:
+        { STK_CREATE_MIXTURE(MixtureDataReal, MixtureBridge_Lk_Dk_A_Dk)}
+        break;
         // Categorical models
         case Clust::Categorical_pjk_:
         { STK_CREATE_MIXTURE(MixtureDataInt, MixtureBridge_pjk)}
@@ -0,0 +1,202 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Clustering
+ * Purpose:  Declaration of the classes MixtureTraceRecorder and MixtureTraceReader.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_MixtureTrace.h
+ *  @brief In this file we define the classes MixtureTraceRecorder and
+ *  MixtureTraceReader allowing to keep the trace of the parameters of a
+ *  mixture model during the iterations of a stochastic algorithm.
+ **/
+
+#ifndef STK_MIXTURETRACE_H
+#define STK_MIXTURETRACE_H
+
+#include <vector>
+#include <fstream>
+
+#include "STKernel/include/STK_Real.h"
+
+namespace STK
+{
+
+/** @ingroup Clustering
+ *  @brief The MixtureTraceRecorder class records the log-likelihood and the
+ *  parameters of a mixture model at each iteration.
+ *
+ *  The records are grouped in blocks. The first record of a block is stored
+ *  as float, the other records are stored as the float difference with the
+ *  previous record (the differences are computed with the decoded values,
+ *  so that the rounding errors do not accumulate). A record of p parameters
+ *  use 4(p+2) bytes.
+ *
+ *  The last blocks are kept in memory in a ring buffer and can be read using
+ *  @c get. If a file name is given, each complete block is also appended to
+ *  the file, the last (incomplete) block being written by @c close. The file
+ *  can be read using the MixtureTraceReader class.
+ *  @code
+ *  MixtureTraceRecorder trace(1000, "trace.bin");
+ *  composer.setTrace(&trace);
+ *  semAlgo.run();
+ *  trace.close();
+ *  @endcode
+ **/
+class MixtureTraceRecorder
+{
+  public:
+    /** constructor.
+     *  @param capacity minimal number of records kept in memory
+     *  @param fileName name of the file to write (no file if empty)
+     *  @param blockSize number of records in a block
+     **/
+    MixtureTraceRecorder( int capacity = 1024
+                        , std::string const& fileName = std::string()
+                        , int blockSize = 64
+                        );
+    /** destructor. Close the file if needed. */
+    ~MixtureTraceRecorder();
+    /** @return the number of parameters of the records (-1 if there is no
+     *  record yet) */
+    inline int nbParameter() const { return nbParameter_;}
+    /** @return the number of records kept in memory */
+    inline int nbRecord() const { return nbRecord_;}
+    /** @return the number of records appended */
+    inline int nbAppended() const { return nbAppended_;}
+    /** @return the last error message */
+    inline String const& error() const { return msg_error_;}
+    /** append a record.
+     *  @param iteration the number of the iteration
+     *  @param lnLikelihood the log-likelihood
+     *  @param params the parameters. The number of parameters must be the
+     *  same for all the records.
+     *  @return @c false if an error occur
+     **/
+    bool append( int iteration, Real lnLikelihood, std::vector<Real> const& params);
+    /** get a record kept in memory.
+     *  @param pos position of the record, 0 for the oldest record in memory
+     *  @param iteration,lnLikelihood,params the record
+     *  @return @c false if pos is not a valid position
+     **/
+    bool get( int pos, int& iteration, Real& lnLikelihood, std::vector<Real>& params) const;
+    /** write the last block in the file and close it.
+     *  @return @c false if an error occur
+     **/
+    bool close();
+    /** remove the records kept in memory. */
+    void clear();
+
+  private:
+    /** a block of records */
+    struct Block
+    {
+      /** the iterations */
+      std::vector<int> iterations_;
+      /** the encoded log-likelihood and parameters */
+      std::vector<float> values_;
+    };
+    /** name of the file */
+    std::string fileName_;
+    /** the file */
+    std::ofstream file_;
+    /** number of records in a block */
+    int blockSize_;
+    /** number of parameters */
+    int nbParameter_;
+    /** number of records in memory */
+    int nbRecord_;
+    /** number of records appended */
+    int nbAppended_;
+    /** the blocks kept in memory */
+    std::vector<Block> blocks_;
+    /** position of the oldest block */
+    int first_;
+    /** number of blocks used */
+    int nbBlock_;
+    /** the decoded values of the last record */
+    std::vector<Real> last_;
+    /** last error message */
+    String msg_error_;
+    /** write a block in the file */
+    bool write( Block const& block);
+};
+
+/** @ingroup Clustering
+ *  @brief The MixtureTraceReader class reads sequentially the records of a
+ *  file written by a MixtureTraceRecorder.
+ *  @code
+ *  MixtureTraceReader reader("trace.bin");
+ *  int iter; Real lnLikelihood; std::vector<Real> params;
+ *  while (reader.next(iter, lnLikelihood, params)) { ...}
+ *  @endcode
+ **/
+class MixtureTraceReader
+{
+  public:
+    /** constructor. Open the file.
+     *  @param fileName name of the file to read
+     **/
+    MixtureTraceReader( std::string const& fileName);
+    /** @return @c true if the file is opened */
+    inline bool isOpen() const { return file_.is_open();}
+    /** @return the number of parameters of the records */
+    inline int nbParameter() const { return nbParameter_;}
+    /** @return the last error message */
+    inline String const& error() const { return msg_error_;}
+    /** read the next record.
+     *  @param iteration,lnLikelihood,params the record
+     *  @return @c false if there is no more record
+     **/
+    bool next( int& iteration, Real& lnLikelihood, std::vector<Real>& params);
+    /** go back to the first record.
+     *  @return @c false if an error occur
+     **/
+    bool rewind();
+
+  private:
+    /** the file */
+    std::ifstream file_;
+    /** number of parameters */
+    int nbParameter_;
+    /** the current block */
+    std::vector<int> iterations_;
+    /** the values of the current block */
+    std::vector<float> values_;
+    /** position of the next record in the current block */
+    int pos_;
+    /** the decoded values of the last record */
+    std::vector<Real> last_;
+    /** last error message */
+    String msg_error_;
+    /** read the header of the file */
+    bool readHeader();
+};
+
+} // namespace STK
+
+#endif /* STK_MIXTURETRACE_H */
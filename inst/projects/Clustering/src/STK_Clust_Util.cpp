@@ -151,6 +151,10 @@ MixtureClass mixtureToMixtureClass( Mixture const& type)
   if (type == Poisson_ljlk_) return Poisson_;
   if (type == KernelGaussian_sk_) return Kernel_;
   if (type == KernelGaussian_s_) return Kernel_;
+  if (type == Gaussian_Lk_Ck_) return Gaussian_;
+  if (type == Gaussian_L_C_) return Gaussian_;
+  if (type == Gaussian_Lk_C_) return Gaussian_;
+  if (type == Gaussian_Lk_Dk_A_Dk_) return Gaussian_;
   return unknown_mixture_class_;
 }
 
@@ -185,6 +189,10 @@ Mixture stringToMixture( std::string const& type)
   if (toUpperString(type) == toUpperString(_T("Poisson_ljlk"))) return Poisson_ljlk_;
   if (toUpperString(type) == toUpperString(_T("KernelGaussian_sk"))) return KernelGaussian_sk_;
   if (toUpperString(type) == toUpperString(_T("KernelGaussian_s"))) return KernelGaussian_s_;
+  if (toUpperString(type) == toUpperString(_T("Gaussian_Lk_Ck"))) return Gaussian_Lk_Ck_;
+  if (toUpperString(type) == toUpperString(_T("Gaussian_L_C"))) return Gaussian_L_C_;
+  if (toUpperString(type) == toUpperString(_T("Gaussian_Lk_C"))) return Gaussian_Lk_C_;
+  if (toUpperString(type) == toUpperString(_T("Gaussian_Lk_Dk_A_Dk"))) return Gaussian_Lk_Dk_A_Dk_;
 #ifdef STK_MIXTURE_DEBUG
   stk_cout << _T("In stringToMixture, mixture ") << type << _T(" not found.\n");
 #endif
@@ -222,6 +230,10 @@ Mixture stringToMixture( std::string const& type, bool& freeProp)
   if (toUpperString(type) == toUpperString(_T("Poisson_p_ljlk"))) return Poisson_ljlk_;
   if (toUpperString(type) == toUpperString(_T("KernelGaussian_p_sk"))) return KernelGaussian_sk_;
   if (toUpperString(type) == toUpperString(_T("KernelGaussian_p_s"))) return KernelGaussian_s_;
+  if (toUpperString(type) == toUpperString(_T("Gaussian_p_Lk_Ck"))) return Gaussian_Lk_Ck_;
+  if (toUpperString(type) == toUpperString(_T("Gaussian_p_L_C"))) return Gaussian_L_C_;
+  if (toUpperString(type) == toUpperString(_T("Gaussian_p_Lk_C"))) return Gaussian_Lk_C_;
+  if (toUpperString(type) == toUpperString(_T("Gaussian_p_Lk_Dk_A_Dk"))) return Gaussian_Lk_Dk_A_Dk_;
   freeProp = true;
   if (toUpperString(type) == toUpperString(_T("Gamma_pk_ajk_bjk"))) return Gamma_ajk_bjk_;
   if (toUpperString(type) == toUpperString(_T("Gamma_pk_ajk_bk"))) return Gamma_ajk_bk_;
@@ -246,6 +258,10 @@ Mixture stringToMixture( std::string const& type, bool& freeProp)
   if (toUpperString(type) == toUpperString(_T("Poisson_pk_ljlk"))) return Poisson_ljlk_;
   if (toUpperString(type) == toUpperString(_T("KernelGaussian_pk_sk"))) return KernelGaussian_sk_;
   if (toUpperString(type) == toUpperString(_T("KernelGaussian_pk_s"))) return KernelGaussian_s_;
+  if (toUpperString(type) == toUpperString(_T("Gaussian_pk_Lk_Ck"))) return Gaussian_Lk_Ck_;
+  if (toUpperString(type) == toUpperString(_T("Gaussian_pk_L_C"))) return Gaussian_L_C_;
+  if (toUpperString(type) == toUpperString(_T("Gaussian_pk_Lk_C"))) return Gaussian_Lk_C_;
+  if (toUpperString(type) == toUpperString(_T("Gaussian_pk_Lk_Dk_A_Dk"))) return Gaussian_Lk_Dk_A_Dk_;
 #ifdef STK_MIXTURE_DEBUG
   stk_cout << _T("In stringToMixture, mixture ") << type << _T(" not found.\n");
 #endif
@@ -282,6 +298,10 @@ std::string mixtureToString( Mixture const& type)
   if (type == Poisson_ljlk_) return String(_T("Poisson_ljlk"));
   if (type == KernelGaussian_sk_) return String(_T("KernelGaussian_sk"));
   if (type == KernelGaussian_s_) return String(_T("KernelGaussian_s"));
+  if (type == Gaussian_Lk_Ck_) return String(_T("Gaussian_Lk_Ck"));
+  if (type == Gaussian_L_C_) return String(_T("Gaussian_L_C"));
+  if (type == Gaussian_Lk_C_) return String(_T("Gaussian_Lk_C"));
+  if (type == Gaussian_Lk_Dk_A_Dk_) return String(_T("Gaussian_Lk_Dk_A_Dk"));
   return String(_T("unknown"));
 }
 
@@ -321,6 +341,10 @@ std::string mixtureToString(Mixture type, bool freeProp)
     if (type == Poisson_ljlk_) return String(_T("Poisson_p_ljlk"));
     if (type == KernelGaussian_sk_) return String(_T("KernelGaussian_sk_p"));
     if (type == KernelGaussian_s_) return String(_T("KernelGaussian_s_p"));
+    if (type == Gaussian_Lk_Ck_) return String(_T("Gaussian_p_Lk_Ck"));
+    if (type == Gaussian_L_C_) return String(_T("Gaussian_p_L_C"));
+    if (type == Gaussian_Lk_C_) return String(_T("Gaussian_p_Lk_C"));
+    if (type == Gaussian_Lk_Dk_A_Dk_) return String(_T("Gaussian_p_Lk_Dk_A_Dk"));
   }
   else
   {
@@ -346,6 +370,10 @@ std::string mixtureToString(Mixture type, bool freeProp)
     if (type == Poisson_lk_) return String(_T("Poisson_pk_lk"));
     if (type == Poisson_ljlk_) return String(_T("Poisson_pk_ljlk"));
     if (type == KernelGaussian_sk_) return String(_T("KernelGaussian_pk_sk"));
+    if (type == Gaussian_Lk_Ck_) return String(_T("Gaussian_pk_Lk_Ck"));
+    if (type == Gaussian_L_C_) return String(_T("Gaussian_pk_L_C"));
+    if (type == Gaussian_Lk_C_) return String(_T("Gaussian_pk_Lk_C"));
+    if (type == Gaussian_Lk_Dk_A_Dk_) return String(_T("Gaussian_pk_Lk_Dk_A_Dk"));
   }
   return String(_T("unknown"));
 }
@@ -43,6 +43,7 @@
 #include "STatistiK/include/STK_Law_Categorical.h"
 #include "STatistiK/include/STK_Stat_Functors.h"
 #include "Arrays/include/STK_Array2DPoint.h" // for sum
+#include "Arrays/include/STK_MemoryArena.h"
 
 namespace STK
 {
@@ -152,11 +153,24 @@ Real IMixtureComposer::eStep()
   stk_cout << _T("Entering IMixtureComposer::eStep()\n");
 #endif
   Real sum = 0.; nk_ =0.;
-  int i;
 #ifdef _OPENMP
-#pragma omp parallel for reduction (+:sum)
+#pragma omp parallel reduction (+:sum)
 #endif
-  for (i = tik_.beginRows(); i < tik_.endRows(); ++i) { sum += eStep(i);}
+  {
+    // the temporaries of eStep(i) are allocated in the arena of the thread
+    // (if any) or in a local arena released after each individual
+    MemoryArena localArena(arenaChunkSize_);
+    MemoryArena& arena = MemoryArena::current() ? *MemoryArena::current() : localArena;
+    int i;
+#ifdef _OPENMP
+#pragma omp for
+#endif
+    for (i = tik_.beginRows(); i < tik_.endRows(); ++i)
+    {
+      ArenaScope scope(arena);
+      sum += eStep(i);
+    }
+  }
   // update ln-likelihood
   setLnLikelihood(sum);
   // compute proportions
@@ -46,6 +46,7 @@ namespace STK
 MixtureComposer::MixtureComposer( int nbSample, int nbCluster)
                                 : IMixtureComposer( nbSample, nbCluster)
                                 , meanlnLikelihood_(0.)
+                                , p_trace_(0)
 { setNbFreeParameter(nbCluster-1);}
 
 /* copy constructor.
@@ -55,6 +56,7 @@ MixtureComposer::MixtureComposer( MixtureComposer const& composer)
                                 : IMixtureComposer(composer)
                                 , v_mixtures_(composer.v_mixtures_)
                                 , meanlnLikelihood_(composer.meanlnLikelihood_)
+                                , p_trace_(0)
 {
   // clone mixtures
   for (size_t l = 0; l < v_mixtures_.size(); ++l)
@@ -183,6 +185,20 @@ void MixtureComposer::storeIntermediateResults(int iteration)
   for (MixtIterator it = v_mixtures_.begin(); it != v_mixtures_.end(); ++it)
   { (*it)->storeIntermediateResults(iteration);}
   meanlnLikelihood_ += (lnLikelihood() - meanlnLikelihood_)/iteration;
+  if (p_trace_)
+  {
+    // proportions followed by the parameters of the mixtures (by row)
+    std::vector<Real> params;
+    for (int k=pk().begin(); k<pk().end(); ++k) { params.push_back(pk()[k]);}
+    ArrayXX param;
+    for (MixtIterator it = v_mixtures_.begin(); it != v_mixtures_.end(); ++it)
+    {
+      (*it)->getParameters(param);
+      for (int k=param.beginRows(); k<param.endRows(); ++k)
+      { for (int j=param.beginCols(); j<param.endCols(); ++j) { params.push_back(param(k, j));}}
+    }
+    p_trace_->append(iteration, lnLikelihood(), params);
+  }
 }
 
 void MixtureComposer::releaseIntermediateResults()
@@ -0,0 +1,277 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Clustering
+ * Purpose:  Implementation of the classes MixtureTraceRecorder and MixtureTraceReader.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_MixtureTrace.cpp
+ *  @brief In this file we implement the classes MixtureTraceRecorder and
+ *  MixtureTraceReader.
+ **/
+
+#include <cstring>
+#include <algorithm>
+
+#include "../include/STK_MixtureTrace.h"
+
+namespace STK
+{
+/** magic number of the trace files */
+static const char traceMagic[8] = { 'S', 'T', 'K', 'T', 'R', 'A', 'C', 'E'};
+
+/** encode a value. The first value of a block and the values following a
+ *  non-finite value are stored as is, the other values are stored as the
+ *  difference with the last decoded value.
+ *  @param x the value to encode
+ *  @param first @c true if this is the first record of the block
+ *  @param last the last decoded value, updated
+ *  @return the encoded value
+ **/
+static inline float encodeValue( Real x, bool first, Real& last)
+{
+  float d;
+  if (first || !Arithmetic<Real>::isFinite(last)) { d = float(x); last = Real(d);}
+  else { d = float(x - last); last += Real(d);}
+  return d;
+}
+/** decode a value.
+ *  @param d the encoded value
+ *  @param first @c true if this is the first record of the block
+ *  @param last the last decoded value, updated
+ **/
+static inline void decodeValue( float d, bool first, Real& last)
+{
+  if (first || !Arithmetic<Real>::isFinite(last)) { last = Real(d);}
+  else { last += Real(d);}
+}
+
+/* constructor. */
+MixtureTraceRecorder::MixtureTraceRecorder( int capacity
+                                          , std::string const& fileName
+                                          , int blockSize
+                                          )
+                                          : fileName_(fileName)
+                                          , blockSize_(std::max(blockSize, 1))
+                                          , nbParameter_(-1)
+                                          , nbRecord_(0), nbAppended_(0)
+                                          , blocks_((std::max(capacity, 1) + blockSize_ - 1)/blockSize_ + 1)
+                                          , first_(0), nbBlock_(0)
+{}
+
+/* destructor */
+MixtureTraceRecorder::~MixtureTraceRecorder() { close();}
+
+/* append a record. */
+bool MixtureTraceRecorder::append( int iteration, Real lnLikelihood, std::vector<Real> const& params)
+{
+  if (nbParameter_ < 0)
+  {
+    nbParameter_ = int(params.size());
+    last_.resize(nbParameter_ + 1);
+    if (!fileName_.empty())
+    {
+      file_.open(fileName_.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!file_.is_open())
+      {
+        msg_error_ = _T("In MixtureTraceRecorder::append, cannot open the file.\n");
+        return false;
+      }
+      const int header[2] = { nbParameter_, blockSize_};
+      file_.write(traceMagic, sizeof(traceMagic));
+      file_.write(reinterpret_cast<char const*>(header), sizeof(header));
+    }
+  }
+  else if (int(params.size()) != nbParameter_)
+  {
+    msg_error_ = _T("In MixtureTraceRecorder::append, wrong number of parameters.\n");
+    return false;
+  }
+  const int nbSlot = int(blocks_.size());
+  bool ok = true;
+  Block* p_block = (nbBlock_ > 0) ? &blocks_[(first_ + nbBlock_ - 1) % nbSlot] : 0;
+  // start a new block if needed
+  if (!p_block || int(p_block->iterations_.size()) == blockSize_)
+  {
+    if (p_block && file_.is_open()) ok = write(*p_block);
+    if (nbBlock_ == nbSlot)
+    { // drop the oldest block
+      nbRecord_ -= int(blocks_[first_].iterations_.size());
+      first_ = (first_ + 1) % nbSlot;
+      --nbBlock_;
+    }
+    p_block = &blocks_[(first_ + nbBlock_) % nbSlot];
+    p_block->iterations_.clear();
+    p_block->values_.clear();
+    ++nbBlock_;
+  }
+  const bool first = p_block->iterations_.empty();
+  p_block->iterations_.push_back(iteration);
+  p_block->values_.push_back(encodeValue(lnLikelihood, first, last_[0]));
+  for (int j=0; j<nbParameter_; ++j)
+  { p_block->values_.push_back(encodeValue(params[j], first, last_[j+1]));}
+  ++nbRecord_;
+  ++nbAppended_;
+  return ok;
+}
+
+/* get a record kept in memory. */
+bool MixtureTraceRecorder::get( int pos, int& iteration, Real& lnLikelihood, std::vector<Real>& params) const
+{
+  if (pos < 0 || pos >= nbRecord_) return false;
+  // find the block of the record
+  const int nbSlot = int(blocks_.size());
+  int b = first_;
+  while (pos >= int(blocks_[b].iterations_.size()))
+  {
+    pos -= int(blocks_[b].iterations_.size());
+    b = (b + 1) % nbSlot;
+  }
+  Block const& block = blocks_[b];
+  // decode the records of the block up to pos
+  std::vector<Real> last(nbParameter_ + 1);
+  for (int i=0; i<=pos; ++i)
+  {
+    float const* p = &block.values_[i * (nbParameter_ + 1)];
+    for (int j=0; j<=nbParameter_; ++j) { decodeValue(p[j], i == 0, last[j]);}
+  }
+  iteration = block.iterations_[pos];
+  lnLikelihood = last[0];
+  params.assign(last.begin() + 1, last.end());
+  return true;
+}
+
+/* write the last block in the file and close it. */
+bool MixtureTraceRecorder::close()
+{
+  if (!file_.is_open()) return true;
+  bool ok = true;
+  if (nbBlock_ > 0)
+  { ok = write(blocks_[(first_ + nbBlock_ - 1) % int(blocks_.size())]);}
+  file_.close();
+  return ok;
+}
+
+/* remove the records kept in memory. */
+void MixtureTraceRecorder::clear()
+{
+  if (file_.is_open() && nbBlock_ > 0)
+  { write(blocks_[(first_ + nbBlock_ - 1) % int(blocks_.size())]);}
+  nbRecord_ = 0;
+  first_ = 0;
+  nbBlock_ = 0;
+}
+
+/* write a block in the file */
+bool MixtureTraceRecorder::write( Block const& block)
+{
+  const int nb = int(block.iterations_.size());
+  if (nb == 0) return true;
+  file_.write(reinterpret_cast<char const*>(&nb), sizeof(nb));
+  file_.write(reinterpret_cast<char const*>(&block.iterations_.front()), nb * sizeof(int));
+  file_.write(reinterpret_cast<char const*>(&block.values_.front()), block.values_.size() * sizeof(float));
+  if (!file_.good())
+  {
+    msg_error_ = _T("In MixtureTraceRecorder::write, an error occur when writing the file.\n");
+    return false;
+  }
+  return true;
+}
+
+/* constructor. Open the file. */
+MixtureTraceReader::MixtureTraceReader( std::string const& fileName)
+                                      : file_(fileName.c_str(), std::ios::in | std::ios::binary)
+                                      , nbParameter_(0), pos_(0)
+{
+  if (!file_.is_open())
+  { msg_error_ = _T("In MixtureTraceReader, cannot open the file.\n");}
+  else if (!readHeader()) { file_.close();}
+}
+
+/* read the next record. */
+bool MixtureTraceReader::next( int& iteration, Real& lnLikelihood, std::vector<Real>& params)
+{
+  if (!file_.is_open()) return false;
+  if (pos_ >= int(iterations_.size()))
+  { // read the next block
+    int nb = 0;
+    if (!file_.read(reinterpret_cast<char*>(&nb), sizeof(nb))) return false;
+    if (nb <= 0 || nb > (1 << 24))
+    {
+      msg_error_ = _T("In MixtureTraceReader::next, the file is corrupted.\n");
+      return false;
+    }
+    iterations_.resize(nb);
+    values_.resize(size_t(nb) * (nbParameter_ + 1));
+    file_.read(reinterpret_cast<char*>(&iterations_.front()), nb * sizeof(int));
+    file_.read(reinterpret_cast<char*>(&values_.front()), values_.size() * sizeof(float));
+    if (!file_)
+    {
+      msg_error_ = _T("In MixtureTraceReader::next, the file is truncated.\n");
+      iterations_.clear();
+      return false;
+    }
+    pos_ = 0;
+  }
+  float const* p = &values_[pos_ * (nbParameter_ + 1)];
+  for (int j=0; j<=nbParameter_; ++j) { decodeValue(p[j], pos_ == 0, last_[j]);}
+  iteration = iterations_[pos_];
+  lnLikelihood = last_[0];
+  params.assign(last_.begin() + 1, last_.end());
+  ++pos_;
+  return true;
+}
+
+/* go back to the first record. */
+bool MixtureTraceReader::rewind()
+{
+  if (!file_.is_open()) return false;
+  file_.clear();
+  file_.seekg(0, std::ios::beg);
+  iterations_.clear();
+  pos_ = 0;
+  return readHeader();
+}
+
+/* read the header of the file */
+bool MixtureTraceReader::readHeader()
+{
+  char magic[sizeof(traceMagic)];
+  int header[2];
+  file_.read(magic, sizeof(magic));
+  file_.read(reinterpret_cast<char*>(header), sizeof(header));
+  if (!file_ || std::memcmp(magic, traceMagic, sizeof(magic)) != 0 || header[0] < 0)
+  {
+    msg_error_ = _T("In MixtureTraceReader, not a trace file.\n");
+    return false;
+  }
+  nbParameter_ = header[0];
+  last_.assign(nbParameter_ + 1, 0.);
+  return true;
+}
+
+} // namespace STK
@@ -0,0 +1,101 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::DManager
+ * Purpose:  Declaration of the class ArrayRowBlockSource.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_ArrayRowBlockSource.h
+ *  @brief In this file we define the class ArrayRowBlockSource.
+ **/
+
+#ifndef STK_ARRAYROWBLOCKSOURCE_H
+#define STK_ARRAYROWBLOCKSOURCE_H
+
+#include "STK_IRowBlockSource.h"
+
+namespace STK
+{
+
+/** @ingroup DManager
+ *  @brief Implementation of the IRowBlockSource interface for an array or
+ *  an expression stored in memory (an Array2D, a R matrix wrapped in a
+ *  RMatrix...).
+ *
+ *  The rows of each block are copied and converted in Real. The array is not
+ *  copied and must live as long as the source.
+ **/
+template<class Array>
+class ArrayRowBlockSource : public IRowBlockSource
+{
+  public:
+    typedef typename Array::Type Type;
+    /** constructor.
+     *  @param data the data set
+     *  @param blockSize the number of rows of the blocks
+     **/
+    ArrayRowBlockSource( ExprBase<Array> const& data, int blockSize = 4096)
+                       : IRowBlockSource(blockSize), data_(data.asDerived()), position_(0)
+    {}
+    /** destructor */
+    virtual ~ArrayRowBlockSource() {}
+    /** @return the number of columns of the data set */
+    virtual int nbCols() const { return data_.sizeCols();}
+    /** go back to the first row of the data set */
+    virtual bool rewind() { position_ = 0; return true;}
+    /** get the next block of rows.
+     *  @param block the block of rows
+     *  @return @c false if there is no more rows
+     **/
+    virtual bool next( CArrayXX& block)
+    {
+      const int nbRows = std::min(blockSize_, data_.sizeRows() - position_);
+      if (nbRows <= 0) return false;
+      block.resize(Range(baseIdx + position_, nbRows), Range(baseIdx, data_.sizeCols()));
+      for (int j=0; j<data_.sizeCols(); ++j)
+      {
+        const int jData = data_.beginCols() + j, jBlock = baseIdx + j;
+        for (int i=0, iData = data_.beginRows() + position_; i<nbRows; ++i, ++iData)
+        {
+          Type const x = data_.elt(iData, jData);
+          block(baseIdx + position_ + i, jBlock) = Arithmetic<Type>::isNA(x) ? Arithmetic<Real>::NA() : Real(x);
+        }
+      }
+      position_ += nbRows;
+      return true;
+    }
+
+  private:
+    /** the data set */
+    Array const& data_;
+    /** the position of the next row to read */
+    int position_;
+};
+
+} // namespace STK
+
+#endif /* STK_ARRAYROWBLOCKSOURCE_H */
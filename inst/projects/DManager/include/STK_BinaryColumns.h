@@ -0,0 +1,413 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::DManager
+ * Purpose:  Declaration of the classes BinaryWriter and BinaryReader.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_BinaryColumns.h
+ *  @brief In this file we define the binary columnar file format of STK++
+ *  and the classes BinaryWriter and BinaryReader.
+ *
+ *  A binary file is composed of
+ *  - a FileHeader (magic number, version, endianness tag, number of rows and
+ *  columns, offsets of the directory and of the names),
+ *  - the data of each column, starting at an offset multiple of
+ *  BinaryColumns::ALIGNMENT,
+ *  - the directory: one ColumnHeader by column (type, offset, size and
+ *  statistics of the column),
+ *  - the names of the columns.
+ *
+ *  The missing values are stored using the NA values of STK++. The Real and
+ *  Integer columns are stored as raw arrays, so that they can be used
+ *  without any copy once the file is mapped in memory. A String column is
+ *  stored as an array of nbRows+1 offsets followed by the characters.
+ **/
+
+#ifndef STK_BINARYCOLUMNS_H
+#define STK_BINARYCOLUMNS_H
+
+#include <fstream>
+#include <vector>
+
+#include <Arrays/include/STK_CArray.h>
+#include <Arrays/include/STK_CArrayVector.h>
+#include "STK_DataFrame.h"
+#include "STK_Variable.h"
+
+namespace STK
+{
+
+namespace BinaryColumns
+{
+/** @ingroup DManager
+ *  magic number at the beginning of a binary file.
+ **/
+static const char MAGIC[8] = {'S', 'T', 'K', 'C', 'O', 'L', 'S', '\0'};
+/** @ingroup DManager
+ *  current version of the binary format.
+ **/
+static const int VERSION = 1;
+/** @ingroup DManager
+ *  alignment (in bytes) of the data of the columns. As it is the size of a
+ *  Real, the consecutive Real columns are contiguous in the file.
+ **/
+static const int ALIGNMENT = 8;
+/** @ingroup DManager
+ *  tag used in order to check the endianness of a file.
+ **/
+static const int ENDIAN_TAG = 0x01020304;
+
+/** @ingroup DManager
+ *  header of a binary file.
+ **/
+struct FileHeader
+{
+  /** magic number */
+  char magic_[8];
+  /** version of the format */
+  int version_;
+  /** endianness tag */
+  int endian_;
+  /** alignment of the columns */
+  int alignment_;
+  /** encoding of the missing values (0: NA values of STK++) */
+  int naEncoding_;
+  /** size of a Char */
+  long long charSize_;
+  /** number of rows */
+  long long nbRows_;
+  /** number of columns */
+  long long nbCols_;
+  /** offset of the directory */
+  long long directory_;
+  /** offset of the names */
+  long long names_;
+};
+
+/** @ingroup DManager
+ *  header of a column in the directory of a binary file.
+ **/
+struct ColumnHeader
+{
+  /** type of the column (Base::IdType) */
+  int type_;
+  /** size of an element of the column */
+  int eltSize_;
+  /** offset of the data */
+  long long offset_;
+  /** size of the data (in bytes) */
+  long long size_;
+  /** number of available (non NA) values */
+  long long nbAvailable_;
+  /** minimal value (numeric columns) */
+  double min_;
+  /** maximal value (numeric columns) */
+  double max_;
+  /** offset of the name in the names (in Char) */
+  long long nameOffset_;
+  /** size of the name (in Char) */
+  long long nameSize_;
+};
+
+/** @ingroup DManager
+ *  Type used in order to store the values of a given Type. The Integer
+ *  values are stored as Integer, all the other values are stored as Real.
+ **/
+template<typename Type>
+struct Storage
+{ typedef Real Type_;};
+/** @ingroup DManager
+ *  Specialization for Integer.
+ **/
+template<>
+struct Storage<Integer>
+{ typedef Integer Type_;};
+
+} // namespace BinaryColumns
+
+/** @ingroup DManager
+ *  @brief The BinaryWriter class write columns of data in a binary file.
+ *
+ *  The columns are written when they are added, the directory of the
+ *  columns and the names are written by @c close. All the columns must
+ *  have the same number of rows.
+ *  @code
+ *  BinaryWriter writer("data.stk");
+ *  writer.write(dataFrame);
+ *  writer.writeColumn(z, "z");
+ *  if (!writer.close()) { stk_cerr << writer.error();}
+ *  @endcode
+ **/
+class BinaryWriter
+{
+  public:
+    /** constructor. Open the file.
+     *  @param fileName name of the file to write
+     **/
+    BinaryWriter( std::string const& fileName);
+    /** destructor. Close the file if needed. */
+    ~BinaryWriter();
+    /** @return @c true if the file is opened */
+    inline bool isOpen() const { return file_.is_open();}
+    /** @return the last error message */
+    inline String const& error() const { return msg_error_;}
+    /** @return the number of rows of the columns */
+    inline int nbRows() const { return nbRows_;}
+    /** @return the number of columns written */
+    inline int nbCols() const { return int(columns_.size());}
+    /** write a numeric vector.
+     *  @param v the vector to write
+     *  @param name the name of the column
+     **/
+    template<class Vector>
+    bool writeColumn( ExprBase<Vector> const& v, String const& name);
+    /** write the columns of a numeric array.
+     *  @param a the array to write
+     *  @param prefix the prefix of the names of the columns
+     **/
+    template<class Array>
+    bool write( ExprBase<Array> const& a, String const& prefix = _T("Var"));
+    /** write a variable. The Real, Integer and String variables are written
+     *  as is, the other variables are written as String.
+     *  @param v the variable to write
+     **/
+    bool writeColumn( IVariable const& v);
+    /** write the variables of a DataFrame.
+     *  @param df the DataFrame to write
+     **/
+    bool write( DataFrame const& df);
+    /** write the directory and the names of the columns and close the file.
+     *  @return @c false if an error occur
+     **/
+    bool close();
+
+  private:
+    /** the file */
+    std::ofstream file_;
+    /** the directory of the columns */
+    std::vector<BinaryColumns::ColumnHeader> columns_;
+    /** the names of the columns */
+    String names_;
+    /** the number of rows, -1 if there is no column */
+    int nbRows_;
+    /** buffer of the data of the current column */
+    std::vector<char> buffer_;
+    /** last error message */
+    String msg_error_;
+    /** begin a new column.
+     *  @param size number of rows of the column
+     *  @param type,eltSize type and size of the elements of the column
+     *  @param name name of the column
+     **/
+    bool beginColumn( int size, Base::IdType type, int eltSize, String const& name);
+    /** flush the buffer and set the size of the current column */
+    bool endColumn();
+    /** write the buffer in the file */
+    void flush();
+    /** write raw data in the buffer
+     *  @param p,n the data and its size in bytes
+     **/
+    inline void append( void const* p, size_t n)
+    {
+      char const* c = static_cast<char const*>(p);
+      buffer_.insert(buffer_.end(), c, c + n);
+      if (buffer_.size() >= (1 << 20)) flush();
+    }
+    /** write a numeric value and update the statistics of the current column.
+     *  @param x the value to write
+     **/
+    template<typename Type>
+    inline void appendValue( Type const& x)
+    {
+      append(&x, sizeof(Type));
+      if (Arithmetic<Type>::isNA(x)) return;
+      BinaryColumns::ColumnHeader& col = columns_.back();
+      if (col.nbAvailable_ == 0) { col.min_ = double(x); col.max_ = double(x);}
+      else
+      {
+        if (double(x) < col.min_) col.min_ = double(x);
+        if (double(x) > col.max_) col.max_ = double(x);
+      }
+      ++col.nbAvailable_;
+    }
+    /** write a String column
+     *  @param v the variable to write
+     **/
+    bool writeStrings( Variable<String> const& v);
+};
+
+template<class Vector>
+bool BinaryWriter::writeColumn( ExprBase<Vector> const& v, String const& name)
+{
+  typedef typename ExprBase<Vector>::Type Type;
+  typedef typename BinaryColumns::Storage<Type>::Type_ Storage;
+  if (!beginColumn(v.size(), IdTypeImpl<Storage>::returnType(), sizeof(Storage), name)) return false;
+  for (int i=v.begin(); i<v.end(); ++i)
+  {
+    Type const x = v.elt(i);
+    appendValue<Storage>(Arithmetic<Type>::isNA(x) ? Arithmetic<Storage>::NA() : Storage(x));
+  }
+  return endColumn();
+}
+
+template<class Array>
+bool BinaryWriter::write( ExprBase<Array> const& a, String const& prefix)
+{
+  typedef typename ExprBase<Array>::Type Type;
+  typedef typename BinaryColumns::Storage<Type>::Type_ Storage;
+  for (int j=a.beginCols(); j<a.endCols(); ++j)
+  {
+    if (!beginColumn(a.sizeRows(), IdTypeImpl<Storage>::returnType(), sizeof(Storage), prefix + typeToString(j)))
+      return false;
+    for (int i=a.beginRows(); i<a.endRows(); ++i)
+    {
+      Type const x = a.elt(i, j);
+      appendValue<Storage>(Arithmetic<Type>::isNA(x) ? Arithmetic<Storage>::NA() : Storage(x));
+    }
+    if (!endColumn()) return false;
+  }
+  return true;
+}
+
+/** @ingroup DManager
+ *  @brief The BinaryReader class gives access to the columns of a binary
+ *  file written by a BinaryWriter.
+ *
+ *  The file is mapped in memory (using mmap on POSIX systems, it is read in
+ *  memory otherwise). The Real and Integer columns are accessed without any
+ *  parsing or copy: the arrays returned by the methods @c column and
+ *  @c block are references on the mapped memory. The mapping is private, so
+ *  that modifying these arrays does not modify the file. They must not be
+ *  used after the reader is closed.
+ *
+ *  The columns are indexed from 0 to nbCols()-1.
+ **/
+class BinaryReader
+{
+  public:
+    /** default constructor */
+    BinaryReader();
+    /** constructor. Open a file.
+     *  @param fileName name of the file to read
+     **/
+    BinaryReader( std::string const& fileName);
+    /** destructor. Close the file if needed. */
+    ~BinaryReader();
+    /** open a file
+     *  @param fileName name of the file to read
+     *  @return @c false if the file cannot be opened or is not a valid file
+     **/
+    bool open( std::string const& fileName);
+    /** unmap the file */
+    void close();
+    /** @return @c true if a file is opened */
+    inline bool isOpen() const { return p_data_ != 0;}
+    /** @return the last error message */
+    inline String const& error() const { return msg_error_;}
+    /** @return the number of rows */
+    inline int nbRows() const { return p_header_ ? int(p_header_->nbRows_) : 0;}
+    /** @return the number of columns */
+    inline int nbCols() const { return p_header_ ? int(p_header_->nbCols_) : 0;}
+    /** @return the type of the column j */
+    inline Base::IdType type( int j) const { return Base::IdType(p_columns_[j].type_);}
+    /** @return the number of available values of the column j */
+    inline int nbAvailable( int j) const { return int(p_columns_[j].nbAvailable_);}
+    /** @return the minimal value of the column j (NA for the String columns
+     *  or if there is no available value)
+     **/
+    inline Real min( int j) const
+    { return (p_columns_[j].nbAvailable_ && type(j) != Base::string_) ? Real(p_columns_[j].min_) : Arithmetic<Real>::NA();}
+    /** @return the maximal value of the column j (NA for the String columns
+     *  or if there is no available value)
+     **/
+    inline Real max( int j) const
+    { return (p_columns_[j].nbAvailable_ && type(j) != Base::string_) ? Real(p_columns_[j].max_) : Arithmetic<Real>::NA();}
+    /** @return the name of the column j */
+    String name( int j) const;
+    /** @return the value of the row i of the String column j */
+    String string( int j, int i) const;
+    /** @return a pointer on the data of the column j if it is of type Type,
+     *  0 otherwise.
+     **/
+    template<typename Type>
+    inline Type* data( int j) const
+    {
+      BinaryColumns::ColumnHeader const& col = p_columns_[j];
+      if (col.type_ != IdTypeImpl<Type>::returnType() || col.eltSize_ != int(sizeof(Type))) return 0;
+      return reinterpret_cast<Type*>(p_data_ + col.offset_);
+    }
+    /** wrap the column j in a vector.
+     *  @param j the column to wrap
+     *  @param v the vector wrapping the column
+     *  @return @c false if the column is not of type Type
+     **/
+    template<typename Type>
+    bool column( int j, CArrayVector<Type>& v) const
+    {
+      Type* p = data<Type>(j);
+      if (!p) return false;
+      v.move(CArrayVector<Type>(p, nbRows()));
+      return true;
+    }
+    /** wrap the consecutive Real columns first to last in an array.
+     *  @param first,last the columns to wrap
+     *  @param a the array wrapping the columns
+     *  @return @c false if the columns are not contiguous Real columns
+     **/
+    bool block( int first, int last, CArrayXX& a) const;
+    /** copy the columns in a DataFrame.
+     *  @param df the DataFrame to fill
+     **/
+    void getDataFrame( DataFrame& df) const;
+
+  private:
+    /** the mapped file */
+    char* p_data_;
+    /** size of the mapped file */
+    size_t size_;
+    /** @c true if the file is mapped, @c false if it is read in memory */
+    bool mapped_;
+    /** header of the file */
+    BinaryColumns::FileHeader const* p_header_;
+    /** directory of the columns */
+    BinaryColumns::ColumnHeader const* p_columns_;
+    /** names of the columns */
+    Char const* p_names_;
+    /** last error message */
+    String msg_error_;
+    /** check the header and the directory of the file */
+    bool check();
+    /** copy constructor (not implemented) */
+    BinaryReader( BinaryReader const&);
+    /** operator= (not implemented) */
+    BinaryReader& operator=( BinaryReader const&);
+};
+
+} // namespace STK
+
+#endif /* STK_BINARYCOLUMNS_H */
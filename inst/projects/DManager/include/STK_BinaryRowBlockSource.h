@@ -0,0 +1,136 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::DManager
+ * Purpose:  Declaration of the class BinaryRowBlockSource.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_BinaryRowBlockSource.h
+ *  @brief In this file we define the class BinaryRowBlockSource.
+ **/
+
+#ifndef STK_BINARYROWBLOCKSOURCE_H
+#define STK_BINARYROWBLOCKSOURCE_H
+
+#include "STK_IRowBlockSource.h"
+#include "STK_BinaryColumns.h"
+
+namespace STK
+{
+
+/** @ingroup DManager
+ *  @brief Implementation of the IRowBlockSource interface for a file in the
+ *  binary columnar format read by a BinaryReader.
+ *
+ *  If all the columns of the file are contiguous Real columns, the blocks
+ *  are references on the mapped memory and no data is copied. Otherwise
+ *  the rows of each block are copied, the Integer columns are converted in
+ *  Real and the String columns are NA. The reader is not copied and must
+ *  stay open as long as the source and the blocks are used.
+ **/
+class BinaryRowBlockSource : public IRowBlockSource
+{
+  public:
+    /** constructor.
+     *  @param reader the reader of the binary file
+     *  @param blockSize the number of rows of the blocks
+     **/
+    BinaryRowBlockSource( BinaryReader const& reader, int blockSize = 4096)
+                        : IRowBlockSource(blockSize), reader_(reader), position_(0)
+                        , isContiguous_(false)
+    {}
+    /** destructor */
+    virtual ~BinaryRowBlockSource() {}
+    /** @return @c true if the blocks are references on the file */
+    inline bool isContiguous() const { return isContiguous_;}
+    /** @return the number of columns of the data set */
+    virtual int nbCols() const { return reader_.nbCols();}
+    /** go back to the first row of the file */
+    virtual bool rewind()
+    {
+      position_ = 0;
+      if (!reader_.isOpen())
+      {
+        msg_error_ = _T("file not opened");
+        return false;
+      }
+      isContiguous_ = reader_.nbCols() > 0 && reader_.block(0, reader_.nbCols()-1, data_);
+      return true;
+    }
+    /** get the next block of rows.
+     *  @param block the block of rows
+     *  @return @c false if there is no more rows
+     **/
+    virtual bool next( CArrayXX& block)
+    {
+      if (!reader_.isOpen()) return false;
+      const int nbRows = std::min(blockSize_, reader_.nbRows() - position_);
+      if (nbRows <= 0) return false;
+      const Range rows(baseIdx + position_, nbRows);
+      if (isContiguous_)
+      { block.move(CArrayXX(data_, rows, data_.cols()));}
+      else
+      {
+        block.resize(rows, Range(baseIdx, reader_.nbCols()));
+        for (int j=0; j<reader_.nbCols(); ++j)
+        {
+          const int jBlock = baseIdx + j;
+          if (Real const* p = reader_.data<Real>(j))
+          {
+            for (int i=0; i<nbRows; ++i)
+            { block(rows.begin() + i, jBlock) = p[position_ + i];}
+          }
+          else if (Integer const* p = reader_.data<Integer>(j))
+          {
+            for (int i=0; i<nbRows; ++i)
+            {
+              Integer const x = p[position_ + i];
+              block(rows.begin() + i, jBlock) = Arithmetic<Integer>::isNA(x) ? Arithmetic<Real>::NA() : Real(x);
+            }
+          }
+          else
+          { block.col(jBlock).setValue(Arithmetic<Real>::NA());}
+        }
+      }
+      position_ += nbRows;
+      return true;
+    }
+
+  private:
+    /** the reader of the file */
+    BinaryReader const& reader_;
+    /** the position of the next row to read */
+    int position_;
+    /** @c true if all the columns are contiguous Real columns */
+    bool isContiguous_;
+    /** reference on the whole data set if the columns are contiguous */
+    CArrayXX data_;
+};
+
+} // namespace STK
+
+#endif /* STK_BINARYROWBLOCKSOURCE_H */
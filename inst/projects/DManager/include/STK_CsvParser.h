@@ -0,0 +1,690 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2016  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::DManager
+ * Purpose:  Define the classes used for parsing csv files.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_CsvParser.h
+ *  @brief In this file we define the classes used in order to split a csv
+ *  file in lines and fields and to convert the fields without using streams.
+ **/
+
+#ifndef STK_CSVPARSER_H
+#define STK_CSVPARSER_H
+
+#include <vector>
+#include <map>
+#include <cstdlib>
+#include <sstream>
+#include <locale>
+
+#include "STKernel/include/STK_Real.h"
+#include "STKernel/include/STK_Integer.h"
+#include "STK_DManager_Util.h"
+
+namespace STK
+{
+
+namespace Csv
+{
+/** @ingroup DManager
+ *  A field of a csv file is given by the pointers on its first character and
+ *  on the character following its last character.
+ **/
+typedef std::pair<Char const*, Char const*> Field;
+
+/** @ingroup DManager
+ *  @return @c true if the character is a white space in the classic locale
+ *  @param c the character to test
+ **/
+inline bool isSpace( Char c)
+{ return (c == CHAR_BLANK) || (c >= _T('\t') && c <= _T('\r'));}
+
+/** @ingroup DManager
+ *  @return @c true if the field [b, e) is the NA string
+ *  @param b,e the field
+ **/
+inline bool isNaString( Char const* b, Char const* e)
+{ return (e - b == stringNaSize) && (stringNa.compare(0, stringNaSize, b, stringNaSize) == 0);}
+
+/** @ingroup DManager
+ *  @brief The BlockReader class reads an input stream by large blocks
+ *  ending at an end of line, so that each block contains complete lines.
+ *  The incomplete line at the end of a block is moved at the beginning of the
+ *  next block.
+ **/
+class BlockReader
+{
+  public:
+    /** constructor.
+     *  @param is the input stream to read
+     *  @param blockSize the minimal number of characters to read at once
+     **/
+    inline BlockReader( istream& is, int blockSize = (1 << 22))
+                      : is_(is), blockSize_(blockSize), buffer_(blockSize)
+                      , begin_(0), end_(0), streamSize_(-1)
+                      , nbLinesFirst_(0), sizeFirst_(0)
+    {
+      // size of the remaining part of the stream, if any
+      std::streampos pos = is_.tellg();
+      if (pos != std::streampos(-1))
+      {
+        is_.seekg(0, std::ios::end);
+        std::streampos last = is_.tellg();
+        if (last != std::streampos(-1)) streamSize_ = double(last - pos);
+        is_.seekg(pos);
+      }
+      is_.clear();
+    }
+    /** get the next block of complete lines.
+     *  @param b,e the beginning and the end of the block
+     *  @return @c false if there is no more data to read
+     **/
+    bool next( Char const*& b, Char const*& e)
+    {
+      // move the incomplete line at the beginning of the buffer
+      const int remaining = end_ - begin_;
+      if (remaining > 0 && begin_ > 0)
+      { std::char_traits<Char>::move(&buffer_[0], &buffer_[begin_], remaining);}
+      end_ = remaining; begin_ = 0;
+      while (is_)
+      {
+        if (int(buffer_.size()) - end_ < blockSize_) buffer_.resize(end_ + blockSize_);
+        Char* start = &buffer_[0] + end_;
+        is_.read(start, blockSize_);
+        const int nb = int(is_.gcount());
+        end_ += nb;
+        // look for the last end of line read
+        Char const* p = start + nb;
+        while (p != start && *(p-1) != CHAR_NL) --p;
+        if (p != start) { return setBlock(int(p - &buffer_[0]), b, e);}
+      }
+      // last line without end of line
+      return (end_ > 0) ? setBlock(end_, b, e) : false;
+    }
+    /** @return an estimation of the number of lines of the stream, computed
+     *  using the size of the stream and the mean length of the lines in the
+     *  first block.
+     **/
+    inline int estimateNbLines() const
+    {
+      if (sizeFirst_ == 0) return 0;
+      if (streamSize_ < 0) return 2*nbLinesFirst_ + 16;
+      return int(std::min( (streamSize_ * nbLinesFirst_) / sizeFirst_ * 1.05 + 16.
+                         , double(std::numeric_limits<int>::max()/2)));
+    }
+
+  private:
+    /** the input stream */
+    istream& is_;
+    /** minimal number of characters to read at once */
+    int blockSize_;
+    /** the buffer */
+    std::vector<Char> buffer_;
+    /** beginning of the incomplete line */
+    int begin_;
+    /** end of the characters read */
+    int end_;
+    /** size of the stream, -1 if it is not known */
+    double streamSize_;
+    /** number of lines in the first block */
+    int nbLinesFirst_;
+    /** number of characters in the first block */
+    double sizeFirst_;
+    /** set the block [0, last) */
+    bool setBlock( int last, Char const*& b, Char const*& e)
+    {
+      b = &buffer_[0]; e = b + last;
+      begin_ = last;
+      if (sizeFirst_ == 0)
+      {
+        sizeFirst_ = last;
+        for (Char const* p = b; (p = std::char_traits<Char>::find(p, e - p, CHAR_NL)) != 0; ++p)
+        { ++nbLinesFirst_;}
+        if (nbLinesFirst_ == 0) nbLinesFirst_ = 1;
+      }
+      return true;
+    }
+};
+
+/** @ingroup DManager
+ *  @brief The Tokenizer class splits a block of characters in lines and
+ *  the lines in fields without copying them.
+ *
+ *  The blank characters are removed at the beginning and at the end of each
+ *  line (and a carriage return at the end of the line), empty lines are
+ *  skipped, and the blank spaces and tabulations are removed at the beginning
+ *  and at the end of each field.
+ **/
+class Tokenizer
+{
+  public:
+    /** constructor.
+     *  @param delimiters the characters separating the fields
+     **/
+    Tokenizer( String const& delimiters)
+             : delimiters_(delimiters)
+             , single_(delimiters.size() == 1 ? delimiters[0] : Char(0))
+             , isDelimiter_(256, false)
+    {
+      for (size_t k=0; k<delimiters_.size(); ++k)
+      {
+        const unsigned long c = (unsigned long)(delimiters_[k]);
+        if (c < 256) isDelimiter_[c] = true;
+      }
+    }
+    /** get the next non empty line of a block.
+     *  @param p the current position in the block, updated at the end of
+     *  the line found
+     *  @param end the end of the block
+     *  @param b,e the beginning and the end of the line found
+     *  @return @c false if there is no more line in the block
+     **/
+    bool nextLine( Char const*& p, Char const* end, Char const*& b, Char const*& e) const
+    {
+      while (p < end)
+      {
+        Char const* nl = std::char_traits<Char>::find(p, end - p, CHAR_NL);
+        b = p; e = nl ? nl : end;
+        p = nl ? nl + 1 : end;
+        if (e != b && *(e-1) == _T('\r')) --e;
+        while (b != e && *b == CHAR_BLANK) ++b;
+        while (e != b && *(e-1) == CHAR_BLANK) --e;
+        if (b != e) return true;
+      }
+      return false;
+    }
+    /** split a line in fields.
+     *  @param b,e the line
+     *  @param fields the fields of the line
+     *  @return the number of fields in the line
+     **/
+    int split( Char const* b, Char const* e, std::vector<Field>& fields) const
+    {
+      fields.clear();
+      while (true)
+      {
+        Char const* d = findDelimiter(b, e);
+        fields.push_back(trim(b, d));
+        if (d == e) break;
+        b = d + 1;
+      }
+      return int(fields.size());
+    }
+
+  private:
+    /** the delimiters */
+    String delimiters_;
+    /** the delimiter if there is only one delimiter, 0 otherwise */
+    Char single_;
+    /** lookup table of the delimiters */
+    std::vector<bool> isDelimiter_;
+    /** @return the position of the first delimiter in [b, e), e if none */
+    inline Char const* findDelimiter( Char const* b, Char const* e) const
+    {
+      if (single_)
+      {
+        Char const* d = std::char_traits<Char>::find(b, e - b, single_);
+        return d ? d : e;
+      }
+      for (; b != e; ++b)
+      {
+        const unsigned long c = (unsigned long)(*b);
+        if (c < 256 ? isDelimiter_[c] : (delimiters_.find(*b) != String::npos)) return b;
+      }
+      return e;
+    }
+    /** remove the blanks and tabulations before and after a field */
+    static inline Field trim( Char const* b, Char const* e)
+    {
+      while (b != e && (*b == CHAR_BLANK || *b == CHAR_TAB)) ++b;
+      while (e != b && (*(e-1) == CHAR_BLANK || *(e-1) == CHAR_TAB)) --e;
+      return Field(b, e);
+    }
+};
+
+/** @ingroup DManager
+ *  @brief Convert a field of a csv file to a value of type @c Type.
+ *
+ *  The conversion follows the rules of the input operator of the Proxy class:
+ *  the value is read at the beginning of the field and a NA value is returned
+ *  if the conversion fail. The conversion is successful if the field is the
+ *  NA string. The generic implementation use the @c stringToType function.
+ **/
+template<typename Type>
+struct FieldParser
+{
+  /** convert a field.
+   *  @param b,e the field
+   *  @param value the value of the field
+   *  @return @c true if the conversion is successful
+   **/
+  static inline bool parse( Char const* b, Char const* e, Type& value)
+  { return stringToType(value, String(b, e));}
+  /** @return the value of the field, NA if the conversion fail
+   *  @param b,e the field
+   **/
+  static inline Type parse( Char const* b, Char const* e)
+  { return stringToType<Type>(String(b, e));}
+};
+
+/** @ingroup DManager
+ *  Specialization for String: the value is the first word of the field.
+ **/
+template<>
+struct FieldParser<String>
+{
+  static inline bool parse( Char const* b, Char const* e, String& value)
+  { value = parse(b, e); return true;}
+  static inline String parse( Char const* b, Char const* e)
+  {
+    while (b != e && isSpace(*b)) ++b;
+    Char const* w = b;
+    while (w != e && !isSpace(*w)) ++w;
+    return isNaString(b, w) ? Arithmetic<String>::NA() : String(b, w);
+  }
+};
+
+/** @ingroup DManager
+ *  Specialization for Real. The number is converted with a locale-free
+ *  parser. If the mantissa is lower than 2^53 and the exponent is small,
+ *  the conversion is exact using a single multiplication or division,
+ *  otherwise it is delegated to a string stream using the classic locale.
+ **/
+template<>
+struct FieldParser<Real>
+{
+  static inline bool parse( Char const* b, Char const* e, Real& value)
+  { Char const* end; return parse(b, e, value, end);}
+  /** convert the number at the beginning of the field.
+   *  @param b,e the field
+   *  @param value the value of the field
+   *  @param end the end of the converted characters
+   *  @return @c true if the conversion is successful
+   **/
+  static bool parse( Char const* b, Char const* e, Real& value, Char const*& end)
+  {
+    while (b != e && isSpace(*b)) ++b;
+    end = b;
+    Char const* p = b;
+    bool neg = false;
+    if (p != e && (*p == _T('-') || *p == _T('+'))) { neg = (*p == _T('-')); ++p;}
+    // mantissa
+    unsigned long long m = 0;
+    int nbDigits = 0, nbSignificant = 0, exp10 = 0;
+    for (; p != e && *p >= _T('0') && *p <= _T('9'); ++p, ++nbDigits)
+    {
+      if (nbSignificant < 19) { m = 10*m + (*p - _T('0')); if (m) ++nbSignificant;}
+      else ++exp10;
+    }
+    if (p != e && *p == _T('.'))
+    {
+      for (++p; p != e && *p >= _T('0') && *p <= _T('9'); ++p, ++nbDigits)
+      {
+        if (nbSignificant < 19) { m = 10*m + (*p - _T('0')); --exp10; if (m) ++nbSignificant;}
+      }
+    }
+    if (nbDigits == 0) return parseNa(b, e, value, end);
+    // exponent
+    if (p != e && (*p == _T('e') || *p == _T('E')))
+    {
+      ++p;
+      bool negExp = false;
+      if (p != e && (*p == _T('-') || *p == _T('+'))) { negExp = (*p == _T('-')); ++p;}
+      if (p == e || *p < _T('0') || *p > _T('9')) { value = Arithmetic<Real>::NA(); return false;}
+      int x = 0;
+      for (; p != e && *p >= _T('0') && *p <= _T('9'); ++p) { if (x < 100000) x = 10*x + (*p - _T('0'));}
+      exp10 += negExp ? -x : x;
+    }
+    end = p;
+    static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10
+                                  , 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19
+                                  , 1e20, 1e21, 1e22};
+    if (m < (1ULL << 53) && exp10 >= -22 && exp10 <= 22)
+    {
+      double x = double(m);
+      x = (exp10 < 0) ? x / pow10[-exp10] : x * pow10[exp10];
+      value = Real(neg ? -x : x);
+      return true;
+    }
+    // slow path: the stream use the classic locale whatever is LC_NUMERIC
+    std::string str(p - b, ' ');
+    for (int k=0; k<int(p - b); ++k) str[k] = char(b[k]);
+    std::istringstream is(str);
+    is.imbue(std::locale::classic());
+    double x;
+    is >> x;
+    if (is.fail() || x < -std::numeric_limits<double>::max() || x > std::numeric_limits<double>::max())
+    { value = Arithmetic<Real>::NA(); return false;}
+    value = Real(x);
+    return true;
+  }
+  static inline Real parse( Char const* b, Char const* e)
+  { Real value; parse(b, e, value); return value;}
+  /** check if the field [b, e) begin with the NA string */
+  static inline bool parseNa( Char const* b, Char const* e, Real& value, Char const*& end)
+  {
+    value = Arithmetic<Real>::NA();
+    if ((e - b >= stringNaSize) && (stringNa.compare(0, stringNaSize, b, stringNaSize) == 0))
+    { end = b + stringNaSize; return true;}
+    return false;
+  }
+};
+
+/** @ingroup DManager
+ *  Specialization for Integer. The conversion fail in case of overflow.
+ **/
+template<>
+struct FieldParser<Integer>
+{
+  static bool parse( Char const* b, Char const* e, Integer& value)
+  {
+    while (b != e && isSpace(*b)) ++b;
+    Char const* p = b;
+    bool neg = false;
+    if (p != e && (*p == _T('-') || *p == _T('+'))) { neg = (*p == _T('-')); ++p;}
+    if (p == e || *p < _T('0') || *p > _T('9'))
+    {
+      value = Arithmetic<Integer>::NA();
+      return (e - b >= stringNaSize) && (stringNa.compare(0, stringNaSize, b, stringNaSize) == 0);
+    }
+    long long x = 0;
+    const long long maxValue = (long long)(std::numeric_limits<Integer>::max()) + (neg ? 1 : 0);
+    for (; p != e && *p >= _T('0') && *p <= _T('9'); ++p)
+    {
+      x = 10*x + (*p - _T('0'));
+      if (x > maxValue) { value = Arithmetic<Integer>::NA(); return false;}
+    }
+    value = Integer(neg ? -x : x);
+    return true;
+  }
+  static inline Integer parse( Char const* b, Char const* e)
+  { Integer value; parse(b, e, value); return value;}
+};
+
+/** @ingroup DManager
+ *  move the value @c src in @c dst. For String, the values are swapped in
+ *  order to avoid a copy.
+ **/
+template<typename Type>
+inline void moveValue( Type& src, Type& dst) { dst = src;}
+/** @ingroup DManager
+ *  Specialization for String.
+ **/
+inline void moveValue( String& src, String& dst) { dst.swap(src);}
+
+/** @ingroup DManager
+ *  @return @c true if the value can be used in a numeric column. The
+ *  generic implementation return always @c true.
+ *  @param value the value to check
+ **/
+template<typename Type>
+inline bool isNumericValue( Type const&) { return true;}
+/** @ingroup DManager
+ *  Specialization for String: the value is numeric if it is NA or if the
+ *  whole value (up to trailing spaces) can be converted in Real, so that a
+ *  value like "2016-01-05" is not numeric.
+ **/
+inline bool isNumericValue( String const& value)
+{
+  if (Arithmetic<String>::isNA(value) || value == stringNa) return true;
+  Real x;
+  Char const *end, *e = value.data() + value.size();
+  if (!FieldParser<Real>::parse(value.data(), e, x, end)) return false;
+  while (end != e && isSpace(*end)) ++end;
+  return end == e;
+}
+
+/** @ingroup DManager
+ *  @brief The Dictionary class interns the distinct fields of a column.
+ *
+ *  Each distinct String gets a code in [0, size()) in the order of its first
+ *  occurrence. The codes are found using an open addressing hash table, so
+ *  that a field is interned with one hash and usually one comparison.
+ **/
+class Dictionary
+{
+  public:
+    /** default constructor */
+    Dictionary() : mask_(0) {}
+    /** @return the number of distinct values */
+    inline int size() const { return int(values_.size());}
+    /** @return the value with the code @c code */
+    inline String const& value( int code) const { return values_[code];}
+    /** @return the distinct values in the order of their codes */
+    inline std::vector<String> const& values() const { return values_;}
+    /** @return the code of a value, the value is added if it is not found
+     *  @param b,e the value to intern
+     **/
+    int intern( Char const* b, Char const* e)
+    {
+      if (2 * (values_.size() + 1) > table_.size()) grow();
+      const unsigned int h = hash(b, e);
+      size_t pos = h & mask_;
+      for (int code; (code = table_[pos]) >= 0; pos = (pos + 1) & mask_)
+      {
+        String const& v = values_[code];
+        if ( hashes_[code] == h && v.size() == size_t(e - b)
+          && std::char_traits<Char>::compare(v.data(), b, e - b) == 0
+           ) return code;
+      }
+      table_[pos] = size();
+      values_.push_back(String(b, e));
+      hashes_.push_back(h);
+      return table_[pos];
+    }
+    /** @return the code of a value, the value is added if it is not found
+     *  @param s the value to intern
+     **/
+    inline int intern( String const& s) { return intern(s.data(), s.data() + s.size());}
+    /** remove all the values */
+    void clear()
+    { table_.clear(); values_.clear(); hashes_.clear(); mask_ = 0;}
+
+  private:
+    /** the hash table: code of the values, -1 for the empty slots */
+    std::vector<int> table_;
+    /** the distinct values */
+    std::vector<String> values_;
+    /** the hash of the distinct values */
+    std::vector<unsigned int> hashes_;
+    /** size of the hash table minus one */
+    size_t mask_;
+    /** @return the FNV-1a hash of [b, e) */
+    static inline unsigned int hash( Char const* b, Char const* e)
+    {
+      unsigned int h = 2166136261u;
+      for (; b != e; ++b) { h = (h ^ (unsigned char)(*b)) * 16777619u;}
+      return h;
+    }
+    /** double the size of the hash table */
+    void grow()
+    {
+      const size_t size = std::max(size_t(16), 2 * table_.size());
+      table_.assign(size, -1);
+      mask_ = size - 1;
+      for (int code = 0; code < this->size(); ++code)
+      {
+        size_t pos = hashes_[code] & mask_;
+        while (table_[pos] >= 0) { pos = (pos + 1) & mask_;}
+        table_[pos] = code;
+      }
+    }
+};
+
+/** @ingroup DManager
+ *  @brief The ChunkParser class parses a chunk of complete lines of a csv
+ *  file and store the values in one buffer by column.
+ *
+ *  The chunks of a file can be parsed in parallel by different instances
+ *  and the columns of the chunks stitched together in the order of the
+ *  chunks. Each buffer contains the same number of values, the missing
+ *  fields being NA. For the String type, the parser also checks if all the
+ *  values of a column can be converted in Real (the NA values being
+ *  accepted), so that the type of the columns of the whole file is the
+ *  logical and of the types of the columns in each chunk.
+ *
+ *  If the chunk is encoded, the fields are not converted: each column has
+ *  a Dictionary of its distinct fields and a buffer of codes (-1 for the
+ *  missing fields), the conversion (or the mapping) of the distinct fields
+ *  and the numeric checks are left to the caller.
+ **/
+template<typename Type>
+class ChunkParser
+{
+  public:
+    /** constructor.
+     *  @param tokenizer the tokenizer to use
+     *  @param encode @c true if the fields have to be encoded
+     **/
+    ChunkParser( Tokenizer const& tokenizer, bool encode = false)
+               : p_tokenizer_(&tokenizer), encode_(encode), nbRows_(0)
+    {}
+    /** @return the number of rows of the chunk */
+    inline int nbRows() const { return nbRows_;}
+    /** @return the number of columns of the chunk */
+    inline int nbCols() const { return int(numeric_.size());}
+    /** @return @c true if the fields are encoded */
+    inline bool isEncoded() const { return encode_;}
+    /** @return the buffer of the column j */
+    inline std::vector<Type>& col(int j) { return cols_[j];}
+    /** @return the codes of the column j (encoded chunk) */
+    inline std::vector<int> const& codes(int j) const { return codes_[j];}
+    /** @return the distinct fields of the column j (encoded chunk) */
+    inline Dictionary const& dictionary(int j) const { return dicts_[j];}
+    /** @return @c true if all the values of the column j are numeric or NA */
+    inline bool isNumeric(int j) const { return numeric_[j];}
+    /** parse the lines in [b, e).
+     *  @param b,e the chunk to parse
+     **/
+    void parse( Char const* b, Char const* e)
+    {
+      Char const *lb, *le;
+      size_t reserve = 0;
+      while (p_tokenizer_->nextLine(b, e, lb, le))
+      {
+        const int nbField = p_tokenizer_->split(lb, le, fields_);
+        // estimate the number of lines of the chunk using the first line
+        if (nbRows_ == 0) { reserve = size_t(e - lb) / size_t(le - lb + 1) + 1;}
+        // add new columns
+        for (int j=nbCols(); j<nbField; ++j)
+        {
+          if (encode_)
+          {
+            codes_.push_back(std::vector<int>(nbRows_, -1));
+            codes_.back().reserve(std::max(reserve, size_t(nbRows_)));
+            dicts_.push_back(Dictionary());
+          }
+          else
+          {
+            cols_.push_back(std::vector<Type>(nbRows_, Arithmetic<Type>::NA()));
+            cols_.back().reserve(std::max(reserve, size_t(nbRows_)));
+          }
+          numeric_.push_back(true);
+        }
+        if (encode_)
+        {
+          for (int j=0; j<nbField; ++j)
+          { codes_[j].push_back(dicts_[j].intern(fields_[j].first, fields_[j].second));}
+          for (int j=nbField; j<nbCols(); ++j) { codes_[j].push_back(-1);}
+        }
+        else
+        {
+          for (int j=0; j<nbField; ++j)
+          {
+            cols_[j].push_back(FieldParser<Type>::parse(fields_[j].first, fields_[j].second));
+            if (numeric_[j]) numeric_[j] = isNumericValue(cols_[j].back());
+          }
+          for (int j=nbField; j<nbCols(); ++j) { cols_[j].push_back(Arithmetic<Type>::NA());}
+        }
+        ++nbRows_;
+      }
+    }
+
+  private:
+    /** the tokenizer */
+    Tokenizer const* p_tokenizer_;
+    /** @c true if the fields are encoded */
+    bool encode_;
+    /** number of rows */
+    int nbRows_;
+    /** the fields of the current line */
+    std::vector<Field> fields_;
+    /** the columns */
+    std::vector< std::vector<Type> > cols_;
+    /** the codes of the columns (encoded chunk) */
+    std::vector< std::vector<int> > codes_;
+    /** the distinct fields of the columns (encoded chunk) */
+    std::vector<Dictionary> dicts_;
+    /** the numeric flags of the columns */
+    std::vector<bool> numeric_;
+};
+
+/** @ingroup DManager
+ *  split a block of lines in chunks ending at an end of line.
+ *  @param b,e the block
+ *  @param nbChunk the maximal number of chunks
+ *  @param limits the limits of the chunks
+ **/
+inline void splitBlock( Char const* b, Char const* e, int nbChunk, std::vector<Char const*>& limits)
+{
+  limits.assign(1, b);
+  for (int k=1; k<nbChunk; ++k)
+  {
+    Char const* p = b + ((e - b) * k) / nbChunk;
+    if (p <= limits.back()) continue;
+    Char const* nl = std::char_traits<Char>::find(p, e - p, CHAR_NL);
+    if (!nl) break;
+    limits.push_back(nl + 1);
+  }
+  if (limits.back() != e) limits.push_back(e);
+}
+
+/** @ingroup DManager
+ *  @return the value of the String @c s, NA if the conversion fail
+ *  @param s the String to convert
+ **/
+template<typename Type>
+inline Type parseField( String const& s)
+{ return FieldParser<Type>::parse(s.data(), s.data() + s.size());}
+
+/** @ingroup DManager
+ *  convert the String @c s.
+ *  @param s the String to convert
+ *  @param value the value of the String
+ *  @return @c true if the conversion is successful
+ **/
+template<typename Type>
+inline bool parseField( String const& s, Type& value)
+{ return FieldParser<Type>::parse(s.data(), s.data() + s.size(), value);}
+
+} // namespace Csv
+
+} // namespace STK
+
+#endif /* STK_CSVPARSER_H */
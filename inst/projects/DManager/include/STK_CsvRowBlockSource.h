@@ -0,0 +1,117 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::DManager
+ * Purpose:  Declaration of the class CsvRowBlockSource.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_CsvRowBlockSource.h
+ *  @brief In this file we define the class CsvRowBlockSource.
+ **/
+
+#ifndef STK_CSVROWBLOCKSOURCE_H
+#define STK_CSVROWBLOCKSOURCE_H
+
+#include <vector>
+
+#include "STK_IRowBlockSource.h"
+#include "STK_ReadWriteCsv.h"
+
+namespace STK
+{
+
+/** @ingroup DManager
+ *  @brief Implementation of the IRowBlockSource interface for a csv file.
+ *
+ *  The file is read incrementally: only the characters of the current lines
+ *  and the current block of rows are stored in memory. The number of columns
+ *  is given by the first line of the file, the missing fields and the
+ *  fields which cannot be converted in Real are NA, the additional fields
+ *  are ignored.
+ **/
+class CsvRowBlockSource : public IRowBlockSource
+{
+  public:
+    /** constructor.
+     *  @param fileName the name of the csv file
+     *  @param withNames @c true if the first line contains the names of the
+     *  columns
+     *  @param delimiters the delimiters of the fields
+     *  @param blockSize the number of rows of the blocks
+     **/
+    CsvRowBlockSource( std::string const& fileName
+                     , bool withNames = Csv::DEFAULT_READNAMES
+                     , String const& delimiters = Csv::DEFAULT_DELIMITER
+                     , int blockSize = 4096
+                     );
+    /** destructor */
+    virtual ~CsvRowBlockSource();
+    /** @return the names of the columns (empty if the file has no names) */
+    inline std::vector<String> const& names() const { return names_;}
+    /** @return the number of columns of the data set */
+    virtual int nbCols() const { return nbCols_;}
+    /** go back to the first row of the file */
+    virtual bool rewind();
+    /** get the next block of rows.
+     *  @param block the block of rows
+     *  @return @c false if there is no more rows
+     **/
+    virtual bool next( CArrayXX& block);
+
+  private:
+    /** name of the file */
+    std::string fileName_;
+    /** @c true if the first line contains the names */
+    bool withNames_;
+    /** the tokenizer */
+    Csv::Tokenizer tokenizer_;
+    /** the file */
+    ifstream file_;
+    /** the reader of the file */
+    Csv::BlockReader* p_reader_;
+    /** the current position in the characters read */
+    Char const* p_;
+    /** the end of the characters read */
+    Char const* end_;
+    /** number of columns */
+    int nbCols_;
+    /** position of the next row to read */
+    int position_;
+    /** names of the columns */
+    std::vector<String> names_;
+    /** fields of the current line */
+    std::vector<Csv::Field> fields_;
+    /** get the next line of the file
+     *  @param b,e the line found
+     *  @return @c false if there is no more line
+     **/
+    bool nextLine( Char const*& b, Char const*& e);
+};
+
+} // namespace STK
+
+#endif /* STK_CSVROWBLOCKSOURCE_H */
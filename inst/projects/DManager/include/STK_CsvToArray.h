@@ -67,7 +67,7 @@ struct CsvToArrayImpl<String, Array2D<OtherType> >
     {
       if ( (rw.var(jVar).nbMiss()/Real(rw.var(jVar).size())) <= propMiss)
       for (int i =p_data->beginRows(); i<= p_data->lastIdxRows(); ++i)
-      { p_data->elt(i, jCol) = stringToType<OtherType>(rw(i,jVar));}
+      { p_data->elt(i, jCol) = Csv::parseField<OtherType>(rw.var(jVar).elt(i));}
       jCol++;
     }
   }
@@ -0,0 +1,259 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::DManager
+ * Purpose:  Declaration of the class CsvWriter.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_CsvWriter.h
+ *  @brief In this file we define the class CsvWriter writing numeric arrays
+ *  and DataFrame in csv files without intermediary String containers.
+ **/
+
+#ifndef STK_CSVWRITER_H
+#define STK_CSVWRITER_H
+
+#include <vector>
+
+#include "STK_ExportToCsv.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace STK
+{
+
+namespace Csv
+{
+/** @ingroup DManager
+ *  @brief Append the text of a value at the end of a buffer.
+ *
+ *  The NA values are written using the NA string. The generic implementation
+ *  use the @c typeToString function.
+ **/
+template<typename Type>
+struct FieldFormatter
+{
+  /** append a value.
+   *  @param x the value to write
+   *  @param buffer the buffer to fill
+   **/
+  static inline void append( Type const& x, String& buffer)
+  { buffer += Arithmetic<Type>::isNA(x) ? stringNa : typeToString(x);}
+};
+
+/** @ingroup DManager
+ *  Specialization for String.
+ **/
+template<>
+struct FieldFormatter<String>
+{
+  static inline void append( String const& x, String& buffer)
+  { buffer += Arithmetic<String>::isNA(x) ? stringNa : x;}
+};
+
+/** @ingroup DManager
+ *  Specialization for Integer. The digits are computed directly.
+ **/
+template<>
+struct FieldFormatter<Integer>
+{
+  static inline void append( Integer const& x, String& buffer)
+  {
+    if (Arithmetic<Integer>::isNA(x)) { buffer += stringNa; return;}
+    Char str[24];
+    buffer.append(str, formatInteger((long long)x, str));
+  }
+  /** write an integer in a buffer.
+   *  @param x the value to write
+   *  @param str a buffer of size at least 21
+   *  @return the number of characters written
+   **/
+  static int formatInteger( long long x, Char* str)
+  {
+    Char digits[24];
+    int n = 0;
+    unsigned long long u = (x < 0) ? 0ULL - (unsigned long long)x : (unsigned long long)x;
+    do { digits[n++] = Char(_T('0') + int(u % 10)); u /= 10;} while (u);
+    int k = 0;
+    if (x < 0) str[k++] = _T('-');
+    while (n) str[k++] = digits[--n];
+    return k;
+  }
+};
+
+/** @ingroup DManager
+ *  Specialization for Real. The digits are computed using the Grisu2
+ *  algorithm: the representation is the shortest one (or very close to it)
+ *  which is read back without loss by FieldParser<Real>.
+ **/
+template<>
+struct FieldFormatter<Real>
+{
+  static inline void append( Real const& x, String& buffer)
+  {
+    if (Arithmetic<Real>::isNA(x)) { buffer += stringNa; return;}
+    Char str[32];
+    buffer.append(str, format(x, str));
+  }
+  /** write a real in a buffer.
+   *  @param x the value to write
+   *  @param str a buffer of size at least 32
+   *  @return the number of characters written
+   **/
+  static int format( Real x, Char* str);
+};
+
+} // namespace Csv
+
+/** @ingroup DManager
+ *  @brief The CsvWriter class writes numeric arrays and DataFrame in a csv
+ *  file.
+ *
+ *  The values are formatted by the Csv::FieldFormatter classes in large
+ *  buffers, each buffer containing a chunk of rows. The chunks are formatted
+ *  in parallel and written in order. Successive calls to @c write append
+ *  rows to the file, the names of the columns are written by the first call.
+ *  Unlike TReadWriteCsv::write, the fields are not aligned.
+ *  @code
+ *  CsvWriter writer("tik.csv");
+ *  if (!writer.write(tik, _T("Cluster"))) { stk_cerr << writer.error();}
+ *  @endcode
+ **/
+class CsvWriter
+{
+  public:
+    /** constructor. Open the file.
+     *  @param fileName name of the file to write
+     *  @param withNames @c true if the names of the columns have to be written
+     *  @param delimiter the delimiter of the fields
+     **/
+    CsvWriter( std::string const& fileName
+             , bool withNames = Csv::DEFAULT_READNAMES
+             , String const& delimiter = Csv::DEFAULT_DELIMITER
+             );
+    /** destructor. Close the file if needed. */
+    ~CsvWriter();
+    /** @return @c true if the file is opened */
+    inline bool isOpen() const { return file_.is_open();}
+    /** @return the last error message */
+    inline String const& error() const { return msg_error_;}
+    /** @return the number of rows of each chunk */
+    inline int chunkSize() const { return chunkSize_;}
+    /** @param chunkSize the number of rows of each chunk */
+    inline void setChunkSize( int chunkSize) { chunkSize_ = std::max(chunkSize, 1);}
+    /** write the rows of an array.
+     *  @param a the array to write
+     *  @param prefix the prefix of the names of the columns
+     **/
+    template<class Array>
+    bool write( ExprBase<Array> const& a, String const& prefix = Csv::DEFAULT_COLUMN_PREFIX);
+    /** write the rows of a DataFrame. The Real, Integer and String variables
+     *  are written directly, the other variables are converted in String.
+     *  @param df the DataFrame to write
+     **/
+    bool write( DataFrame const& df);
+    /** close the file.
+     *  @return @c false if an error occur
+     **/
+    bool close();
+
+  private:
+    /** the file */
+    ofstream file_;
+    /** write the names of the columns ? */
+    bool withNames_;
+    /** the delimiter of the fields */
+    Char delimiter_;
+    /** number of rows of each chunk */
+    int chunkSize_;
+    /** buffers of the chunks */
+    std::vector<String> buffers_;
+    /** last error message */
+    String msg_error_;
+    /** check the file and write the names if needed.
+     *  @param names the names of the columns
+     **/
+    bool writeHeader( std::vector<String> const& names);
+    /** write the buffers [0, nb) in the file */
+    bool flush( int nb);
+    /** format the rows [first, last) of an array.
+     *  @param a the array to format
+     *  @param first,last the rows to format
+     *  @param buffer the buffer to fill
+     **/
+    template<class Array>
+    void formatRows( Array const& a, int first, int last, String& buffer) const
+    {
+      typedef typename Array::Type Type;
+      for (int i=first; i<last; ++i)
+      {
+        for (int j=a.beginCols(); j<a.endCols(); ++j)
+        {
+          if (j != a.beginCols()) buffer += delimiter_;
+          Csv::FieldFormatter<Type>::append(a.elt(i, j), buffer);
+        }
+        buffer += CHAR_NL;
+      }
+    }
+    /** format the rows [first, last) of the variables of a DataFrame.
+     *  @param vars the variables to format
+     *  @param first,last the rows to format (starting at 0)
+     *  @param buffer the buffer to fill
+     **/
+    void formatRows( std::vector<IVariable const*> const& vars, int first, int last, String& buffer) const;
+};
+
+template<class Array>
+bool CsvWriter::write( ExprBase<Array> const& a, String const& prefix)
+{
+  std::vector<String> names;
+  for (int j=a.beginCols(); j<a.endCols(); ++j) { names.push_back(prefix + typeToString(j));}
+  if (!writeHeader(names)) return false;
+  Array const& array = a.asDerived();
+  const int nbBuffer = int(buffers_.size());
+  for (int first = a.beginRows(); first < a.endRows(); first += nbBuffer * chunkSize_)
+  {
+    const int nb = std::min(nbBuffer, (a.endRows() - first + chunkSize_ - 1)/chunkSize_);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (double(a.sizeRows())*a.sizeCols() > ParallelThreshold)
+#endif
+    for (int k=0; k<nb; ++k)
+    {
+      const int begin = first + k * chunkSize_;
+      buffers_[k].clear();
+      formatRows(array, begin, std::min(begin + chunkSize_, a.endRows()), buffers_[k]);
+    }
+    if (!flush(nb)) return false;
+  }
+  return true;
+}
+
+} // namespace STK
+
+#endif /* STK_CSVWRITER_H */
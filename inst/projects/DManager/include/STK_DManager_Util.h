@@ -86,6 +86,8 @@ enum TypeDataFile
   unknown_ =0
   /** comma separated files */
   , csv_
+  /** binary columnar files (BinaryWriter and BinaryReader) */
+  , binary_
 };
 
 /** @ingroup DManager
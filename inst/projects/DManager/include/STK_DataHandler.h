@@ -40,6 +40,7 @@
 
 #include "STK_DataHandlerBase.h"
 #include "STK_ReadWriteCsv.h"
+#include "STK_DataFrame.h"
 #include "Arrays/include/STK_Array2D.h"
 
 namespace STK
@@ -58,13 +59,127 @@ struct DataHandlerTraits<DataHandler, Type>
   typedef Array2D<Type> Data;
 };
 
+/** @ingroup hidden
+ *  The DataHandlerStorage class give the type used by the DataHandler for
+ *  storing the columns of a given Type. By default the columns are stored
+ *  as String.
+ **/
+template<typename Type>
+struct DataHandlerStorage
+{ typedef String Type_;};
+/** @ingroup hidden
+ *  Specialization for Real.
+ **/
+template<>
+struct DataHandlerStorage<Real>
+{ typedef Real Type_;};
+/** @ingroup hidden
+ *  Specialization for Integer.
+ **/
+template<>
+struct DataHandlerStorage<Integer>
+{ typedef Integer Type_;};
+
+/** @ingroup hidden
+ *  The DataHandlerCast class convert a stored value in an other Type. The NA
+ *  values are preserved.
+ **/
+template<typename From, typename To>
+struct DataHandlerCast
+{
+  static inline To run(From const& x)
+  { return Arithmetic<From>::isNA(x) ? Arithmetic<To>::NA() : static_cast<To>(x);}
+};
+/** @ingroup hidden
+ *  Specialization for the conversion of a Real in an Integer. The
+ *  non-representable values are NA.
+ **/
+template<>
+struct DataHandlerCast<Real, Integer>
+{
+  static inline Integer run(Real const& x)
+  {
+    return (Arithmetic<Real>::isNA(x) || !(std::abs(x) <= std::numeric_limits<Integer>::max()))
+           ? Arithmetic<Integer>::NA() : static_cast<Integer>(x);
+  }
+};
+/** @ingroup hidden
+ *  Specialization when there is nothing to convert.
+ **/
+template<typename Type>
+struct DataHandlerCast<Type, Type>
+{ static inline Type const& run(Type const& x) { return x;}};
+/** @ingroup hidden
+ *  Specialization for the conversion in a String.
+ **/
+template<typename From>
+struct DataHandlerCast<From, String>
+{ static inline String run(From const& x) { return typeToString(x, std::scientific);}};
+/** @ingroup hidden
+ *  Specialization for the conversion of a String.
+ **/
+template<typename To>
+struct DataHandlerCast<String, To>
+{ static inline To run(String const& x) { return Csv::parseField<To>(x);}};
+/** @ingroup hidden
+ *  Specialization for String.
+ **/
+template<>
+struct DataHandlerCast<String, String>
+{ static inline String const& run(String const& x) { return x;}};
+
+/** @ingroup hidden
+ *  copy a stored column in the column @c j of an array.
+ *  @param var the stored column (a Variable<From>)
+ *  @param data the array to fill
+ *  @param j the column of the array to fill
+ **/
+template<typename From, typename Type>
+void copyVariable( IVariable const& var, Array2D<Type>& data, int j)
+{
+  Variable<From> const& v = static_cast<Variable<From> const&>(var);
+  for (int i = v.begin(), id = data.beginRows(); i <= v.lastIdx(); ++i, ++id)
+  { data(id, j) = DataHandlerCast<From, Type>::run(v.elt(i));}
+}
+
+/** @ingroup hidden
+ *  The DataHandlerCodes class copy the codes of an encoded column of String
+ *  in the column @c j of an array. By default the codes are not used.
+ **/
+template<typename Type>
+struct DataHandlerCodes
+{ static inline bool run( IVariable const&, Array2D<Type>&, int) { return false;}};
+/** @ingroup hidden
+ *  Specialization for Integer: the categorical columns are given by their
+ *  codes.
+ **/
+template<>
+struct DataHandlerCodes<Integer>
+{
+  static bool run( IVariable const& var, Array2D<Integer>& data, int j)
+  {
+    Variable<String> const& v = static_cast<Variable<String> const&>(var);
+    if (!v.isEncoded()) return false;
+    for (int i = v.begin(), id = data.beginRows(); i <= v.lastIdx(); ++i, ++id)
+    { data(id, j) = v.code(i);}
+    return true;
+  }
+};
+
 } // namespace hidden
 
 /** @ingroup DManager
  *  @c implementation of the DataHandlerBase class using ReadWriteCsv and Array2D.
  *  The DataHandler class allow to read various csv files with their description
  *  files and to get the columns identified by an idData in an @c Array2D.
- *  All data are stored in memory in a ReadWriteCsv structure.
+ *
+ *  All data are stored in memory in a DataFrame. The type of each column is
+ *  decided when the data are read: the columns with only integer values are
+ *  stored in a Variable<Integer>, the other numeric columns in a
+ *  Variable<Real> and the remaining columns are kept in a Variable<String>.
+ *  The missing values are stored using the NA value of each type. The
+ *  String columns are encoded: when they are requested as Integer, the
+ *  codes of their distinct values are returned.
  */
 class DataHandler : public DataHandlerBase<DataHandler>
 {
@@ -72,15 +187,15 @@ class DataHandler : public DataHandlerBase<DataHandler>
     typedef DataHandlerBase<DataHandler>::InfoMap InfoMap;
     /** default constructor */
     inline DataHandler() : DataHandlerBase(), withNames_(false)
-    { data_.setWithNames(false); descriptor_.setWithNames(false);}
+    { descriptor_.setWithNames(false);}
     /** destructor */
     inline ~DataHandler() {}
     /** @return the number of sample (the number of rows of the data) */
     inline int nbSampleImpl() const { return data_.sizeRows();}
     /** @return the number of sample (the number of columns of the data) */
-    inline int nbVariableImpl() const { return data_.size();}
+    inline int nbVariableImpl() const { return data_.sizeCols();}
     /** get the whole data set */
-    inline ReadWriteCsv const& data() const { return data_;}
+    inline DataFrame const& data() const { return data_;}
     /** get the whole descriptor set */
     inline ReadWriteCsv const& descriptor() const { return descriptor_;}
     /** set withNames flag */
@@ -95,10 +210,8 @@ class DataHandler : public DataHandlerBase<DataHandler>
      **/
     bool readDataFromCsvFile(std::string const& datafile, std::string const& idData, std::string const& idModel);
     /** @brief read a data set from an Array2D.
-     * This method should be essentially used:
-     * - for testing some statistical method as the data  will be converted in a
-     * String format (whcih is not an efficient way to store the data..).
-     * - if the data are already stored in a String format.
+     * The Real and Integer data are stored as is, the other types are
+     * converted in a String format.
      * @param data the data set
      * @param idData the id of the data
      * @param idModel an id identifying the model to use with the data set
@@ -106,10 +219,8 @@ class DataHandler : public DataHandlerBase<DataHandler>
     template<typename Type>
     bool readDataFromArray2D(Array2D<Type> const& data, std::string const& idData, std::string const& idModel);
     /** @brief read a data set from an Array or Expression.
-     * This method should be essentially used:
-     * - for testing some statistical method as the data  will be converted in a
-     * String format (whcih is not an efficient way to store the data..).
-     * - if the data are already stored in a String format.
+     * The Real and Integer data are stored as is, the other types are
+     * converted in a String format.
      * @param data the data set
      * @param idData the id of the data
      * @param idModel an id identifying the model to use with the data set
@@ -128,12 +239,31 @@ class DataHandler : public DataHandlerBase<DataHandler>
      *  @param idData id of the data to get
      **/
     std::vector<int> colIndex(std::string const& idData) const;
+    /** convert the columns of a ReadWriteCsv in typed variables and append
+     *  them to the data.
+     *  @param rw the columns to append
+     *  @return @c false if an error occur
+     **/
+    bool appendData(ReadWriteCsv const& rw);
+    /** convert a column of String in a typed variable.
+     *  @param column the column to convert
+     *  @param isNumeric the numeric flag of the column (1 if it is numeric, 0
+     *  if it is not and -1 if it is unknown)
+     *  @return a Variable<Integer> if all the values are integers,
+     *  a Variable<Real> if all the values are numeric and an encoded copy of
+     *  the column otherwise.
+     **/
+    static IVariable* parseVariable(Variable<String> const& column, int isNumeric);
+    /** @return an encoded copy of a column of String
+     *  @param column the column to copy
+     **/
+    static IVariable* encodeVariable(Variable<String> const& column);
 
   private:
     /** first line with names ?*/
     bool withNames_;
     /** data files */
-    ReadWriteCsv data_;
+    DataFrame data_;
     /** descriptor files with two rows. On the first row we get the idModel,
      * on the second row, we get the idData
      **/
@@ -154,11 +284,22 @@ void DataHandler::getData(std::string const& idData, Array2D<Type>& data, int& n
 #endif
   nbVariable = indexes.size();
   data.resize(nbSample(), nbVariable);
-  int j= data.beginCols();
-  for (std::vector<int>::const_iterator it = indexes.begin(); it != indexes.end(); ++it, ++j)
+#ifdef _OPENMP
+#pragma omp parallel for if (double(nbSample()) * nbVariable > ParallelThreshold)
+#endif
+  for (int k = 0; k < nbVariable; ++k)
   {
-    for (int i = data_.firstRow(*it); i <= data_.lastRow(*it); ++i)
-    { data(i, j) = STK::stringToType<Type>(data_(i,*it));}
+    IVariable const& var = *data_.elt(indexes[k]);
+    const int j = data.beginCols() + k;
+    switch (var.getType())
+    {
+      case Base::real_:    hidden::copyVariable<Real>(var, data, j); break;
+      case Base::integer_: hidden::copyVariable<Integer>(var, data, j); break;
+      default:
+        if (!hidden::DataHandlerCodes<Type>::run(var, data, j))
+        { hidden::copyVariable<String>(var, data, j);}
+        break;
+    }
   }
 }
 
@@ -171,13 +312,14 @@ bool DataHandler::readDataFromArray2D( Array2D<Type> const& data
   Variable<std::string> desc(2);
   desc[baseIdx] = idModel ; desc[baseIdx+1] = idData;
   if (!addInfo(idData, idModel)) return false;
-  // store data at the end of the ReadWriteCsv array in a string format
+  typedef typename hidden::DataHandlerStorage<Type>::Type_ Storage;
+  // store data at the end of the DataFrame
   for (int j=data.beginCols(); j<= data.lastIdxCols(); ++j)
   {
-    data_.push_back();
-    data_.back().resize(data.rows());
+    Variable<Storage>* p_var = new Variable<Storage>(data.rows());
     for (int i= data.beginRows(); i < data.endRows(); ++i)
-    { data_.back()[i] = typeToString(data(i,j), std::scientific);}
+    { p_var->elt(i) = hidden::DataHandlerCast<Type, Storage>::run(data(i,j));}
+    data_.pushBackVariable(p_var);
     // store descriptor : this is the same for all the columns added
     descriptor_.push_back(desc);
   }
@@ -193,13 +335,15 @@ bool DataHandler::readDataFromArray( ExprBase<Array> const& data
   Variable<std::string> desc(2);
   desc[baseIdx] = idModel ; desc[baseIdx+1] = idData;
   if (!addInfo(idData, idModel)) return false;
-  // store data at the end of the ReadWriteCsv array in a string format
+  typedef typename Array::Type Type;
+  typedef typename hidden::DataHandlerStorage<Type>::Type_ Storage;
+  // store data at the end of the DataFrame
   for (int j=data.beginCols(); j<= data.lastIdxCols(); ++j)
   {
-    data_.push_back();
-    data_.back().resize(data.rows());
+    Variable<Storage>* p_var = new Variable<Storage>(data.rows());
     for (int i= data.beginRows(); i < data.endRows(); ++i)
-    { data_.back()[i] = typeToString(data.elt(i,j), std::scientific);}
+    { p_var->elt(i) = hidden::DataHandlerCast<Type, Storage>::run(data.elt(i,j));}
+    data_.pushBackVariable(p_var);
     // store descriptor : this is the same for all the columns added
     descriptor_.push_back(desc);
   }
@@ -0,0 +1,105 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::DManager
+ * Purpose:  Functions exporting arrays and DataFrame in files.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_ExportToFile.h
+ *  @brief In this file we define the functions exportToFile writing an array
+ *  or a DataFrame in a csv file or in a binary columnar file.
+ **/
+
+#ifndef STK_EXPORTTOFILE_H
+#define STK_EXPORTTOFILE_H
+
+#include "STK_CsvWriter.h"
+#include "STK_BinaryColumns.h"
+
+namespace STK
+{
+
+/** @ingroup DManager
+ *  Write a numeric array in a file.
+ *  @param fileName the name of the file
+ *  @param a the array to write
+ *  @param type the format of the file (csv_ or binary_)
+ *  @param prefix the prefix of the names of the columns
+ *  @return @c false if an error occur
+ **/
+template<class Array>
+bool exportToFile( std::string const& fileName, ExprBase<Array> const& a
+                 , DManager::TypeDataFile type = DManager::csv_
+                 , String const& prefix = Csv::DEFAULT_COLUMN_PREFIX)
+{
+  switch (type)
+  {
+    case DManager::csv_:
+    {
+      CsvWriter writer(fileName);
+      return writer.write(a, prefix) && writer.close();
+    }
+    case DManager::binary_:
+    {
+      BinaryWriter writer(fileName);
+      return writer.write(a, prefix) && writer.close();
+    }
+    default:
+      return false;
+  }
+}
+
+/** @ingroup DManager
+ *  Write a DataFrame in a file.
+ *  @param fileName the name of the file
+ *  @param df the DataFrame to write
+ *  @param type the format of the file (csv_ or binary_)
+ *  @return @c false if an error occur
+ **/
+inline bool exportToFile( std::string const& fileName, DataFrame const& df
+                        , DManager::TypeDataFile type = DManager::csv_)
+{
+  switch (type)
+  {
+    case DManager::csv_:
+    {
+      CsvWriter writer(fileName);
+      return writer.write(df) && writer.close();
+    }
+    case DManager::binary_:
+    {
+      BinaryWriter writer(fileName);
+      return writer.write(df) && writer.close();
+    }
+    default:
+      return false;
+  }
+}
+
+} // namespace STK
+
+#endif /* STK_EXPORTTOFILE_H */
@@ -0,0 +1,197 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::DManager
+ * Purpose:  Declaration of the interface class IRowBlockSource.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_IRowBlockSource.h
+ *  @brief In this file we define the interface class IRowBlockSource.
+ **/
+
+#ifndef STK_IROWBLOCKSOURCE_H
+#define STK_IROWBLOCKSOURCE_H
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <Sdk/include/STK_Macros.h>
+#include <STKernel/include/STK_Exceptions.h>
+#include <Arrays/include/STK_CArray.h>
+
+namespace STK
+{
+
+/** @ingroup DManager
+ *  @brief Interface class for the sources of data read by blocks of rows.
+ *
+ *  A IRowBlockSource gives the rows of a data set by blocks of (at most)
+ *  @c blockSize() rows, so that the data set never needs to be stored in
+ *  memory. The rows of a block are indexed by their position in the data
+ *  set (starting at baseIdx): the block starting at the row @c first has
+ *  the range of rows [first, first + size). When possible the blocks are
+ *  references on the data (no copy).
+ *
+ *  The method @c apply gives all the blocks to an accumulator having an
+ *  @c update(block) method, like Stat::OnlineCovariance. If the prefetch
+ *  flag is set, the next block is read by a second thread while the current
+ *  block is processed. The nested parallelism is enabled during @c apply, so
+ *  that the accumulator keeps its own team of threads.
+ *  @code
+ *  CsvRowBlockSource source("data.csv");
+ *  Stat::OnlineCovariance stat(Range(source.nbCols()));
+ *  source.apply(stat);
+ *  @endcode
+ **/
+class IRowBlockSource
+{
+  protected:
+    /** constructor.
+     *  @param blockSize the number of rows of the blocks
+     **/
+    inline IRowBlockSource( int blockSize)
+                          : blockSize_(std::max(blockSize, 1)), prefetch_(false)
+    {}
+
+  public:
+    /** destructor */
+    inline virtual ~IRowBlockSource() {}
+    /** @return the number of rows of the blocks */
+    inline int blockSize() const { return blockSize_;}
+    /** @return @c true if the blocks are read by a second thread in @c apply */
+    inline bool prefetch() const { return prefetch_;}
+    /** @return the last error message */
+    inline String const& error() const { return msg_error_;}
+    /** @param blockSize the number of rows of the blocks */
+    inline void setBlockSize( int blockSize) { blockSize_ = std::max(blockSize, 1);}
+    /** @param prefetch @c true if the blocks have to be read by a second
+     *  thread in @c apply
+     **/
+    inline void setPrefetch( bool prefetch) { prefetch_ = prefetch;}
+    /** @return the number of columns of the data set */
+    virtual int nbCols() const = 0;
+    /** go back to the first row of the data set.
+     *  @return @c false if an error occur
+     **/
+    virtual bool rewind() = 0;
+    /** get the next block of rows.
+     *  @param block the block of rows
+     *  @return @c false if there is no more rows
+     **/
+    virtual bool next( CArrayXX& block) = 0;
+    /** give all the blocks of the data set to an accumulator.
+     *  @param acc an object with a method @c update(CArrayXX const&)
+     *  @return the number of rows processed
+     **/
+    template<class Accumulator>
+    int apply( Accumulator& acc);
+
+  protected:
+    /** the number of rows of the blocks */
+    int blockSize_;
+    /** read the blocks by a second thread ? */
+    bool prefetch_;
+    /** last error message */
+    String msg_error_;
+};
+
+template<class Accumulator>
+int IRowBlockSource::apply( Accumulator& acc)
+{
+  if (!rewind()) { STKRUNTIME_ERROR_NO_ARG(IRowBlockSource::apply,rewind failed);}
+  CArrayXX blocks[2];
+  int current = 0, nbRows = 0;
+  bool hasBlock = next(blocks[current]);
+#ifdef _OPENMP
+  // the accumulator is called inside the sections: allow it to start its own
+  // team of threads
+  const int maxLevels = omp_get_max_active_levels();
+  if (prefetch_ && maxLevels < 2) { omp_set_max_active_levels(2);}
+#endif
+  while (hasBlock)
+  {
+    bool hasNext = false;
+    // one error slot for each section
+    bool failed[2] = {false, false};
+    String msg[2];
+    if (prefetch_)
+    {
+#ifdef _OPENMP
+#pragma omp parallel sections num_threads(2)
+#endif
+      {
+#ifdef _OPENMP
+#pragma omp section
+#endif
+        {
+#ifdef _OPENMP
+          // the reader does not compete with the threads of the accumulator
+          const int nbThreads = omp_get_max_threads();
+          omp_set_num_threads(1);
+#endif
+          try { hasNext = next(blocks[1 - current]);}
+          catch (Exception const& e) { failed[0] = true; msg[0] = e.error();}
+#ifdef _OPENMP
+          // the same thread can process the other section
+          omp_set_num_threads(nbThreads);
+#endif
+        }
+#ifdef _OPENMP
+#pragma omp section
+#endif
+        {
+          try { acc.update(blocks[current]);}
+          catch (Exception const& e) { failed[1] = true; msg[1] = e.error();}
+        }
+      }
+      if (failed[0] || failed[1])
+      {
+#ifdef _OPENMP
+        if (maxLevels < 2) { omp_set_max_active_levels(maxLevels);}
+#endif
+        throw Exception(failed[1] ? msg[1] : msg[0]);
+      }
+    }
+    else
+    {
+      acc.update(blocks[current]);
+      hasNext = next(blocks[1 - current]);
+    }
+    nbRows += blocks[current].sizeRows();
+    current = 1 - current;
+    hasBlock = hasNext;
+  }
+#ifdef _OPENMP
+  if (prefetch_ && maxLevels < 2) { omp_set_max_active_levels(maxLevels);}
+#endif
+  return nbRows;
+}
+
+} // namespace STK
+
+#endif /* STK_IROWBLOCKSOURCE_H */
@@ -108,7 +108,7 @@ class ImportFromCsv : public IRunnerBase
      **/
     template<class Other>
     int import( int const& iCol, Variable<Other>& var)
-    { return var.importFromString(import_[iCol]);}
+    { return var.importFromString(import_.var(iCol));}
 
   private:
     /** a constant reference on the the original ReadWriteCsv. */
@@ -125,6 +125,21 @@ class ImportFromCsv : public IRunnerBase
      *  as String.
      **/
     bool asString();
+    /** convert a column of the csv in a numeric variable. The numeric flags
+     *  found when reading the csv file are used in order to avoid the
+     *  conversion of the columns which are not numeric.
+     *  @param iCol the column to convert
+     *  @param keepString if @c true and the conversion fail, a copy of the
+     *  column is returned
+     *  @return the variable created or 0 if the conversion fail
+     **/
+    IVariable* numericVariable( int iCol, bool keepString);
+    /** convert all the columns of the csv in parallel and append them in
+     *  the DataFrame.
+     *  @param keepString if @c true the columns which cannot be converted
+     *  are appended as String
+     **/
+    void numericVariables( bool keepString);
 };
 
 } // namespace STK
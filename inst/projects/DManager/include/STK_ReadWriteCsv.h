@@ -40,6 +40,11 @@
 
 #include <iomanip>
 #include "STK_Variable.h"
+#include "STK_CsvParser.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace STK
 {
@@ -59,6 +64,9 @@ namespace Csv
   /** @ingroup DManager
    *  with_mapping_ default value */
   static const bool   DEFAULT_MAPPING = false;
+  /** @ingroup DManager
+   *  with_encoding_ default value */
+  static const bool   DEFAULT_ENCODING = false;
   /** @ingroup DManager
    *  reserve_ default value*/
   static const int DEFAULT_RESERVE = int(0x0FFFF);
@@ -97,6 +105,12 @@ namespace Csv
  *
  *  It is possible to use a mapping in order to write/read the data using
  *  an other encoding.
+ *
+ *  When a mapping is used or when the encoding is set, the distinct fields
+ *  of each column are interned in a Csv::Dictionary while parsing, so that
+ *  the mapping (or the conversion) is applied once per distinct field. With
+ *  the encoding, the codes of the values are kept in the variables (see
+ *  Variable::codes).
  **/
 template<typename Type>
 class TReadWriteCsv
@@ -109,6 +123,7 @@ class TReadWriteCsv
     inline TReadWriteCsv() : file_name_()
                            , with_names_(Csv::DEFAULT_READNAMES)
                            , with_mapping_(Csv::DEFAULT_MAPPING)
+                           , with_encoding_(Csv::DEFAULT_ENCODING)
                            , delimiters_(Csv::DEFAULT_DELIMITER)
                            , reserve_(Csv::DEFAULT_RESERVE)
                            , msg_error_()
@@ -131,6 +146,7 @@ class TReadWriteCsv
                         : file_name_(file_name)
                         , with_names_(read_names)
                         , with_mapping_(Csv::DEFAULT_MAPPING)
+                        , with_encoding_(Csv::DEFAULT_ENCODING)
                         , delimiters_(delimiters)
                         , reserve_(Csv::DEFAULT_RESERVE)
                         , msg_error_()
@@ -149,8 +165,10 @@ class TReadWriteCsv
     {
       msg_error_.clear();
       str_data_.clear();
+      numeric_.clear();
       with_names_   = Csv::DEFAULT_READNAMES;
       with_mapping_ = Csv::DEFAULT_MAPPING;
+      with_encoding_ = Csv::DEFAULT_ENCODING;
       delimiters_   = Csv::DEFAULT_DELIMITER;
       reserve_      = Csv::DEFAULT_RESERVE;
     }
@@ -232,10 +250,19 @@ class TReadWriteCsv
 
     /** @return the last error encountered */
     inline String const& error() const { return msg_error_; }
+    /** @return 1 if all the values of the column @c icol read in the file
+     *  are numeric or NA values, 0 if it is not the case and -1 if it is not
+     *  known (the columns have been modified since the last read).
+     *  @param icol index of the column
+     **/
+    inline int isNumeric( int icol) const
+    { return (int(numeric_.size()) == size()) ? int(numeric_[icol - begin()]) : -1;}
     /**@return the delimiters used in the Csv file*/
     inline String const& delimiters() const { return delimiters_; }
     /** @return with_names value */
     inline bool withNames() const { return with_names_; }
+    /** @return with_encoding value */
+    inline bool withEncoding() const { return with_encoding_; }
     /** Sets the delimiters to use for parsing data (delimiters_ is mutable).
      *  @param delimiters delimiters to use
      **/
@@ -248,6 +275,10 @@ class TReadWriteCsv
      *  @param with_mapping @c true if we want to read the data using a map
      **/
     inline void setWithMapping( bool with_mapping) const { with_mapping_ = with_mapping; }
+    /** Sets the with_encoding_ value for reading variables
+     *  @param with_encoding @c true if we want to keep the codes of the values
+     **/
+    inline void setWithEncoding( bool with_encoding) const { with_encoding_ = with_encoding; }
     /** Sets the reserve value for data storage (reserve_ is mutable).
      *  @param reserve number of place to reserve
      **/
@@ -332,6 +363,7 @@ class TReadWriteCsv
       try
       {
         str_data_.push_back(data);
+        numeric_.clear();
         //str_data_.back().reserve(reserve_);
         return true;
       }
@@ -348,6 +380,7 @@ class TReadWriteCsv
       try
       {
         str_data_.push_front(data);
+        numeric_.clear();
         return true;
       }
       catch(const Exception& e) { msg_error_ = e.error(); }
@@ -391,6 +424,7 @@ class TReadWriteCsv
       try
       {
         str_data_.erase(icol);
+        numeric_.clear();
         return true;
       }
       catch( Exception const& e) { msg_error_ = e.error(); }
@@ -404,10 +438,15 @@ class TReadWriteCsv
     {
       file_name_     = rw.file_name_;
       with_names_    = rw.with_names_;
+      with_mapping_  = rw.with_mapping_;
+      with_encoding_ = rw.with_encoding_;
+      imapping_      = rw.imapping_;
+      omapping_      = rw.omapping_;
       delimiters_    = rw.delimiters_;
       reserve_       = rw.reserve_;
       msg_error_     = rw.msg_error_;
       str_data_      = rw.str_data_;
+      numeric_       = rw.numeric_;
       nbVars_        = rw.nbVars_;
       nbRows_        = rw.nbRows_;
       return *this;
@@ -419,6 +458,7 @@ class TReadWriteCsv
     {
       for ( int i=rw.begin(); i<=rw.lastIdx(); i++)
       { str_data_.push_back(rw.str_data_[i]);}
+      numeric_.clear();
       return *this;
     }
     /** Combines TReadWriteCsv(s)
@@ -448,7 +488,11 @@ class TReadWriteCsv
      *  @return  @c true if successful, @c false if an error is encountered.
      **/
     inline bool read(std::map<String, Type> const& mapping)
-    { return read(file_name_);}
+    {
+      imapping_ = mapping;
+      with_mapping_ = true;
+      return read(file_name_);
+    }
     /** Reads the specified file with the specified read flags.
      *  @param file_name name of the file to read
      *  @return  @c true if successful, @c false if an error is encountered.
@@ -549,6 +593,8 @@ class TReadWriteCsv
     mutable bool with_names_;
     /// Read and Write names of the variables
     mutable bool with_mapping_;
+    /// Keep the codes of the values
+    mutable bool with_encoding_;
     /// Delimiter(s)
     mutable String  delimiters_;
     /// Size of the buffer
@@ -557,6 +603,8 @@ class TReadWriteCsv
     mutable String msg_error_;
     /** Array of array for the data.*/
     Array1D< Var > str_data_;
+    /** numeric flags of the columns found in the last read */
+    std::vector<char> numeric_;
     /** mapping String -> Type for (input) */
     std::map<String, Type> imapping_;
     /** mapping Type -> String (output) */
@@ -565,6 +613,83 @@ class TReadWriteCsv
     int nbVars_;
     /** The number of rows we manage */
     int nbRows_;
+    /** stitch the codes of the column @c j of the encoded chunks. The
+     *  distinct fields of the chunks are interned in the dictionary of the
+     *  column and converted (or mapped) once.
+     *  @param chunks the parsed chunks
+     *  @param j the column to stitch
+     *  @param var the variable to fill
+     *  @param row the first row to fill in var
+     *  @param dict,levels,codes the distinct fields, their values and the
+     *  codes of the rows of the column
+     *  @param numeric the numeric flag of the column
+     **/
+    void stitchCodes( std::vector< Csv::ChunkParser<Type> > const& chunks, int j
+                    , Var& var, int row
+                    , Csv::Dictionary& dict, std::vector<Type>& levels
+                    , std::vector<int>& codes, char& numeric) const
+    {
+      codes.resize(row - baseIdx, -1);
+      std::vector<int> remap;
+      for (size_t k=0; k<chunks.size(); ++k)
+      {
+        const int nbRows = chunks[k].nbRows();
+        if (j >= chunks[k].nbCols())
+        {
+          for (int i=0; i<nbRows; ++i, ++row)
+          { var.elt(row) = Arithmetic<Type>::NA(); codes.push_back(-1);}
+          continue;
+        }
+        // intern and convert the distinct fields of the chunk
+        Csv::Dictionary const& local = chunks[k].dictionary(j);
+        remap.resize(local.size());
+        for (int c=0; c<local.size(); ++c)
+        {
+          String const& field = local.value(c);
+          remap[c] = dict.intern(field);
+          if (remap[c] < int(levels.size())) continue;
+          if (with_mapping_)
+          {
+            typename std::map<String, Type>::const_iterator it = imapping_.find(field);
+            levels.push_back((it != imapping_.end()) ? it->second : Arithmetic<Type>::NA());
+          }
+          else
+          { levels.push_back(Csv::FieldParser<Type>::parse(field.data(), field.data() + field.size()));}
+          if (numeric && !Csv::isNumericValue(levels.back())) numeric = false;
+        }
+        std::vector<int> const& col = chunks[k].codes(j);
+        for (int i=0; i<nbRows; ++i, ++row)
+        {
+          const int code = (col[i] < 0) ? -1 : remap[col[i]];
+          var.elt(row) = (code < 0) ? Arithmetic<Type>::NA() : levels[code];
+          codes.push_back(code);
+        }
+      }
+    }
+    /** set the codes of a variable. The distinct fields having the same value
+     *  get the same code and the NA values get the NA code.
+     *  @param var the variable to encode
+     *  @param levels the values of the distinct fields
+     *  @param codes the codes of the distinct fields
+     **/
+    static void setCoding( Var& var, std::vector<Type> const& levels, std::vector<int>& codes)
+    {
+      std::map<Type, int> coding;
+      std::vector<Type> values;
+      std::vector<int> remap(levels.size());
+      for (size_t l=0; l<levels.size(); ++l)
+      {
+        if (Arithmetic<Type>::isNA(levels[l])) { remap[l] = Arithmetic<int>::NA(); continue;}
+        std::pair< typename std::map<Type, int>::iterator, bool> ret
+          = coding.insert(std::pair<Type, int>(levels[l], baseIdx + int(values.size())));
+        if (ret.second) { values.push_back(levels[l]);}
+        remap[l] = ret.first->second;
+      }
+      codes.resize(var.size(), -1);
+      for (size_t i=0; i<codes.size(); ++i)
+      { codes[i] = (codes[i] < 0) ? Arithmetic<int>::NA() : remap[codes[i]];}
+      var.setCoding(values, codes);
+    }
     /** Counts the number of columns in a line stored in a String
      *  and return the position of the delimiters and its types.
      *  @param line The String to parse
@@ -689,49 +814,129 @@ class TReadWriteCsv
     { str_data_.resize(cols);}
 };
 
-/* Reads the specified file with the specified read flags.
- *  @param file_name name of the file to read
+/* Reads the specified input stream with the specified read flags.
+ *  The stream is read by large blocks which are split in chunks of lines.
+ *  The chunks are parsed in parallel in column buffers and the buffers are
+ *  stitched together in the columns. The number of rows is estimated using
+ *  the first block and the columns are enlarged if needed.
+ *  @param inBuffer name of the stream to read
  *  @return  @c true if successful, @c false if an error is encountered.
  **/
 template <typename Type>
 bool TReadWriteCsv<Type>::read( istream& inBuffer)
 {
-  Array1D<Char> listDelimiters;
-  String currentLine;
   try
   {
-    initRead(inBuffer);
-    resizeCols(nbVars_);
-    resizeRows(nbRows_);
-    // Read data : loop for all rows
-    int currentRow=beginRows()-1, countRows = 0;
-    for (; !inBuffer.eof();)
+    // clear previous ReadCvs if any
+    str_data_.clear();
+    numeric_.clear();
+    nbVars_ = 0; nbRows_ = 0;
+    int nbChunk = 1;
+#ifdef _OPENMP
+    nbChunk = omp_get_max_threads();
+#endif
+    Csv::BlockReader reader(inBuffer, nbChunk * (1 << 22));
+    Csv::Tokenizer tokenizer(delimiters_);
+    const bool encode = with_mapping_ || with_encoding_;
+    std::vector<Char const*> limits;
+    std::vector<char> numeric;
+    // encoded columns: distinct fields, their values and the codes
+    std::vector<Csv::Dictionary> dicts;
+    std::vector< std::vector<Type> > levels;
+    std::vector< std::vector<int> > codes;
+    Char const *p, *end;
+    bool readNames = with_names_;
+    int countRows = 0;
+    while (reader.next(p, end))
     {
-      int nbField = readCurrentLine(inBuffer, currentLine, listDelimiters);
-      if (nbField == 0) { break;}
-      //  add on the non-existing columns: will be done if (nbField >= nbVars_)
-      for (int iField=nbVars_+1; iField<=nbField; iField++)
-      { push_back(Var( nbRows_, Arithmetic<Type>::NA(), stringNa));
-        nbVars_++;
+      // If the names are at the top line
+      if (readNames)
+      {
+        Char const *b, *e;
+        if (!tokenizer.nextLine(p, end, b, e)) continue;
+        std::vector<Csv::Field> fields;
+        nbVars_ = tokenizer.split(b, e, fields);
+        for(int iField=0; iField<nbVars_; iField++)
+        { str_data_.push_back(Var(0, String(fields[iField].first, fields[iField].second)));}
+        numeric.assign(nbVars_, true);
+        readNames = false;
       }
-      // first loop on the existing columns with data
-      currentRow++; countRows++;
-      istringstream instream(currentLine);
-      int icol=begin();
-      for (int iField=1 ; iField<=nbField; iField++, icol++)
+      // parse the chunks of the block
+      Csv::splitBlock(p, end, (end - p > (1 << 16)) ? nbChunk : 1, limits);
+      const int nbChunks = int(limits.size()) - 1;
+      std::vector< Csv::ChunkParser<Type> > chunks(nbChunks, Csv::ChunkParser<Type>(tokenizer, encode));
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (nbChunks > 1)
+#endif
+      for (int k=0; k<nbChunks; ++k) { chunks[k].parse(limits[k], limits[k+1]);}
+      int nbNewRows = 0, nbCols = nbVars_;
+      for (int k=0; k<nbChunks; ++k)
+      { nbNewRows += chunks[k].nbRows(); nbCols = std::max(nbCols, chunks[k].nbCols());}
+      if (nbNewRows == 0) continue;
+      if (countRows == 0)
+      { // first rows: the number of rows is estimated using the first block
+        nbVars_ = nbCols;
+        nbRows_ = std::max(reader.estimateNbLines(), nbNewRows);
+        setReserve(nbRows_);
+        resizeCols(nbVars_);
+        resizeRows(nbRows_);
+      }
+      else
+      { // not enough rows: double the storage
+        if (countRows + nbNewRows > nbRows_)
+        {
+          nbRows_ = std::max(2*nbRows_, countRows + nbNewRows);
+          resizeRows(nbRows_);
+        }
+        //  add on the non-existing columns
+        for (; nbVars_<nbCols; nbVars_++)
+        { str_data_.push_back(Var( nbRows_, Arithmetic<Type>::NA(), stringNa));}
+      }
+      numeric.resize(nbVars_, true);
+      if (encode)
+      { dicts.resize(nbVars_); levels.resize(nbVars_); codes.resize(nbVars_);}
+      // stitch the columns of the chunks
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (double(nbNewRows) * nbVars_ > ParallelThreshold)
+#endif
+      for (int j=0; j<nbVars_; ++j)
       {
-        String field;
-        DManager::getField( instream, field, listDelimiters.elt(iField));
-        // append Data to the column
-        with_mapping_ ?
-            fastSetData(icol, currentRow, imapping_.count(field) ? imapping_.find(field)->second : Arithmetic<Type>::NA())
-         :  fastSetData(icol, currentRow, stringToType<Type>(field));
+        Var& var = str_data_.elt(begin() + j);
+        int row = baseIdx + countRows;
+        if (encode)
+        {
+          stitchCodes(chunks, j, var, row, dicts[j], levels[j], codes[j], numeric[j]);
+          continue;
+        }
+        for (int k=0; k<nbChunks; ++k)
+        {
+          const int nbRows = chunks[k].nbRows();
+          if (j < chunks[k].nbCols())
+          {
+            std::vector<Type>& col = chunks[k].col(j);
+            for (int i=0; i<nbRows; ++i, ++row) { Csv::moveValue(col[i], var.elt(row));}
+            if (!chunks[k].isNumeric(j)) numeric[j] = false;
+          }
+          else
+          { for (int i=0; i<nbRows; ++i, ++row) { var.elt(row) = Arithmetic<Type>::NA();}}
+        }
       }
-      // Append NA values if the row is not complete
-      for (; icol<=lastIdx(); icol++) { fastSetData(icol, currentRow, Arithmetic<Type>::NA());}
+      countRows += nbNewRows;
     }
+    // no data: create the columns
+    if (countRows == 0) { resizeCols(nbVars_);}
     // resize in case there exists too much rows
     resizeRows(Range(countRows));
+    nbRows_ = countRows;
+    numeric.resize(nbVars_, true);
+    numeric_.swap(numeric);
+    if (with_encoding_)
+    {
+      codes.resize(nbVars_);
+      levels.resize(nbVars_);
+      for (int j=0; j<nbVars_; ++j)
+      { setCoding(str_data_.elt(begin() + j), levels[j], codes[j]);}
+    }
     return true;
   }
   catch( Exception const& e) { msg_error_ = e.error(); }
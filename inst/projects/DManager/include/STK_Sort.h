@@ -0,0 +1,433 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project: DManager
+ * Purpose: sorting and selection methods acting on Containers
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_Sort.h
+ *  @brief In this file we define the sorting and selection methods for
+ *  the one dimensional containers.
+ *
+ *  The elements are copied in a contiguous buffer, sorted there and copied
+ *  back, so that the algorithms work on contiguous memory whatever the
+ *  container.
+ *  - the Real and Integer values are sorted using a LSD radix sort when
+ *  there is more than @c RadixThreshold values, the other types use the
+ *  introsort of the standard library,
+ *  - above @c ParallelThreshold values, the buffer is split in chunks
+ *  sorted in parallel and merged,
+ *  - the selection methods use the introselect of the standard library
+ *  (std::nth_element), several order statistics being selected at once by
+ *  recursive splitting of the buffer.
+ *  The NaN (NA) Real values are put at the end, -0. is put before +0..
+ **/
+
+#ifndef STK_SORT_H
+#define STK_SORT_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+
+#include "Arrays/include/STK_Array2DVector.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace STK
+{
+
+/** @ingroup DManager
+ *  Minimal number of values for using the radix sort. */
+const int RadixThreshold = 512;
+
+namespace hidden
+{
+/** @ingroup hidden
+ *  @brief Comparison used by the sorting methods. The generic
+ *  implementation use the operator <.
+ **/
+template<typename Type>
+struct SortLess
+{
+  inline bool operator()( Type const& a, Type const& b) const { return a < b;}
+};
+/** @ingroup hidden
+ *  Specialization for Real: the NaN values are greater than all the other
+ *  values.
+ **/
+template<>
+struct SortLess<Real>
+{
+  inline bool operator()( Real const& a, Real const& b) const
+  { return (a < b) || (b != b && a == a);}
+};
+
+/** @ingroup hidden
+ *  @brief Comparison of the indexes of the elements of a buffer. The ties
+ *  are broken using the indexes so that the order is stable.
+ **/
+template<typename Type>
+struct IndexLess
+{
+  IndexLess( Type const* p): p_(p) {}
+  inline bool operator()( int i, int j) const
+  { return less_(p_[i], p_[j]) || (!less_(p_[j], p_[i]) && i < j);}
+  Type const* p_;
+  SortLess<Type> less_;
+};
+
+/** @ingroup hidden
+ *  @brief Map the values of type Type to unsigned keys sorted in the same
+ *  order. The generic implementation is empty: the type cannot be sorted
+ *  using a radix sort.
+ **/
+template<typename Type>
+struct RadixKey
+{ enum { isRadix_ = false };};
+
+/** @ingroup hidden
+ *  Specialization for Real. All the NaN are mapped to the greatest key.
+ **/
+template<>
+struct RadixKey<Real>
+{
+  enum { isRadix_ = true};
+  typedef unsigned long long Key;
+  static inline Key key( Real const& x)
+  {
+    if (x != x) return ~Key(0);
+    double d = double(x);
+    Key u;
+    std::memcpy(&u, &d, sizeof(u));
+    return (u >> 63) ? ~u : (u | (Key(1) << 63));
+  }
+  static inline Real value( Key const& k)
+  {
+    if (k == ~Key(0)) return Arithmetic<Real>::NA();
+    Key u = (k >> 63) ? (k & ~(Key(1) << 63)) : ~k;
+    double d;
+    std::memcpy(&d, &u, sizeof(d));
+    return Real(d);
+  }
+};
+
+/** @ingroup hidden
+ *  Specialization for Integer.
+ **/
+template<>
+struct RadixKey<Integer>
+{
+  enum { isRadix_ = true};
+  typedef unsigned int Key;
+  static inline Key key( Integer const& x) { return Key(x) ^ 0x80000000u;}
+  static inline Integer value( Key const& k) { return Integer(k ^ 0x80000000u);}
+};
+
+/** @ingroup hidden
+ *  LSD radix sort of keys, with an optional array of indexes moved with the
+ *  keys. The sort is stable and the passes on the bytes having the same
+ *  value for all the keys are skipped.
+ *  @param keys,n the keys to sort
+ *  @param idx the indexes to move with the keys (can be null)
+ **/
+template<typename Key>
+void radixSortKeys( Key* keys, int* idx, int n)
+{
+  if (n < 2) return;
+  const int nbBytes = int(sizeof(Key));
+  // histograms of all the bytes computed in one pass
+  std::vector<int> count(256 * nbBytes, 0);
+  for (int i=0; i<n; ++i)
+  {
+    Key k = keys[i];
+    for (int b=0; b<nbBytes; ++b, k >>= 8) { ++count[256*b + int(k & 0xFF)];}
+  }
+  std::vector<Key> bufKeys(n);
+  std::vector<int> bufIdx(idx ? n : 0);
+  Key *src = keys, *dst = &bufKeys[0];
+  int *iSrc = idx, *iDst = idx ? &bufIdx[0] : 0;
+  for (int b=0; b<nbBytes; ++b)
+  {
+    int* c = &count[256*b];
+    const int shift = 8*b;
+    // all the keys have the same byte
+    if (c[int((src[0] >> shift) & 0xFF)] == n) continue;
+    for (int v=0, sum=0; v<256; ++v) { const int t = c[v]; c[v] = sum; sum += t;}
+    for (int i=0; i<n; ++i)
+    {
+      const int pos = c[int((src[i] >> shift) & 0xFF)]++;
+      dst[pos] = src[i];
+      if (iSrc) iDst[pos] = iSrc[i];
+    }
+    std::swap(src, dst);
+    std::swap(iSrc, iDst);
+  }
+  if (src != keys)
+  {
+    std::copy(src, src + n, keys);
+    if (idx) std::copy(iSrc, iSrc + n, idx);
+  }
+}
+
+/** @ingroup hidden
+ *  @brief Sequential sort of a buffer. The generic implementation use
+ *  std::sort.
+ **/
+template<typename Type, bool isRadix = RadixKey<Type>::isRadix_>
+struct SortImpl
+{
+  static void run( Type* p, int n)
+  { std::sort(p, p + n, SortLess<Type>());}
+  static void argSort( Type const* p, int* idx, int n)
+  { std::sort(idx, idx + n, IndexLess<Type>(p));}
+};
+
+/** @ingroup hidden
+ *  Specialization for the types having radix keys.
+ **/
+template<typename Type>
+struct SortImpl<Type, true>
+{
+  typedef typename RadixKey<Type>::Key Key;
+  static void run( Type* p, int n)
+  {
+    if (n < RadixThreshold) { std::sort(p, p + n, SortLess<Type>()); return;}
+    std::vector<Key> keys(n);
+    for (int i=0; i<n; ++i) { keys[i] = RadixKey<Type>::key(p[i]);}
+    radixSortKeys(&keys[0], (int*)0, n);
+    for (int i=0; i<n; ++i) { p[i] = RadixKey<Type>::value(keys[i]);}
+  }
+  static void argSort( Type const* p, int* idx, int n)
+  {
+    if (n < RadixThreshold) { std::sort(idx, idx + n, IndexLess<Type>(p)); return;}
+    std::vector<Key> keys(n);
+    // adding zero maps -0. to +0.: the ties are kept in the order of idx
+    for (int i=0; i<n; ++i) { keys[i] = RadixKey<Type>::key(p[idx[i]] + Type(0));}
+    radixSortKeys(&keys[0], idx, n);
+  }
+};
+
+/** @ingroup hidden
+ *  Sort a buffer. Above ParallelThreshold values, the buffer is split in
+ *  chunks sorted in parallel, then the chunks are merged pairwise.
+ *  @param p,n the buffer to sort
+ **/
+template<typename Type>
+void sortBuffer( Type* p, int n)
+{
+  if (n < 2) return;
+#ifdef _OPENMP
+  const int nbChunk = std::min(omp_get_max_threads(), n / RadixThreshold);
+  if (nbChunk > 1 && n > ParallelThreshold)
+  {
+    std::vector<int> lim(nbChunk + 1);
+    for (int k=0; k<=nbChunk; ++k) { lim[k] = int((long long)(n) * k / nbChunk);}
+#pragma omp parallel for schedule(static)
+    for (int k=0; k<nbChunk; ++k) { SortImpl<Type>::run(p + lim[k], lim[k+1] - lim[k]);}
+    std::vector<Type> buffer(n);
+    Type *src = p, *dst = &buffer[0];
+    for (int width = 1; width < nbChunk; width *= 2)
+    {
+      const int nbMerge = (nbChunk + 2*width - 1)/(2*width);
+#pragma omp parallel for schedule(static)
+      for (int m=0; m<nbMerge; ++m)
+      {
+        const int lo  = lim[std::min(2*m*width, nbChunk)];
+        const int mid = lim[std::min((2*m+1)*width, nbChunk)];
+        const int hi  = lim[std::min((2*m+2)*width, nbChunk)];
+        std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, SortLess<Type>());
+      }
+      std::swap(src, dst);
+    }
+    if (src != p) std::copy(src, src + n, p);
+    return;
+  }
+#endif
+  SortImpl<Type>::run(p, n);
+}
+
+/** @ingroup hidden
+ *  Select the order statistics of a buffer. After the call, the elements
+ *  at the positions ranks[first, last) are the elements which would be at
+ *  these positions in the sorted buffer.
+ *  @param b,e the buffer
+ *  @param ranks the sorted positions to select
+ *  @param first,last the positions of interest in ranks
+ **/
+template<typename Type>
+void multiSelect( Type* b, Type* e, std::vector<int> const& ranks, int first, int last, Type* p)
+{
+  if (first >= last || b >= e) return;
+  const int mid = (first + last) / 2;
+  Type* nth = p + ranks[mid];
+  std::nth_element(b, nth, e, SortLess<Type>());
+  // the smaller ranks are on the left, the greater on the right
+  int lo = mid, hi = mid + 1;
+  while (lo > first && ranks[lo - 1] == ranks[mid]) --lo;
+  while (hi < last && ranks[hi] == ranks[mid]) ++hi;
+  multiSelect(b, nth, ranks, first, lo, p);
+  multiSelect(nth + 1, e, ranks, hi, last, p);
+}
+
+} // namespace hidden
+
+/** @ingroup DManager
+ *  @brief Sort the container T in ascending order.
+ *  @param T the container to sort
+ **/
+template<class Vector>
+void sort( ArrayBase<Vector>& T)
+{
+  typedef typename hidden::Traits<Vector>::Type Type;
+  const int n = T.size();
+  if (n < 2) return;
+  std::vector<Type> buffer(n);
+  for (int i=T.begin(), k=0; i<T.end(); ++i, ++k) { buffer[k] = T[i];}
+  hidden::sortBuffer(&buffer[0], n);
+  for (int i=T.begin(), k=0; i<T.end(); ++i, ++k) { T[i] = buffer[k];}
+}
+
+/** @ingroup DManager
+ *  @brief Sort the container T in ascending order and return the result in
+ *  the container Tsort.
+ *  @param T the container to sort
+ *  @param Tsort the container with the result
+ **/
+template<class Vector>
+void sort( ArrayBase<Vector> const& T, Vector& Tsort)
+{
+  Tsort = T.asDerived();
+  sort(Tsort);
+}
+
+/** @ingroup DManager
+ *  @brief Sort the container T in ascending order using an index array.
+ *  T is not modified, I contains the indexes of the elements of T in
+ *  ascending order. The sort is stable.
+ *  @param I the index array sorting T
+ *  @param T the container to sort
+ **/
+template< class Vector, class VectorInt>
+void argSort( ArrayBase<VectorInt>& I, ArrayBase<Vector> const& T)
+{
+  typedef typename hidden::Traits<Vector>::Type Type;
+  const int n = T.size();
+  I.asDerived().resize(T.range());
+  if (n == 0) return;
+  std::vector<Type> buffer(n);
+  std::vector<int> idx(n);
+  for (int i=T.begin(), k=0; i<T.end(); ++i, ++k) { buffer[k] = T[i]; idx[k] = k;}
+  hidden::SortImpl<Type>::argSort(&buffer[0], &idx[0], n);
+  for (int i=I.begin(), k=0; i<I.end(); ++i, ++k) { I[i] = T.begin() + idx[k];}
+}
+
+/** @ingroup DManager
+ *  @brief Select the elements which would be at the positions @c ranks if
+ *  the container T was sorted, without sorting it.
+ *  @param T the container
+ *  @param ranks the positions in the range of T
+ *  @param values the selected values, with the range of ranks
+ **/
+template<class Vector, class VectorInt, class Result>
+void nthElements( ArrayBase<Vector> const& T, ExprBase<VectorInt> const& ranks, ArrayBase<Result>& values)
+{
+  typedef typename hidden::Traits<Vector>::Type Type;
+  const int n = T.size();
+  values.asDerived().resize(ranks.range());
+  if (n == 0) { values = Arithmetic<Type>::NA(); return;}
+  std::vector<Type> buffer(n);
+  for (int i=T.begin(), k=0; i<T.end(); ++i, ++k) { buffer[k] = T[i];}
+  std::vector<int> r;
+  for (int i=ranks.begin(); i<ranks.end(); ++i)
+  { r.push_back(std::min(std::max(ranks.elt(i) - T.begin(), 0), n - 1));}
+  std::sort(r.begin(), r.end());
+  hidden::multiSelect(&buffer[0], &buffer[0] + n, r, 0, int(r.size()), &buffer[0]);
+  for (int i=ranks.begin(); i<ranks.end(); ++i)
+  { values[i] = buffer[std::min(std::max(ranks.elt(i) - T.begin(), 0), n - 1)];}
+}
+
+/** @ingroup DManager
+ *  @brief Select the element which would be at the position @c rank if
+ *  the container T was sorted, without sorting it.
+ *  @param T the container
+ *  @param rank the position in the range of T
+ *  @return the selected value
+ **/
+template<class Vector>
+typename hidden::Traits<Vector>::Type nthElement( ArrayBase<Vector> const& T, int rank)
+{
+  typedef typename hidden::Traits<Vector>::Type Type;
+  const int n = T.size();
+  if (n == 0) return Arithmetic<Type>::NA();
+  std::vector<Type> buffer(n);
+  for (int i=T.begin(), k=0; i<T.end(); ++i, ++k) { buffer[k] = T[i];}
+  const int k = std::min(std::max(rank - T.begin(), 0), n - 1);
+  std::nth_element(buffer.begin(), buffer.begin() + k, buffer.end(), hidden::SortLess<Type>());
+  return buffer[k];
+}
+
+/** @ingroup DManager
+ *  @brief Compute several quantiles of the container T at once, without
+ *  sorting it. The quantile of order p is obtained by linear interpolation
+ *  between the order statistics of the position p(n+1) (like
+ *  Stat::Univariate).
+ *  @param T the container
+ *  @param probs the orders of the quantiles (in [0,1])
+ *  @param q the quantiles, with the range of probs
+ **/
+template<class Vector, class Probs, class Result>
+void quantiles( ArrayBase<Vector> const& T, ExprBase<Probs> const& probs, ArrayBase<Result>& q)
+{
+  const int n = T.size();
+  q.asDerived().resize(probs.range());
+  if (n == 0) { q = Arithmetic<Real>::NA(); return;}
+  // positions of the order statistics needed
+  Array2DVector<int> ranks(Range(0, 2*probs.size()));
+  for (int i=probs.begin(), k=0; i<probs.end(); ++i, k+=2)
+  {
+    const Real find = probs.elt(i) * (n + 1);
+    const int tind = std::min(std::max(int(find), 1), n);
+    ranks[k]   = T.begin() + tind - 1;
+    ranks[k+1] = T.begin() + std::min(tind + 1, n) - 1;
+  }
+  Array2DVector<Real> values;
+  nthElements(T, ranks, values);
+  for (int i=probs.begin(), k=0; i<probs.end(); ++i, k+=2)
+  {
+    const Real find = probs.elt(i) * (n + 1);
+    const Real aux = std::min(std::max(find - std::max(int(find), 1), Real(0.)), Real(1.));
+    q[i] = (aux > 0.) ? (1. - aux) * values[k] + aux * values[k+1] : values[k];
+  }
+}
+
+} // namespace STK
+
+#endif /*STK_SORT_H*/
@@ -35,8 +35,11 @@
 #ifndef STK_VARIABLE_H
 #define STK_VARIABLE_H
 
+#include <algorithm>
+
 #include "Arrays/include/STK_IArray2D.h"
 #include "STK_IVariable.h"
+#include "STK_CsvParser.h"
 
 namespace STK
 {
@@ -142,6 +145,7 @@ class Variable : public IVariable
     Variable( Variable const& V, bool ref = false)
             : IVariable(V)
             , Base(V, ref)
+            , levels_(V.levels_), codes_(V.codes_)
     {}
     /** Reference constructor
      *  @param V the Variable to wrap
@@ -210,7 +214,11 @@ class Variable : public IVariable
     virtual Variable* clone( bool ref = false) const
     { return new Variable(*this, ref);}
     /** */
-    virtual void popBack(int const& n =1) { Base::popBackRows(n);}
+    virtual void popBack(int const& n =1)
+    {
+      if (isEncoded()) { codes_.resize(std::max(this->size() - n, 0));}
+      Base::popBackRows(n);
+    }
     /** @return a constant reference on the ith element
      *  @param i index of the element (const)
      **/
@@ -228,17 +236,22 @@ class Variable : public IVariable
      *  @param I the range to set to the container
      **/
     inline Variable<Type>& resize1D(Range const& I)
-    { Base::resize(I, this->cols()); return *this;}
+    {
+      if (isEncoded()) { codes_.resize(std::max(I.size(), 0), Arithmetic<int>::NA());}
+      Base::resize(I, this->cols());
+      return *this;
+    }
     /** Add n elements to the container.
      *  @param n number of elements to add
      **/
     void pushBack( int const& n=1)
-    { Base::pushBackRows(n);}
+    { insertCodes(this->end(), n); Base::pushBackRows(n);}
     /** Add an element to the container.
      *  @param v the element to add
      **/
     void push_back( Type const& v)
-    { Base::pushBackRows();
+    { if (isEncoded()) { codes_.push_back(addLevel(v));}
+      Base::pushBackRows();
       this->back() = v;
     }
     /** Insert n elements at the position pos of the container. The bound
@@ -248,7 +261,7 @@ class Variable : public IVariable
      *  @param n number of elements to insert (default 1)
      **/
     void insertElt(int pos, int const& n =1)
-    { Base::insertRows(pos, n);}
+    { insertCodes(pos, n); Base::insertRows(pos, n);}
     /** operator = : overwrite the CArray with the Right hand side T.
      *  @param V the container to copy
      **/
@@ -260,6 +273,7 @@ class Variable : public IVariable
     inline Variable& operator=(Variable const& V)
     { // copy IVariable part
       this->name_ = V.name_;
+      levels_ = V.levels_; codes_ = V.codes_;
       return LowBase::assign(V);
     }
     /** set the container to a constant value.
@@ -273,16 +287,49 @@ class Variable : public IVariable
     inline void move(Variable const& V)
     { Base::move(V);
       name_ = V.name_;
+      levels_ = V.levels_; codes_ = V.codes_;
     }
-    /** encode values as ints. Not used yet. */
+    /** encode the values as ints: each distinct value get a code starting
+     *  at baseIdx in the order of its first occurrence, the NA values get
+     *  the NA code. The codes follow the insertions and deletions of
+     *  elements (the inserted elements get the NA code), but they are not
+     *  updated if a value is modified.
+     **/
     void encode()
-    { int code = baseIdx;
-      std::pair< typename std::map<Type, int>::iterator, bool> ret;
-      for (int i=this->begin(); i<= this->lastIdx(); i++)
-      { ret=coding_.insert(std::pair<Type, int>(this->elt(i), i));
-        if (ret.second==true) { code++;}
+    {
+      std::map<Type, int> coding;
+      levels_.clear();
+      codes_.resize(this->size());
+      for (int i=this->begin(), k=0; i<= this->lastIdx(); i++, k++)
+      {
+        if (Arithmetic<Type>::isNA(this->elt(i))) { codes_[k] = Arithmetic<int>::NA(); continue;}
+        std::pair< typename std::map<Type, int>::iterator, bool> ret
+          = coding.insert(std::pair<Type, int>(this->elt(i), baseIdx + int(levels_.size())));
+        if (ret.second) { levels_.push_back(this->elt(i));}
+        codes_[k] = ret.first->second;
       }
     }
+    /** @return @c true if the codes of the values are available */
+    inline bool isEncoded() const
+    { return this->size() > 0 && int(codes_.size()) == this->size();}
+    /** @return the distinct values of the variable, the value with the code
+     *  @c c is levels()[c - baseIdx]
+     **/
+    inline std::vector<Type> const& levels() const { return levels_;}
+    /** @return the codes of the values */
+    inline std::vector<int> const& codes() const { return codes_;}
+    /** @return the code of the ith value
+     *  @param i index of the value
+     **/
+    inline int code(int i) const { return codes_[i - this->begin()];}
+    /** set the codes of the values. The vectors are swapped.
+     *  @param levels the distinct values
+     *  @param codes the codes of the values
+     **/
+    inline void setCoding( std::vector<Type>& levels, std::vector<int>& codes)
+    { levels_.swap(levels); codes_.swap(codes);}
+    /** remove the codes of the values */
+    inline void clearCoding() { levels_.clear(); codes_.clear();}
     /** @return the maximal size of all the fields as String in the variable */
     int maxLength(bool with_name) const
     {
@@ -305,12 +352,17 @@ class Variable : public IVariable
     /** @return the number of sample in the variable */
     virtual int size() const { return Base::size();}
     /** clear Container from all elements and memory allocated. */
-    virtual void clear() { Base::clear();}
+    virtual void clear() { Base::clear(); clearCoding();}
     /** Delete n elements at the @c pos index from the container.
      *  @param pos index where to delete elements
      *  @param n number of elements to delete (default 1)
      **/
-    virtual void erase(int pos, int const& n=1) { Base::eraseRows(pos,n);}
+    virtual void erase(int pos, int const& n=1)
+    {
+      if (isEncoded() && n > 0)
+      { codes_.erase(codes_.begin() + (pos - this->begin()), codes_.begin() + (pos - this->begin() + n));}
+      Base::eraseRows(pos,n);
+    }
     /** New first index for the object.
      *  @param beg the index of the first column to set
      **/
@@ -343,16 +395,58 @@ class Variable : public IVariable
                                , std::ios_base& (*f)(std::ios_base&) = std::dec
                                );
   protected:
-    /** store the map String <-> int */
-    std::map<Type, int> coding_;
+    /** insert the NA code of n elements inserted at the position pos if the
+     *  variable is encoded.
+     *  @param pos index where the elements are inserted
+     *  @param n number of elements inserted
+     **/
+    inline void insertCodes( int pos, int n)
+    {
+      if (isEncoded() && n > 0)
+      { codes_.insert(codes_.begin() + (pos - this->begin()), n, Arithmetic<int>::NA());}
+    }
+    /** @return the code of the value v, v is added to the levels if it is
+     *  a new value.
+     *  @param v the value to code
+     **/
+    int addLevel( Type const& v)
+    {
+      if (Arithmetic<Type>::isNA(v)) return Arithmetic<int>::NA();
+      typename std::vector<Type>::const_iterator it = std::find(levels_.begin(), levels_.end(), v);
+      if (it == levels_.end()) { levels_.push_back(v); return baseIdx + int(levels_.size()) - 1;}
+      return baseIdx + int(it - levels_.begin());
+    }
+    /** the distinct values of the variable (if encoded) */
+    std::vector<Type> levels_;
+    /** the codes of the values (if encoded) */
+    std::vector<int> codes_;
 };
 
+/** encode the values as ints. Specialization for Type = String: the distinct
+ *  values are found using a Csv::Dictionary.
+ **/
+template<>
+inline void Variable<String>::encode()
+{
+  Csv::Dictionary dict;
+  levels_.clear();
+  codes_.resize(this->size());
+  for (int i=this->begin(), k=0; i<= this->lastIdx(); i++, k++)
+  {
+    String const& value = this->elt(i);
+    if (Arithmetic<String>::isNA(value)) { codes_[k] = Arithmetic<int>::NA(); continue;}
+    codes_[k] = baseIdx + dict.intern(value);
+  }
+  levels_ = dict.values();
+}
+
 /** push back n NA values. Specialization for Type = String.
  *  @param n number of NA values to add
  **/
 template<>
 inline void Variable<String>::pushBackNAValues(int const& n)
-{ int first = this->lastIdx() +1, end = first+n;
+{ insertCodes(this->end(), n);
+  int first = this->lastIdx() +1, end = first+n;
   this->insertRows(this->lastIdx() +1, n);
   for (int i=first; i<end; i++)
   this->elt(i) = stringNa;
@@ -363,6 +457,7 @@ inline void Variable<String>::pushBackNAValues(int const& n)
 template<class Type>
 inline void Variable<Type>::pushBackNAValues(int const& n)
 {
+    insertCodes(this->end(), n);
     int first = this->lastIdx() +1, end = first+n;
     this->insertRows(this->lastIdx() +1, n);
     for (int i=first; i<end; i++)
@@ -397,7 +492,8 @@ inline int Variable<Type>::importFromString( Variable< String > const& V
     if ( (Arithmetic<String>::isNA(V[i])) || (V[i]==stringNa) ) // not Available
       this->elt(i) = Arithmetic<Type>::NA();
     else
-    if (!stringToType<Type>(this->elt(i), V[i], f)) nSuccess--;
+    if (f == std::dec ? !Csv::parseField<Type>(V[i], this->elt(i))
+                      : !stringToType<Type>(this->elt(i), V[i], f)) nSuccess--;
   return nSuccess;
 }
 /** Overwrite the variable V by converting the data into strings.
@@ -438,7 +534,7 @@ inline Variable<Type>& Variable<Type>::operator<<( Variable< String > const& V)
 {
   this->resize(V.range());
   this->setName(V.name());
-  for (int i=V.begin(); i<=V.lastIdx(); i++) this->elt(i) = stringToType<Type>(V[i]);
+  for (int i=V.begin(); i<=V.lastIdx(); i++) this->elt(i) = Csv::parseField<Type>(V[i]);
   return *this;
 }
 /** Operator >> : convert the Variable V into strings.
@@ -0,0 +1,432 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::DManager
+ * Purpose:  Implementation of the classes BinaryWriter and BinaryReader.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_BinaryColumns.cpp
+ *  @brief In this file we implement the classes BinaryWriter and BinaryReader.
+ **/
+
+#include <cstring>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "../include/STK_BinaryColumns.h"
+
+namespace STK
+{
+
+/* constructor. Open the file. */
+BinaryWriter::BinaryWriter( std::string const& fileName)
+                          : file_(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc)
+                          , nbRows_(-1)
+{
+  if (!file_.is_open())
+  {
+    msg_error_ = _T("In BinaryWriter, cannot open the file.\n");
+    return;
+  }
+  // reserve the place of the header
+  BinaryColumns::FileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  file_.write(reinterpret_cast<char const*>(&header), sizeof(header));
+}
+
+/* destructor. Close the file if needed. */
+BinaryWriter::~BinaryWriter()
+{ if (file_.is_open()) close();}
+
+/* write a variable. */
+bool BinaryWriter::writeColumn( IVariable const& v)
+{
+  switch (v.getType())
+  {
+    case Base::real_:
+    {
+      Variable<Real> const& x = static_cast<Variable<Real> const&>(v);
+      if (!beginColumn(x.size(), Base::real_, sizeof(Real), x.name())) return false;
+      for (int i=x.begin(); i<=x.lastIdx(); ++i) { appendValue(x.elt(i));}
+      return endColumn();
+    }
+    case Base::integer_:
+    {
+      Variable<Integer> const& x = static_cast<Variable<Integer> const&>(v);
+      if (!beginColumn(x.size(), Base::integer_, sizeof(Integer), x.name())) return false;
+      for (int i=x.begin(); i<=x.lastIdx(); ++i) { appendValue(x.elt(i));}
+      return endColumn();
+    }
+    case Base::string_:
+      return writeStrings(static_cast<Variable<String> const&>(v));
+    default:
+    {
+      Variable<String> x;
+      v.exportAsString(x);
+      return writeStrings(x);
+    }
+  }
+}
+
+/* write the variables of a DataFrame. */
+bool BinaryWriter::write( DataFrame const& df)
+{
+  for (int j=df.beginCols(); j<df.endCols(); ++j)
+  {
+    if (!df.elt(j)) continue;
+    if (!writeColumn(*df.elt(j))) return false;
+  }
+  return true;
+}
+
+/* write the directory and the names of the columns and close the file. */
+bool BinaryWriter::close()
+{
+  if (!file_.is_open()) return false;
+  // directory
+  static const char zeros[BinaryColumns::ALIGNMENT] = {0};
+  std::streamoff pos = file_.tellp();
+  std::streamoff pad = (BinaryColumns::ALIGNMENT - pos % BinaryColumns::ALIGNMENT) % BinaryColumns::ALIGNMENT;
+  file_.write(zeros, pad);
+  BinaryColumns::FileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic_, BinaryColumns::MAGIC, sizeof(header.magic_));
+  header.version_    = BinaryColumns::VERSION;
+  header.endian_     = BinaryColumns::ENDIAN_TAG;
+  header.alignment_  = BinaryColumns::ALIGNMENT;
+  header.naEncoding_ = 0;
+  header.charSize_   = sizeof(Char);
+  header.nbRows_     = std::max(nbRows_, 0);
+  header.nbCols_     = columns_.size();
+  header.directory_  = pos + pad;
+  if (columns_.size() > 0)
+  { file_.write(reinterpret_cast<char const*>(&columns_.front()), columns_.size() * sizeof(BinaryColumns::ColumnHeader));}
+  // names
+  header.names_ = file_.tellp();
+  file_.write(reinterpret_cast<char const*>(names_.data()), names_.size() * sizeof(Char));
+  // header
+  file_.seekp(0);
+  file_.write(reinterpret_cast<char const*>(&header), sizeof(header));
+  bool ok = file_.good();
+  file_.close();
+  if (!ok) { msg_error_ = _T("In BinaryWriter::close, an error occur when writing the file.\n");}
+  return ok;
+}
+
+/* begin a new column. */
+bool BinaryWriter::beginColumn( int size, Base::IdType type, int eltSize, String const& name)
+{
+  if (!file_.is_open())
+  {
+    msg_error_ = _T("In BinaryWriter::beginColumn, the file is not opened.\n");
+    return false;
+  }
+  if (nbRows_ >= 0 && size != nbRows_)
+  {
+    msg_error_ = _T("In BinaryWriter::beginColumn, the columns must have the same number of rows.\n");
+    return false;
+  }
+  nbRows_ = size;
+  // align the data of the column
+  static const char zeros[BinaryColumns::ALIGNMENT] = {0};
+  std::streamoff pos = file_.tellp();
+  std::streamoff pad = (BinaryColumns::ALIGNMENT - pos % BinaryColumns::ALIGNMENT) % BinaryColumns::ALIGNMENT;
+  file_.write(zeros, pad);
+  BinaryColumns::ColumnHeader col;
+  std::memset(&col, 0, sizeof(col));
+  col.type_       = type;
+  col.eltSize_    = eltSize;
+  col.offset_     = pos + pad;
+  col.nameOffset_ = names_.size();
+  col.nameSize_   = name.size();
+  names_ += name;
+  columns_.push_back(col);
+  buffer_.clear();
+  return true;
+}
+
+/* flush the buffer and set the size of the current column */
+bool BinaryWriter::endColumn()
+{
+  flush();
+  BinaryColumns::ColumnHeader& col = columns_.back();
+  col.size_ = (long long)(file_.tellp()) - col.offset_;
+  if (!file_.good())
+  {
+    msg_error_ = _T("In BinaryWriter::endColumn, an error occur when writing the file.\n");
+    return false;
+  }
+  return true;
+}
+
+/* write the buffer in the file */
+void BinaryWriter::flush()
+{
+  if (buffer_.size() > 0) { file_.write(&buffer_.front(), buffer_.size());}
+  buffer_.clear();
+}
+
+/* write a String column */
+bool BinaryWriter::writeStrings( Variable<String> const& v)
+{
+  if (!beginColumn(v.size(), Base::string_, sizeof(Char), v.name())) return false;
+  // offsets of the strings
+  long long offset = 0;
+  for (int i=v.begin(); i<=v.lastIdx(); ++i)
+  {
+    append(&offset, sizeof(offset));
+    offset += v.elt(i).size();
+  }
+  append(&offset, sizeof(offset));
+  // characters
+  BinaryColumns::ColumnHeader& col = columns_.back();
+  for (int i=v.begin(); i<=v.lastIdx(); ++i)
+  {
+    String const& s = v.elt(i);
+    if (!Arithmetic<String>::isNA(s) && s != stringNa) ++col.nbAvailable_;
+    append(s.data(), s.size() * sizeof(Char));
+  }
+  return endColumn();
+}
+
+/* default constructor */
+BinaryReader::BinaryReader()
+                          : p_data_(0), size_(0), mapped_(false)
+                          , p_header_(0), p_columns_(0), p_names_(0)
+{}
+
+/* constructor. Open a file. */
+BinaryReader::BinaryReader( std::string const& fileName)
+                          : p_data_(0), size_(0), mapped_(false)
+                          , p_header_(0), p_columns_(0), p_names_(0)
+{ open(fileName);}
+
+/* destructor. Close the file if needed. */
+BinaryReader::~BinaryReader()
+{ close();}
+
+/* open a file */
+bool BinaryReader::open( std::string const& fileName)
+{
+  close();
+#ifdef _WIN32
+  // no mmap: read the file in memory
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    msg_error_ = _T("In BinaryReader::open, cannot open the file.\n");
+    return false;
+  }
+  file.seekg(0, std::ios::end);
+  size_ = size_t(file.tellg());
+  file.seekg(0, std::ios::beg);
+  p_data_ = static_cast<char*>(std::malloc(std::max(size_, size_t(1))));
+  if (!p_data_ || !file.read(p_data_, size_))
+  {
+    msg_error_ = _T("In BinaryReader::open, cannot read the file.\n");
+    close();
+    return false;
+  }
+  mapped_ = false;
+#else
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    msg_error_ = _T("In BinaryReader::open, cannot open the file.\n");
+    return false;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(BinaryColumns::FileHeader))
+  {
+    ::close(fd);
+    msg_error_ = _T("In BinaryReader::open, not a binary file.\n");
+    return false;
+  }
+  size_ = size_t(st.st_size);
+  // private mapping: the columns can be modified without modifying the file
+  void* p = ::mmap(0, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED)
+  {
+    size_ = 0;
+    msg_error_ = _T("In BinaryReader::open, cannot map the file.\n");
+    return false;
+  }
+  p_data_ = static_cast<char*>(p);
+  mapped_ = true;
+#endif
+  if (!check()) { close(); return false;}
+  return true;
+}
+
+/* unmap the file */
+void BinaryReader::close()
+{
+  if (p_data_)
+  {
+#ifdef _WIN32
+    std::free(p_data_);
+#else
+    if (mapped_) { ::munmap(p_data_, size_);}
+    else { std::free(p_data_);}
+#endif
+  }
+  p_data_ = 0; size_ = 0; mapped_ = false;
+  p_header_ = 0; p_columns_ = 0; p_names_ = 0;
+}
+
+/* @return the name of the column j */
+String BinaryReader::name( int j) const
+{ return String(p_names_ + p_columns_[j].nameOffset_, p_columns_[j].nameSize_);}
+
+/* @return the value of the row i of the String column j */
+String BinaryReader::string( int j, int i) const
+{
+  switch (type(j))
+  {
+    case Base::real_:    return typeToString(data<Real>(j)[i]);
+    case Base::integer_: return typeToString(data<Integer>(j)[i]);
+    default: break;
+  }
+  long long const* offsets = reinterpret_cast<long long const*>(p_data_ + p_columns_[j].offset_);
+  Char const* chars = reinterpret_cast<Char const*>(offsets + nbRows() + 1);
+  return String(chars + offsets[i], offsets[i+1] - offsets[i]);
+}
+
+/* wrap the consecutive Real columns first to last in an array. */
+bool BinaryReader::block( int first, int last, CArrayXX& a) const
+{
+  if (first < 0 || last >= nbCols() || last < first) return false;
+  for (int j=first; j<=last; ++j)
+  {
+    if (!data<Real>(j)) return false;
+    if (j > first && p_columns_[j].offset_ != p_columns_[j-1].offset_ + p_columns_[j-1].size_) return false;
+  }
+  a.move(CArrayXX(data<Real>(first), nbRows(), last - first + 1));
+  return true;
+}
+
+/* copy the columns in a DataFrame. */
+void BinaryReader::getDataFrame( DataFrame& df) const
+{
+  df.clear();
+  const int n = nbRows();
+  for (int j=0; j<nbCols(); ++j)
+  {
+    switch (type(j))
+    {
+      case Base::real_:
+      {
+        Variable<Real>* p_var = new Variable<Real>(Range(n), name(j));
+        Real const* p = data<Real>(j);
+        for (int i=0; i<n; ++i) { p_var->elt(p_var->begin() + i) = p[i];}
+        df.pushBackVariable(p_var);
+        break;
+      }
+      case Base::integer_:
+      {
+        Variable<Integer>* p_var = new Variable<Integer>(Range(n), name(j));
+        Integer const* p = data<Integer>(j);
+        for (int i=0; i<n; ++i) { p_var->elt(p_var->begin() + i) = p[i];}
+        df.pushBackVariable(p_var);
+        break;
+      }
+      default:
+      {
+        Variable<String>* p_var = new Variable<String>(Range(n), name(j));
+        for (int i=0; i<n; ++i) { p_var->elt(p_var->begin() + i) = string(j, i);}
+        df.pushBackVariable(p_var);
+        break;
+      }
+    }
+  }
+}
+
+/* check the header and the directory of the file */
+bool BinaryReader::check()
+{
+  if (size_ < sizeof(BinaryColumns::FileHeader))
+  {
+    msg_error_ = _T("In BinaryReader::check, not a binary file.\n");
+    return false;
+  }
+  BinaryColumns::FileHeader const* p_header = reinterpret_cast<BinaryColumns::FileHeader const*>(p_data_);
+  if (std::memcmp(p_header->magic_, BinaryColumns::MAGIC, sizeof(p_header->magic_)) != 0)
+  {
+    msg_error_ = _T("In BinaryReader::check, not a binary file.\n");
+    return false;
+  }
+  if (p_header->version_ > BinaryColumns::VERSION || p_header->naEncoding_ != 0)
+  {
+    msg_error_ = _T("In BinaryReader::check, unsupported version.\n");
+    return false;
+  }
+  if (p_header->endian_ != BinaryColumns::ENDIAN_TAG || p_header->charSize_ != (long long)sizeof(Char))
+  {
+    msg_error_ = _T("In BinaryReader::check, the file was written on an incompatible system.\n");
+    return false;
+  }
+  const long long size = size_, nbRows = p_header->nbRows_, nbCols = p_header->nbCols_;
+  if ( nbRows < 0 || nbCols < 0 || p_header->directory_ % BinaryColumns::ALIGNMENT != 0
+     || p_header->directory_ + nbCols * (long long)sizeof(BinaryColumns::ColumnHeader) > size
+     || p_header->names_ > size
+     )
+  {
+    msg_error_ = _T("In BinaryReader::check, the file is corrupted.\n");
+    return false;
+  }
+  BinaryColumns::ColumnHeader const* p_columns = reinterpret_cast<BinaryColumns::ColumnHeader const*>(p_data_ + p_header->directory_);
+  for (int j=0; j<nbCols; ++j)
+  {
+    BinaryColumns::ColumnHeader const& col = p_columns[j];
+    bool ok = (col.offset_ % BinaryColumns::ALIGNMENT == 0) && (col.offset_ + col.size_ <= size)
+           && (p_header->names_ + (col.nameOffset_ + col.nameSize_) * (long long)sizeof(Char) <= size);
+    if (col.type_ == Base::string_)
+    { ok = ok && (col.size_ >= (nbRows + 1) * (long long)sizeof(long long));}
+    else
+    { ok = ok && (col.size_ == nbRows * col.eltSize_);}
+    if (!ok)
+    {
+      msg_error_ = _T("In BinaryReader::check, the file is corrupted.\n");
+      return false;
+    }
+  }
+  p_header_  = p_header;
+  p_columns_ = p_columns;
+  p_names_   = reinterpret_cast<Char const*>(p_data_ + p_header->names_);
+  return true;
+}
+
+} // namespace STK
@@ -0,0 +1,127 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::DManager
+ * Purpose:  Implementation of the class CsvRowBlockSource.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_CsvRowBlockSource.cpp
+ *  @brief In this file we implement the class CsvRowBlockSource.
+ **/
+
+#include "../include/STK_CsvRowBlockSource.h"
+
+namespace STK
+{
+
+/* constructor. */
+CsvRowBlockSource::CsvRowBlockSource( std::string const& fileName
+                                    , bool withNames
+                                    , String const& delimiters
+                                    , int blockSize
+                                    )
+                                    : IRowBlockSource(blockSize)
+                                    , fileName_(fileName)
+                                    , withNames_(withNames)
+                                    , tokenizer_(delimiters)
+                                    , p_reader_(0), p_(0), end_(0)
+                                    , nbCols_(0), position_(0)
+{ rewind();}
+
+/* destructor */
+CsvRowBlockSource::~CsvRowBlockSource()
+{ if (p_reader_) delete p_reader_;}
+
+/* go back to the first row of the file */
+bool CsvRowBlockSource::rewind()
+{
+  if (p_reader_) { delete p_reader_; p_reader_ = 0;}
+  p_ = 0; end_ = 0; position_ = 0; nbCols_ = 0;
+  names_.clear();
+  if (file_.is_open()) file_.close();
+  file_.clear();
+  file_.open(fileName_.c_str());
+  if (!file_.is_open())
+  {
+    msg_error_ = Csv::ERRORCODES[4];
+    return false;
+  }
+  p_reader_ = new Csv::BlockReader(file_, 1 << 20);
+  // the first line gives the number of columns
+  Char const *b, *e;
+  if (!nextLine(b, e)) return true;
+  nbCols_ = tokenizer_.split(b, e, fields_);
+  if (withNames_)
+  {
+    for (int j=0; j<nbCols_; ++j)
+    { names_.push_back(String(fields_[j].first, fields_[j].second));}
+  }
+  else
+  { p_ = b;} // the first line will be read again
+  return true;
+}
+
+/* get the next block of rows. */
+bool CsvRowBlockSource::next( CArrayXX& block)
+{
+  if (!p_reader_ || nbCols_ == 0) return false;
+  block.resize(Range(baseIdx + position_, blockSize_), Range(baseIdx, nbCols_));
+  int i = baseIdx + position_;
+  Char const *b, *e;
+  while (i < baseIdx + position_ + blockSize_ && nextLine(b, e))
+  {
+    const int nbField = std::min(tokenizer_.split(b, e, fields_), nbCols_);
+    int j = 0;
+    for (; j<nbField; ++j)
+    { block(i, baseIdx + j) = Csv::FieldParser<Real>::parse(fields_[j].first, fields_[j].second);}
+    for (; j<nbCols_; ++j) { block(i, baseIdx + j) = Arithmetic<Real>::NA();}
+    ++i;
+  }
+  const int nbRows = i - baseIdx - position_;
+  if (nbRows == 0) return false;
+  if (nbRows < blockSize_)
+  {
+    CArrayXX last(block, Range(baseIdx + position_, nbRows), block.cols());
+    CArrayXX copy(last);
+    block.resize(Range(baseIdx + position_, nbRows), Range(baseIdx, nbCols_));
+    block = copy;
+  }
+  position_ += nbRows;
+  return true;
+}
+
+/* get the next line of the file */
+bool CsvRowBlockSource::nextLine( Char const*& b, Char const*& e)
+{
+  while (true)
+  {
+    if (p_ && tokenizer_.nextLine(p_, end_, b, e)) return true;
+    if (!p_reader_->next(p_, end_)) { p_ = end_; return false;}
+  }
+}
+
+} // namespace STK
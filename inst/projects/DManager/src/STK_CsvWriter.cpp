@@ -0,0 +1,464 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2015  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::DManager
+ * Purpose:  Implementation of the class CsvWriter.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_CsvWriter.cpp
+ *  @brief In this file we implement the class CsvWriter.
+ **/
+
+#include <cstring>
+#include <list>
+
+#include "../include/STK_CsvWriter.h"
+
+namespace STK
+{
+
+namespace hidden
+{
+/** @ingroup hidden
+ *  @brief Implementation of the Grisu2 algorithm of F. Loitsch ("Printing
+ *  floating-point numbers quickly and accurately with integers", PLDI 2010)
+ *  computing a short sequence of digits of a positive double which is read
+ *  back exactly.
+ **/
+struct Grisu2
+{
+  typedef unsigned long long uint64;
+  /** floating point number f * 2^e */
+  struct DiyFp
+  {
+    uint64 f_;
+    int e_;
+    DiyFp( uint64 f = 0, int e = 0): f_(f), e_(e) {}
+  };
+  /** cached power of ten 10^k = f * 2^e */
+  struct CachedPower
+  {
+    uint64 f_;
+    int e_;
+    int k_;
+  };
+  /** @return the upper 64 bits of the product x * y, rounded */
+  static DiyFp mul( DiyFp const& x, DiyFp const& y)
+  {
+    const uint64 uLo = x.f_ & 0xFFFFFFFFULL, uHi = x.f_ >> 32;
+    const uint64 vLo = y.f_ & 0xFFFFFFFFULL, vHi = y.f_ >> 32;
+    const uint64 p0 = uLo * vLo, p1 = uLo * vHi, p2 = uHi * vLo, p3 = uHi * vHi;
+    uint64 q = (p0 >> 32) + (p1 & 0xFFFFFFFFULL) + (p2 & 0xFFFFFFFFULL);
+    q += 1ULL << 31; // round
+    return DiyFp(p3 + (p1 >> 32) + (p2 >> 32) + (q >> 32), x.e_ + y.e_ + 64);
+  }
+  /** normalize x such that its most significant bit is set */
+  static DiyFp normalize( DiyFp x)
+  {
+    while ((x.f_ >> 63) == 0) { x.f_ <<= 1; --x.e_;}
+    return x;
+  }
+  /** compute the boundaries m- and m+ of the value v */
+  static void boundaries( double value, DiyFp& v, DiyFp& mMinus, DiyFp& mPlus)
+  {
+    const uint64 hiddenBit = 1ULL << 52;
+    uint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint64 F = bits & (hiddenBit - 1);
+    const int E = int(bits >> 52);
+    v = (E == 0) ? DiyFp(F, 1 - 1075) : DiyFp(F + hiddenBit, E - 1075);
+    const bool lowerIsCloser = (F == 0 && E > 1);
+    mPlus = normalize(DiyFp(2*v.f_ + 1, v.e_ - 1));
+    mMinus = lowerIsCloser ? DiyFp(4*v.f_ - 1, v.e_ - 2) : DiyFp(2*v.f_ - 1, v.e_ - 1);
+    mMinus.f_ <<= (mMinus.e_ - mPlus.e_);
+    mMinus.e_ = mPlus.e_;
+  }
+  /** @return the cached power c such that the exponent of c * 2^e is in
+   *  [-60, -32]
+   **/
+  static CachedPower cachedPower( int e)
+  {
+    static const CachedPower powers[] =
+    {
+      { 0xAB70FE17C79AC6CAULL, -1060, -300},
+      { 0xFF77B1FCBEBCDC4FULL, -1034, -292},
+      { 0xBE5691EF416BD60CULL, -1007, -284},
+      { 0x8DD01FAD907FFC3CULL,  -980, -276},
+      { 0xD3515C2831559A83ULL,  -954, -268},
+      { 0x9D71AC8FADA6C9B5ULL,  -927, -260},
+      { 0xEA9C227723EE8BCBULL,  -901, -252},
+      { 0xAECC49914078536DULL,  -874, -244},
+      { 0x823C12795DB6CE57ULL,  -847, -236},
+      { 0xC21094364DFB5637ULL,  -821, -228},
+      { 0x9096EA6F3848984FULL,  -794, -220},
+      { 0xD77485CB25823AC7ULL,  -768, -212},
+      { 0xA086CFCD97BF97F4ULL,  -741, -204},
+      { 0xEF340A98172AACE5ULL,  -715, -196},
+      { 0xB23867FB2A35B28EULL,  -688, -188},
+      { 0x84C8D4DFD2C63F3BULL,  -661, -180},
+      { 0xC5DD44271AD3CDBAULL,  -635, -172},
+      { 0x936B9FCEBB25C996ULL,  -608, -164},
+      { 0xDBAC6C247D62A584ULL,  -582, -156},
+      { 0xA3AB66580D5FDAF6ULL,  -555, -148},
+      { 0xF3E2F893DEC3F126ULL,  -529, -140},
+      { 0xB5B5ADA8AAFF80B8ULL,  -502, -132},
+      { 0x87625F056C7C4A8BULL,  -475, -124},
+      { 0xC9BCFF6034C13053ULL,  -449, -116},
+      { 0x964E858C91BA2655ULL,  -422, -108},
+      { 0xDFF9772470297EBDULL,  -396, -100},
+      { 0xA6DFBD9FB8E5B88FULL,  -369,  -92},
+      { 0xF8A95FCF88747D94ULL,  -343,  -84},
+      { 0xB94470938FA89BCFULL,  -316,  -76},
+      { 0x8A08F0F8BF0F156BULL,  -289,  -68},
+      { 0xCDB02555653131B6ULL,  -263,  -60},
+      { 0x993FE2C6D07B7FACULL,  -236,  -52},
+      { 0xE45C10C42A2B3B06ULL,  -210,  -44},
+      { 0xAA242499697392D3ULL,  -183,  -36},
+      { 0xFD87B5F28300CA0EULL,  -157,  -28},
+      { 0xBCE5086492111AEBULL,  -130,  -20},
+      { 0x8CBCCC096F5088CCULL,  -103,  -12},
+      { 0xD1B71758E219652CULL,   -77,   -4},
+      { 0x9C40000000000000ULL,   -50,    4},
+      { 0xE8D4A51000000000ULL,   -24,   12},
+      { 0xAD78EBC5AC620000ULL,     3,   20},
+      { 0x813F3978F8940984ULL,    30,   28},
+      { 0xC097CE7BC90715B3ULL,    56,   36},
+      { 0x8F7E32CE7BEA5C70ULL,    83,   44},
+      { 0xD5D238A4ABE98068ULL,   109,   52},
+      { 0x9F4F2726179A2245ULL,   136,   60},
+      { 0xED63A231D4C4FB27ULL,   162,   68},
+      { 0xB0DE65388CC8ADA8ULL,   189,   76},
+      { 0x83C7088E1AAB65DBULL,   216,   84},
+      { 0xC45D1DF942711D9AULL,   242,   92},
+      { 0x924D692CA61BE758ULL,   269,  100},
+      { 0xDA01EE641A708DEAULL,   295,  108},
+      { 0xA26DA3999AEF774AULL,   322,  116},
+      { 0xF209787BB47D6B85ULL,   348,  124},
+      { 0xB454E4A179DD1877ULL,   375,  132},
+      { 0x865B86925B9BC5C2ULL,   402,  140},
+      { 0xC83553C5C8965D3DULL,   428,  148},
+      { 0x952AB45CFA97A0B3ULL,   455,  156},
+      { 0xDE469FBD99A05FE3ULL,   481,  164},
+      { 0xA59BC234DB398C25ULL,   508,  172},
+      { 0xF6C69A72A3989F5CULL,   534,  180},
+      { 0xB7DCBF5354E9BECEULL,   561,  188},
+      { 0x88FCF317F22241E2ULL,   588,  196},
+      { 0xCC20CE9BD35C78A5ULL,   614,  204},
+      { 0x98165AF37B2153DFULL,   641,  212},
+      { 0xE2A0B5DC971F303AULL,   667,  220},
+      { 0xA8D9D1535CE3B396ULL,   694,  228},
+      { 0xFB9B7CD9A4A7443CULL,   720,  236},
+      { 0xBB764C4CA7A44410ULL,   747,  244},
+      { 0x8BAB8EEFB6409C1AULL,   774,  252},
+      { 0xD01FEF10A657842CULL,   800,  260},
+      { 0x9B10A4E5E9913129ULL,   827,  268},
+      { 0xE7109BFBA19C0C9DULL,   853,  276},
+      { 0xAC2820D9623BF429ULL,   880,  284},
+      { 0x80444B5E7AA7CF85ULL,   907,  292},
+      { 0xBF21E44003ACDD2DULL,   933,  300},
+      { 0x8E679C2F5E44FF8FULL,   960,  308},
+      { 0xD433179D9C8CB841ULL,   986,  316},
+      { 0x9E19DB92B4E31BA9ULL,  1013,  324}
+    };
+    const int f = -60 - e - 1;
+    const int k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+    return powers[(300 + k + 7) / 8];
+  }
+  /** @return the number of digits of n and set pow10 = 10^(digits-1) */
+  static int largestPow10( unsigned int n, unsigned int& pow10)
+  {
+    static const unsigned int p[] = { 1, 10, 100, 1000, 10000, 100000, 1000000
+                                    , 10000000, 100000000, 1000000000};
+    int k = 10;
+    while (k > 1 && n < p[k-1]) --k;
+    pow10 = p[k-1];
+    return k;
+  }
+  /** move the last digit toward the exact value */
+  static void round( char* buffer, int length, uint64 dist, uint64 delta, uint64 rest, uint64 tenK)
+  {
+    while ( rest < dist && delta - rest >= tenK
+         && (rest + tenK < dist || dist - rest > rest + tenK - dist))
+    { --buffer[length - 1]; rest += tenK;}
+  }
+  /** generate the digits of w in [mMinus, mPlus] */
+  static void digits( char* buffer, int& length, int& exp10, DiyFp const& mMinus, DiyFp const& w, DiyFp const& mPlus)
+  {
+    uint64 delta = mPlus.f_ - mMinus.f_, dist = mPlus.f_ - w.f_;
+    const int shift = -mPlus.e_;
+    const uint64 one = 1ULL << shift;
+    unsigned int p1 = (unsigned int)(mPlus.f_ >> shift);
+    uint64 p2 = mPlus.f_ & (one - 1);
+    // integral part
+    unsigned int pow10;
+    int n = largestPow10(p1, pow10);
+    while (n > 0)
+    {
+      buffer[length++] = char('0' + p1 / pow10);
+      p1 %= pow10;
+      --n;
+      const uint64 rest = (uint64(p1) << shift) + p2;
+      if (rest <= delta)
+      {
+        exp10 += n;
+        round(buffer, length, dist, delta, rest, uint64(pow10) << shift);
+        return;
+      }
+      pow10 /= 10;
+    }
+    // fractional part
+    int m = 0;
+    while (true)
+    {
+      p2 *= 10; delta *= 10; dist *= 10;
+      buffer[length++] = char('0' + (p2 >> shift));
+      p2 &= one - 1;
+      ++m;
+      if (p2 <= delta) break;
+    }
+    exp10 -= m;
+    round(buffer, length, dist, delta, p2, one);
+  }
+  /** compute the digits of a positive finite value.
+   *  @param value the value
+   *  @param buffer the buffer of the digits (at least 17 characters)
+   *  @param length the number of digits
+   *  @param exp10 the decimal exponent: value = digits * 10^exp10
+   **/
+  static void run( double value, char* buffer, int& length, int& exp10)
+  {
+    DiyFp v, mMinus, mPlus;
+    boundaries(value, v, mMinus, mPlus);
+    const CachedPower c = cachedPower(mPlus.e_);
+    const DiyFp cK(c.f_, c.e_);
+    const DiyFp w = mul(normalize(v), cK), wMinus = mul(mMinus, cK), wPlus = mul(mPlus, cK);
+    length = 0;
+    exp10 = -c.k_;
+    digits(buffer, length, exp10, DiyFp(wMinus.f_ + 1, wMinus.e_), w, DiyFp(wPlus.f_ - 1, wPlus.e_));
+  }
+};
+
+} // namespace hidden
+
+namespace Csv
+{
+/* write a real in a buffer. */
+int FieldFormatter<Real>::format( Real x, Char* str)
+{
+  int k = 0;
+  if (x < 0) { str[k++] = _T('-'); x = -x;}
+  if (x == 0) { str[0] = _T('0'); return 1;}
+  if (!(x <= std::numeric_limits<Real>::max()))
+  {
+    str[k++] = _T('i'); str[k++] = _T('n'); str[k++] = _T('f');
+    return k;
+  }
+  char digits[20];
+  int length, exp10;
+  hidden::Grisu2::run(double(x), digits, length, exp10);
+  // position of the decimal point
+  const int n = length + exp10;
+  if (length <= n && n <= 15)
+  { // integer: digits followed by zeros
+    for (int i=0; i<length; ++i) str[k++] = Char(digits[i]);
+    for (int i=length; i<n; ++i) str[k++] = _T('0');
+  }
+  else if (0 < n && n <= 15)
+  { // dig.its
+    for (int i=0; i<n; ++i) str[k++] = Char(digits[i]);
+    str[k++] = _T('.');
+    for (int i=n; i<length; ++i) str[k++] = Char(digits[i]);
+  }
+  else if (-4 < n && n <= 0)
+  { // 0.[000]digits
+    str[k++] = _T('0'); str[k++] = _T('.');
+    for (int i=n; i<0; ++i) str[k++] = _T('0');
+    for (int i=0; i<length; ++i) str[k++] = Char(digits[i]);
+  }
+  else
+  { // d.igitse+xx
+    str[k++] = Char(digits[0]);
+    if (length > 1)
+    {
+      str[k++] = _T('.');
+      for (int i=1; i<length; ++i) str[k++] = Char(digits[i]);
+    }
+    int e = n - 1;
+    str[k++] = _T('e');
+    str[k++] = (e < 0) ? _T('-') : _T('+');
+    if (e < 0) e = -e;
+    if (e < 10) str[k++] = _T('0');
+    k += FieldFormatter<Integer>::formatInteger(e, str + k);
+  }
+  return k;
+}
+
+} // namespace Csv
+
+/** append the element of the row i (starting at 0) of a variable.
+ *  @param p_var the variable
+ *  @param i the row
+ *  @param buffer the buffer to fill
+ **/
+template<typename Type>
+static inline void appendElt( IVariable const* p_var, int i, String& buffer)
+{
+  Variable<Type> const& x = *static_cast<Variable<Type> const*>(p_var);
+  if (i < x.size()) { Csv::FieldFormatter<Type>::append(x.elt(x.begin() + i), buffer);}
+  else { buffer += stringNa;}
+}
+
+/* constructor. Open the file. */
+CsvWriter::CsvWriter( std::string const& fileName, bool withNames, String const& delimiter)
+                    : file_(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc)
+                    , withNames_(withNames)
+                    , delimiter_(delimiter.empty() ? CHAR_SEP : delimiter[0])
+                    , chunkSize_(4096)
+                    , buffers_(1)
+{
+#ifdef _OPENMP
+  buffers_.resize(2*omp_get_max_threads());
+#endif
+  if (!file_.is_open()) { msg_error_ = Csv::ERRORCODES[4];}
+}
+
+/* destructor. Close the file if needed. */
+CsvWriter::~CsvWriter()
+{ if (file_.is_open()) close();}
+
+/* write the rows of a DataFrame. */
+bool CsvWriter::write( DataFrame const& df)
+{
+  // the variables to write, the variables of other types are converted
+  std::vector<IVariable const*> vars;
+  std::vector<String> names;
+  std::list< Variable<String> > converted;
+  for (int j=df.beginCols(); j<df.endCols(); ++j)
+  {
+    IVariable const* p_var = df.elt(j);
+    if (!p_var) continue;
+    names.push_back(p_var->name());
+    switch (p_var->getType())
+    {
+      case Base::real_:
+      case Base::integer_:
+      case Base::string_:
+        vars.push_back(p_var);
+        break;
+      default:
+        converted.push_back(Variable<String>());
+        p_var->exportAsString(converted.back());
+        vars.push_back(&converted.back());
+        break;
+    }
+  }
+  if (!writeHeader(names)) return false;
+  const int nbRows = df.sizeRows(), nbBuffer = int(buffers_.size());
+  for (int first = 0; first < nbRows; first += nbBuffer * chunkSize_)
+  {
+    const int nb = std::min(nbBuffer, (nbRows - first + chunkSize_ - 1)/chunkSize_);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (double(nbRows)*vars.size() > ParallelThreshold)
+#endif
+    for (int k=0; k<nb; ++k)
+    {
+      const int begin = first + k * chunkSize_;
+      buffers_[k].clear();
+      formatRows(vars, begin, std::min(begin + chunkSize_, nbRows), buffers_[k]);
+    }
+    if (!flush(nb)) return false;
+  }
+  return true;
+}
+
+/* close the file. */
+bool CsvWriter::close()
+{
+  if (!file_.is_open()) return false;
+  file_.close();
+  if (file_.fail())
+  {
+    msg_error_ = Csv::ERRORCODES[1];
+    return false;
+  }
+  return true;
+}
+
+/* check the file and write the names if needed. */
+bool CsvWriter::writeHeader( std::vector<String> const& names)
+{
+  if (!file_.is_open())
+  {
+    msg_error_ = Csv::ERRORCODES[4];
+    return false;
+  }
+  if (!withNames_) return true;
+  String line;
+  for (size_t j=0; j<names.size(); ++j)
+  {
+    if (j) line += delimiter_;
+    line += names[j];
+  }
+  line += CHAR_NL;
+  file_.write(line.data(), line.size());
+  // the names are written only once
+  withNames_ = false;
+  return !file_.fail();
+}
+
+/* write the buffers [0, nb) in the file */
+bool CsvWriter::flush( int nb)
+{
+  for (int k=0; k<nb; ++k) { file_.write(buffers_[k].data(), buffers_[k].size());}
+  if (file_.fail())
+  {
+    msg_error_ = Csv::ERRORCODES[1];
+    return false;
+  }
+  return true;
+}
+
+/* format the rows [first, last) of the variables of a DataFrame. */
+void CsvWriter::formatRows( std::vector<IVariable const*> const& vars, int first, int last, String& buffer) const
+{
+  for (int i=first; i<last; ++i)
+  {
+    for (size_t j=0; j<vars.size(); ++j)
+    {
+      if (j) buffer += delimiter_;
+      switch (vars[j]->getType())
+      {
+        case Base::real_:    appendElt<Real>(vars[j], i, buffer); break;
+        case Base::integer_: appendElt<Integer>(vars[j], i, buffer); break;
+        default:             appendElt<String>(vars[j], i, buffer); break;
+      }
+    }
+    buffer += CHAR_NL;
+  }
+}
+
+} // namespace STK
@@ -53,6 +53,7 @@ namespace DManager
 TypeDataFile stringToTypeDataFile( String const& type)
 {
   if (toUpperString(type) == toUpperString(_T("csv")))  return csv_;
+  if (toUpperString(type) == toUpperString(_T("binary")))  return binary_;
   return unknown_;
 }
 
@@ -64,6 +65,7 @@ TypeDataFile stringToTypeDataFile( String const& type)
 String TypeDataFileToString( TypeDataFile const& type)
 {
   if (type == csv_)  return String(_T("csv"));
+  if (type == binary_)  return String(_T("binary"));
   return String(_T("unknown"));
 }
 
@@ -57,7 +57,7 @@ bool DataHandler::readDataFromCsvFile( std::string const& datafile
   desc[baseIdx] = idModel ; desc[baseIdx+1] = idData;
   // store data and descriptors
   if (!addInfo(idData, idModel)) return false;
-  data_ += data;
+  if (!appendData(data)) return false;
   // store descriptor : this is the same for all the columns added
   for (int j=data.beginCols(); j< data.endCols(); ++j)
   { descriptor_.push_back(desc);}
@@ -112,7 +112,7 @@ bool DataHandler::readDataFromCsvFile(std::string const& datafile, std::string d
     if (!addInfo(idData, idModel)) return false;
   }
   // store data and descriptors
-  data_       += rwdata;
+  if (!appendData(rwdata)) return false;
   descriptor_ += rwdesc;
   return true;
 }
@@ -124,7 +124,7 @@ void DataHandler::removeData(std::string const& idData)
   for (int i = descriptor_.endCols()-1; i >= descriptor_.beginCols(); --i)
   { if (descriptor_.var(i)[rowIdData] == idData)
     {
-      data_.eraseColumn(i);
+      data_.eraseCols(i);
       descriptor_.eraseColumn(i);
      }
   }
@@ -144,6 +144,72 @@ std::vector<int> DataHandler::colIndex(std::string const& idData) const
   return colindex;
 }
 
+/* convert the columns of a ReadWriteCsv in typed variables and append
+ *  them to the data.
+ **/
+bool DataHandler::appendData(ReadWriteCsv const& rw)
+{
+  const int first = rw.begin(), nbCol = rw.size();
+  std::vector<IVariable*> vars(nbCol, (IVariable*)0);
+  bool failed = false;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(||:failed) if (double(rw.sizeRows()) * nbCol > ParallelThreshold)
+#endif
+  for (int k=0; k<nbCol; k++)
+  {
+    try { vars[k] = parseVariable(rw.var(first + k), rw.isNumeric(first + k));}
+    catch(...) { failed = true;}
+  }
+  if (failed)
+  {
+    for (int k=0; k<nbCol; k++) { if (vars[k]) delete vars[k];}
+    stk_cerr << _T("An error occur when converting the data.\n");
+    return false;
+  }
+  for (int k=0; k<nbCol; k++) { data_.pushBackVariable(vars[k]);}
+  return true;
+}
+
+/* convert a column of String in a typed variable. */
+IVariable* DataHandler::parseVariable(Variable<String> const& column, int isNumeric)
+{
+  // the column is known to be not numeric
+  if (isNumeric == 0) return encodeVariable(column);
+  // unknown: the whole fields have to be numbers, not only their beginning
+  if (isNumeric < 0)
+  {
+    for (int i=column.begin(); i<=column.lastIdx(); ++i)
+    { if (!Csv::isNumericValue(column.elt(i))) return encodeVariable(column);}
+  }
+  Variable<Real>* p_real = new Variable<Real>();
+  if (p_real->importFromString(column) != column.size())
+  {
+    delete p_real;
+    return encodeVariable(column);
+  }
+  // check if the values are integers
+  for (int i=p_real->begin(); i<=p_real->lastIdx(); ++i)
+  {
+    Real const& x = p_real->elt(i);
+    if ( !Arithmetic<Real>::isNA(x)
+       &&(x != std::floor(x) || !(std::abs(x) <= std::numeric_limits<Integer>::max()))
+       ) return p_real;
+  }
+  Variable<Integer>* p_int = new Variable<Integer>(p_real->range(), column.name());
+  for (int i=p_real->begin(); i<=p_real->lastIdx(); ++i)
+  { p_int->elt(i) = hidden::DataHandlerCast<Real, Integer>::run(p_real->elt(i));}
+  delete p_real;
+  return p_int;
+}
+
+/* @return an encoded copy of a column of String */
+IVariable* DataHandler::encodeVariable(Variable<String> const& column)
+{
+  Variable<String>* p_str = column.clone();
+  if (!p_str->isEncoded()) p_str->encode();
+  return p_str;
+}
+
 
 } // namespace STK
 
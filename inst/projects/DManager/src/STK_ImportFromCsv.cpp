@@ -90,21 +90,7 @@ bool ImportFromCsv::asNumeric()
   try
   {
     // for each field Try a numeric conversion
-    for (int j =import_.begin(); j <=import_.lastIdx(); j++)
-    {
-      Variable<Real>* pvReal = new Variable<Real>();
-      // test number of successful conversion
-      if (import<Real>(j, *pvReal)==import_.sizeRow(j))
-      {  // if no failure add variable to the dataframe
-         p_dataFrame_->pushBackVariable(pvReal);
-      }
-      else
-      {
-        delete pvReal; // delete varReal
-        Variable<String>* pvString = import_.clone(j);
-        p_dataFrame_->pushBackVariable(pvString);
-      }
-    }
+    numericVariables(true);
   }
   catch(const Exception& error)
   {
@@ -121,16 +107,7 @@ bool ImportFromCsv::asOnlyNumeric()
   try
   {
     // for each field Try a numeric conversion
-    for (int j =import_.begin(); j <import_.end(); j++)
-    {
-      Variable<Real>* pvReal = new Variable<Real>;
-      // test number of successful conversion
-      if (import<Real>(j, *pvReal) == import_.sizeRow(j))
-      {  // if no failure add variable to the dataframe
-         p_dataFrame_->pushBackVariable(pvReal);
-      }
-      else delete pvReal;
-    }
+    numericVariables(false);
   }
   catch(const Exception& error)
   {
@@ -163,4 +140,41 @@ bool ImportFromCsv::asString()
 }
 
 
+/* convert a column of the csv in a numeric variable. */
+IVariable* ImportFromCsv::numericVariable( int iCol, bool keepString)
+{
+  // try a conversion unless the column is known to be not numeric
+  if (import_.isNumeric(iCol) != 0)
+  {
+    Variable<Real>* pvReal = new Variable<Real>();
+    // test number of successful conversion
+    if (import<Real>(iCol, *pvReal) == import_.sizeRow(iCol)) return pvReal;
+    delete pvReal;
+  }
+  return keepString ? import_.clone(iCol) : 0;
+}
+
+/* convert all the columns of the csv in parallel */
+void ImportFromCsv::numericVariables( bool keepString)
+{
+  const int first = import_.begin(), nbCol = import_.size();
+  std::vector<IVariable*> vars(nbCol, (IVariable*)0);
+  bool failed = false;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(||:failed) if (double(import_.sizeRows()) * nbCol > ParallelThreshold)
+#endif
+  for (int k=0; k<nbCol; k++)
+  {
+    try { vars[k] = numericVariable(first + k, keepString);}
+    catch(...) { failed = true;}
+  }
+  if (failed)
+  {
+    for (int k=0; k<nbCol; k++) { if (vars[k]) delete vars[k];}
+    STKRUNTIME_ERROR_NO_ARG(ImportFromCsv::numericVariables,conversion failed);
+  }
+  // add the variables to the dataframe
+  for (int k=0; k<nbCol; k++) { if (vars[k]) p_dataFrame_->pushBackVariable(vars[k]);}
+}
+
 } // namespace STK
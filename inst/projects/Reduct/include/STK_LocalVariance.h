@@ -37,6 +37,7 @@
 
 #include "STK_Reduct_Util.h"
 #include "STK_ILinearReduct.h"
+#include "STK_NeighborGraph.h"
 
 #include <Arrays/include/STK_Array2D.h>
 #include <STatistiK/include/STK_Stat_MultivariateReal.h>
@@ -50,8 +51,14 @@ namespace STK
  *
  *  A LocalVariance is an Index which maximize the projected local
  *  variance of the data set.
- *  The class can use the algorithm of Prim or the minimal distance
- *  in order to compute the proximity graph defining the local variance.
+ *  The class can use the minimal spanning tree (@c prim_) or the minimal
+ *  distances (@c distance_) in order to compute the proximity graph defining
+ *  the local variance. The graphs are computed by the NeighborGraph class,
+ *  exactly or, for large data sets, approximately using a random projection
+ *  forest (@c approxDistance_) and a spanning tree of the approximate
+ *  neighbors graph (@c approxPrim_). The spanning trees give one neighbor
+ *  (the predecessor) to each individual, so that the number of neighbors is
+ *  set to one for these graphs.
  *
  *  This class derive from ILinearReduct which derive itself from IRunnerUnsupervised.
  *  The @c run() and @c run(weights) methods have been implemented in the
@@ -134,6 +141,8 @@ class LocalVariance : public ILinearReduct<Array, Vector>
      */
     virtual void maximizeStep( Vector const& weights);
 
+    /** compute the proximity graph of the data set */
+    void computeGraph();
     /** compute the minimal spanning tree */
     void prim();
     /** compute the minimal distance graph */
@@ -143,6 +152,13 @@ class LocalVariance : public ILinearReduct<Array, Vector>
     void computeCovarianceMatrices();
     /** compute the weighted covariances matrices of the data set */
     void computeCovarianceMatrices( Vector const& weights);
+    /** compute the (weighted) local covariance matrix of the data set. The
+     *  matrix is the Gram matrix of the differences between the individuals
+     *  and their neighbors. These differences are computed by tiles of edges
+     *  which are never stored together.
+     *  @param p_weights pointer on the weights of the individuals (can be null)
+     **/
+    void computeLocalCovariance( Vector const* p_weights);
 
   private:
     /** compute the axis using the first eigenvectors of the matrix
@@ -172,22 +188,8 @@ LocalVariance<Array>::LocalVariance( Array const* p_data
 
 {
   if (!p_data) return;
-  neighbors_.resize(p_data->rows(), Range(1,nbNeighbor_));
-  dist_.resize(p_data->rows(), Range(1,nbNeighbor_));
-  dist_ = Arithmetic<Real>::max();
   // compute minimal proximity graph of the data set
-  switch (type_)
-  {
-    case Reduct::prim_:
-      prim();
-      break;
-    case Reduct::distance_:
-      minimalDistance();
-      break;
-    case Reduct::unknown_graph_:
-      STKRUNTIME_ERROR_NO_ARG(LocalVariance::LocalVariance(data, type, nbNeighbor),unknown proximity graph);
-      break;
-  };
+  computeGraph();
 }
 
 /*
@@ -200,22 +202,11 @@ LocalVariance<Array>::LocalVariance( Array const& data
                                   : Base(data)
                                   , type_(type)
                                   , nbNeighbor_(nbNeighbor)
-                                  , neighbors_(data.rows(), Range(1,nbNeighbor_))
-                                  , dist_(data.rows(), Range(1,nbNeighbor_), Arithmetic<Real>::max())
+                                  , neighbors_()
+                                  , dist_()
 {
   // compute minimal proximity graph of the data set
-  switch (type_)
-  {
-    case Reduct::prim_:
-      prim();
-      break;
-    case Reduct::distance_:
-      minimalDistance();
-      break;
-    case Reduct::unknown_graph_:
-      STKRUNTIME_ERROR_NO_ARG(LocalVariance::LocalVariance(data, type, nbNeighbor),unknown proximity graph);
-      break;
-  };
+  computeGraph();
 }
 
 /** copy Constructor.
@@ -246,21 +237,8 @@ void LocalVariance<Array>::update()
   if (!p_data_)
   { STKRUNTIME_ERROR_NO_ARG(LocalVariance::update,data is not set);}
 #endif
-  // update dimensions of the containers for the proximity graph
-  neighbors_.resize(p_data_->rows(), Range(1,nbNeighbor_));
   // compute minimal proximity graph of the data set
-  switch (type_)
-  {
-    case Reduct::prim_:
-      prim();
-      break;
-    case Reduct::distance_:
-      minimalDistance();
-      break;
-    case Reduct::unknown_graph_:
-      STKRUNTIME_ERROR_NO_ARG(LocalVariance::update,unknown proximity graph);
-      break;
-  };
+  computeGraph();
 }
 
 /*
@@ -308,27 +286,8 @@ void LocalVariance<Array>::computeCovarianceMatrices()
   stats_.setData(p_data_);
   stats_.run();
   covariance_.move(stats_.covariance());
-  // constants
-  const Real pond = 2* nbNeighbor_ * p_data_->sizeRows();
-
   // compute local covariance matrix
-  localCovariance_.resize(p_data_->cols());
-  for (int j=p_data_->beginCols(); j<p_data_->endCols(); j++)
-  {
-    for (int k=p_data_->beginCols(); k<p_data_->endCols(); k++)
-    {
-      Real sum = 0.0;
-      for (int i=p_data_->beginRows(); i<p_data_->endRows(); i++)
-      {
-        for (int l = 1; l <= nbNeighbor_; ++l)
-        {
-          sum += ((*p_data_)(i, j) - (*p_data_)(neighbors_(i, l), j))
-               * ((*p_data_)(i, k) - (*p_data_)(neighbors_(i, l), k));
-        }
-      }
-      localCovariance_(j, k) = sum/pond;
-    }
-  }
+  computeLocalCovariance(0);
 }
 
 /* compute the weighted covariances matrices of the data set */
@@ -341,27 +300,61 @@ void LocalVariance<Array>::computeCovarianceMatrices( Vector const& weights)
   stats_.run(weights);
   covariance_.move(stats_.covariance());
 
-  // get dimensions
-  const Real pond = 2* nbNeighbor_ * p_data_->sizeRows() ;
   // compute weighted local covariance matrix
-  localCovariance_.resize(p_data_->cols());
-  for (int i=p_data_->beginCols(); i<p_data_->endCols(); i++)
+  computeLocalCovariance(&weights);
+}
+
+/* compute the (weighted) local covariance matrix of the data set */
+template<class Array>
+void LocalVariance<Array>::computeLocalCovariance( Vector const* p_weights)
+{
+  const int first = p_data_->beginRows(), n = p_data_->sizeRows();
+  const int p = p_data_->sizeCols(), firstCol = p_data_->beginCols();
+  const Real pond = 2* nbNeighbor_ * n;
+  // number of individuals in a tile of edges
+  const int tileRows = std::max(256/std::max(nbNeighbor_, 1), 1);
+  const int nbTiles = (n + tileRows - 1) / tileRows;
+  int nbThreads = 1;
+#ifdef _OPENMP
+  if (double(n) * nbNeighbor_ * p * p > ParallelThreshold)
+  { nbThreads = std::max(std::min(nbTiles, omp_get_max_threads()), 1);}
+#endif
+  // each thread accumulates the Gram matrices of a contiguous set of tiles
+  std::vector<CArrayXX> partial(nbThreads, CArrayXX(p, p, 0.));
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(nbThreads)
+#endif
+  for (int k = 0; k < nbThreads; ++k)
   {
-    for (int j=p_data_->beginCols(); j<p_data_->endCols(); j++)
+    CArrayXX diff, wdiff, prod;
+    for (int t = (k * nbTiles) / nbThreads; t < ((k+1) * nbTiles) / nbThreads; ++t)
     {
-      Real sum = 0.0;
-      for (int k=p_data_->beginRows(); k<p_data_->endRows(); k++)
+      const int begin = first + t * tileRows, end = std::min(begin + tileRows, first + n);
+      const int nbEdges = (end - begin) * nbNeighbor_;
+      diff.resize(nbEdges, p);
+      wdiff.resize(nbEdges, p);
+      for (int j = 0; j < p; ++j)
       {
-        for (int l = 1; l <= nbNeighbor_; ++l)
+        int e = 0;
+        for (int i = begin; i < end; ++i)
         {
-          sum += (weights[k] * weights[neighbors_(k, l)])
-               * ((*p_data_)(k, i) - (*p_data_)(neighbors_(k, l), i))
-               * ((*p_data_)(k, j) - (*p_data_)(neighbors_(k, l), j));
+          for (int l = 1; l <= nbNeighbor_; ++l, ++e)
+          {
+            const int nb = neighbors_(i, l);
+            diff(e, j) = (*p_data_)(i, firstCol + j) - (*p_data_)(nb, firstCol + j);
+            wdiff(e, j) = p_weights ? ((*p_weights)[i] * (*p_weights)[nb]) * diff(e, j) : diff(e, j);
+          }
         }
       }
-      localCovariance_(i, j) = sum / pond;
+      prod = diff.transpose() * wdiff;
+      partial[k] += prod;
     }
   }
+  for (int k = 1; k < nbThreads; ++k) { partial[0] += partial[k];}
+  localCovariance_.resize(p_data_->cols());
+  for (int j = 0; j < p; ++j)
+    for (int i = 0; i < p; ++i)
+    { localCovariance_(firstCol + i, firstCol + j) = 0.5 * (partial[0](i, j) + partial[0](j, i)) / pond;}
 }
 
 /* compute the axis
@@ -391,107 +384,56 @@ void LocalVariance<Array>::computeAxis()
   delete decomp;
 }
 
+/* compute the proximity graph of the data set */
 template<class Array>
-void LocalVariance<Array>::prim()
+void LocalVariance<Array>::computeGraph()
 {
-  // get dimensions
-  const int begin_ind = p_data_->beginRows();
-  const int last_ind = p_data_->lastIdxRows();
-  /* value vector : store the minimal value. */
-  Vector value(p_data_->rows(), Arithmetic<Real>::max());
-  /* position of the points */
-  Array1D<int> ipos(p_data_->rows());
-  // Initialization the position array
-  for (int i=begin_ind; i<=last_ind; i++) ipos[i] = i;
-
-  // start Prim algorithm
-  //Initialization of the root
-  value[begin_ind] = 0.0;               // the root have value 0.0
-  neighbors_(begin_ind, 1) = begin_ind;          // and have itself as predecessor
-  int imin = begin_ind;             // the index of the current minimal value
-  Real    kmin = 0.0;                   // the current minimal value
-  // begin iterations
-  for (int iter = last_ind; iter>=begin_ind; iter--)
+  switch (type_)
   {
-    // put the minimal key at the end of the array key_
-    value.swap(imin, iter);  // put the minimal value to the end
-    ipos.swap(imin, iter);   // update the position of current minimal point
-    // Update the value for the neighbors points and find minimal value
-    imin = begin_ind;
-    kmin = value[begin_ind];
-    // reference on the current point
-    int icur = ipos[iter];
-    RowVector P(p_data_->row(icur), true);
-    // update distance of the neighbors point
-    for (int i=begin_ind; i<iter; i++)
+    case Reduct::prim_:
+      prim();
+      break;
+    case Reduct::distance_:
+      minimalDistance();
+      break;
+    case Reduct::approxPrim_:
     {
-      // check if we have a better distance for the neighbors
-      Real d=dist(P, p_data_->row(ipos[i]));
-      if (d < value[i])
-      {
-        value[i] = d;
-        neighbors_(ipos[i], 1) = icur;
-      }
-      // minimal key
-      if (kmin>value[i]) { imin=i; kmin = value[i];}
+      NeighborGraph<Array> graph(*p_data_);
+      ArrayXXi knn;
+      graph.approxKnn(std::max(nbNeighbor_, 10), knn, dist_);
+      graph.mst(knn, dist_, neighbors_);
+      nbNeighbor_ = 1;
+      dist_.clear();
+      break;
     }
-  }
+    case Reduct::approxDistance_:
+    {
+      NeighborGraph<Array> graph(*p_data_);
+      graph.approxKnn(nbNeighbor_, neighbors_, dist_);
+      nbNeighbor_ = neighbors_.sizeCols();
+      break;
+    }
+    case Reduct::unknown_graph_:
+      STKRUNTIME_ERROR_NO_ARG(LocalVariance::computeGraph,unknown proximity graph);
+      break;
+  };
+}
+
+template<class Array>
+void LocalVariance<Array>::prim()
+{
+  NeighborGraph<Array> graph(*p_data_);
+  graph.mst(neighbors_);
+  nbNeighbor_ = 1;
+  dist_.clear();
 }
 
 template<class Array>
 void LocalVariance<Array>::minimalDistance()
 {
-  dist_.resize(p_data_->rows(), Range(1,nbNeighbor_));
-  dist_ = Arithmetic<Real>::max();
-  // get dimensions
-  const int begin_ind = p_data_->beginRows();
-  const int last_ind = p_data_->lastIdxRows();
-  // start minimal distance algorithm
-  for (int j = begin_ind; j<last_ind; j++)
-  {
-    // reference on the current point
-    RowVector curPoint(p_data_->row(j), true);
-    // update distance of the neighbors point
-    for (int i=j+1; i<=last_ind; i++)
-    {
-      // compute distance between point i and point j
-      Real d=dist(curPoint, p_data_->row(i));
-      // check if we get a better distance for the point j
-      if (dist_(i, nbNeighbor_) > d )
-      {
-        // check if we get a better distance for the point i
-        int pos = nbNeighbor_;
-        while (dist_(i, pos) > d && pos-- > 1) {}
-        pos++;
-        // shift values
-        for (int k= nbNeighbor_ -1; k>= pos; k--)
-        {
-          dist_(i, k+1) = dist_(i, k);
-          neighbors_(i, k+1) = neighbors_(i, k);
-        }
-        // set minimal distance in place
-        dist_(i, pos) = d;
-        neighbors_(i, pos) = j;
-      }
-      // check if we get a better distance for the point j
-      if (dist_(j, nbNeighbor_) > d )
-      {
-        // insertion sorting algorihtm
-        int pos = nbNeighbor_;
-        while (dist_(j, pos) > d && pos-- > 1) {}
-        pos++;
-        // shift valuesconst
-        for (int k= nbNeighbor_ -1; k>= pos; k--)
-        {
-          dist_(j, k+1) = dist_(j, k);
-          neighbors_(j, k+1) = neighbors_(j, k);
-        }
-        // set minimal distance in place
-        dist_(j, pos) = d;
-        neighbors_(j, pos) = i;
-      }
-    }
-  }
+  NeighborGraph<Array> graph(*p_data_);
+  graph.knn(nbNeighbor_, neighbors_, dist_);
+  nbNeighbor_ = neighbors_.sizeCols();
 }
 
 
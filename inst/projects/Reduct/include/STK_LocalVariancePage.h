@@ -49,8 +49,9 @@ namespace STK
  * @code
  *   # LocalVariancePage options
  *  [LocalVariance]
- *    # proximity graph type using prim or distance
- *    type graph = distance
+ *    # proximity graph type: prim, minimalDistance, approxPrim or
+ *    # approxMinimalDistance
+ *    type graph = minimalDistance
  *    # number of neighbors to use
  *    neighborhood = 2
  * @endcode
@@ -0,0 +1,600 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2016  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Reduct
+ * Purpose:  Compute the k nearest neighbors graph and the minimal spanning
+ *           tree of a data set.
+ * Author:   iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ **/
+
+/** @file STK_NeighborGraph.h
+ *  @brief In this file we define the NeighborGraph class computing the
+ *  proximity graphs used by the LocalVariance class.
+ **/
+
+#ifndef STK_NEIGHBORGRAPH_H
+#define STK_NEIGHBORGRAPH_H
+
+#include <vector>
+#include <algorithm>
+
+#include <Arrays/include/STK_Array2D.h>
+#include <Arrays/include/STK_CArray.h>
+#include <STatistiK/include/STK_Law_Util.h>
+
+namespace STK
+{
+
+namespace hidden
+{
+/** @ingroup hidden
+ *  Disjoint sets of the points used in the computation of the minimal
+ *  spanning trees.
+ **/
+struct UnionFind
+{
+  /** constructor
+   *  @param n number of elements
+   **/
+  UnionFind(int n): parent_(n), nbSets_(n)
+  { for (int i=0; i<n; ++i) parent_[i] = i;}
+  /** @return the representative of the set of i */
+  int find(int i)
+  {
+    while (parent_[i] != i) { parent_[i] = parent_[parent_[i]]; i = parent_[i];}
+    return i;
+  }
+  /** merge the sets of i and j
+   *  @return @c false if i and j are already in the same set
+   **/
+  bool unite(int i, int j)
+  {
+    i = find(i); j = find(j);
+    if (i == j) return false;
+    if (i < j) parent_[j] = i; else parent_[i] = j;
+    --nbSets_;
+    return true;
+  }
+  /** parent of each element */
+  std::vector<int> parent_;
+  /** number of sets */
+  int nbSets_;
+};
+
+} // namespace hidden
+
+/** @ingroup Reduct
+ *  @brief The NeighborGraph class computes the proximity graphs of the rows
+ *  of a data set for the Euclidean distance.
+ *
+ *  The squared distances are computed by tiles of @c tileSize() rows and
+ *  columns as \f$ \|x_i\|^2 + \|x_j\|^2 - 2 x_i^T x_j \f$, the cross products
+ *  being given by a matrix product of the (centered) tiles, and the tiles of
+ *  rows are processed in parallel. The following graphs are available:
+ *  - @c knn: the exact k nearest neighbors of each point,
+ *  - @c approxKnn: approximate k nearest neighbors found using a forest of
+ *  random projection trees refined by one pass on the neighbors of the
+ *  neighbors,
+ *  - @c mst: the exact minimal spanning tree computed with the algorithm of
+ *  Boruvka, or a spanning tree computed with the algorithm of Kruskal on the
+ *  edges of a k nearest neighbors graph, its connected components being
+ *  joined using Boruvka steps.
+ *
+ *  The neighbors and the predecessors are given using the indexes of the
+ *  rows of the data set, in arrays whose columns begin at 1.
+ **/
+template<class Array>
+class NeighborGraph
+{
+  public:
+    /** constructor.
+     *  @param data the data set
+     **/
+    NeighborGraph( Array const& data);
+    /** destructor */
+    ~NeighborGraph() {}
+    /** @return the number of rows and columns of the tiles */
+    inline int tileSize() const { return tileSize_;}
+    /** @param tileSize the number of rows and columns of the tiles */
+    inline void setTileSize(int tileSize) { tileSize_ = std::max(tileSize, 1);}
+    /** compute the exact k nearest neighbors of each point.
+     *  @param k number of neighbors
+     *  @param neighbors the neighbors of each point by increasing distance
+     *  @param dist the distances to the neighbors
+     **/
+    void knn( int k, ArrayXXi& neighbors, ArrayXX& dist) const;
+    /** compute approximate k nearest neighbors using a random projection
+     *  forest.
+     *  @param k number of neighbors
+     *  @param neighbors the neighbors of each point by increasing distance
+     *  @param dist the distances to the neighbors
+     *  @param nbTrees number of trees of the forest
+     *  @param leafSize minimal number of points in a leaf, the leaves have
+     *  less than 2*leafSize points (0 for default, at least k+1)
+     **/
+    void approxKnn( int k, ArrayXXi& neighbors, ArrayXX& dist
+                  , int nbTrees = 8, int leafSize = 0) const;
+    /** compute the exact minimal spanning tree.
+     *  @param pred the predecessor of each point in the tree. The root is the
+     *  first point and is its own predecessor.
+     **/
+    void mst( ArrayXXi& pred) const;
+    /** compute a spanning tree using the edges of a neighbors graph. The tree
+     *  is minimal if the graph contains the minimal spanning tree.
+     *  @param neighbors, dist the neighbors graph
+     *  @param pred the predecessor of each point in the tree. The root is the
+     *  first point and is its own predecessor.
+     **/
+    void mst( ArrayXXi const& neighbors, ArrayXX const& dist, ArrayXXi& pred) const;
+
+  private:
+    /** the rows of the data set */
+    Range rows_;
+    /** number of points */
+    int n_;
+    /** number of variables */
+    int p_;
+    /** size of the tiles */
+    int tileSize_;
+    /** centered data (with rows and columns starting at 0) */
+    CArrayXX x_;
+    /** squared norms of the centered points */
+    std::vector<Real> norm2_;
+
+    /** @return the squared distance between the points i and j */
+    inline Real dist2(int i, int j) const
+    {
+      Real sum = 0.;
+      for (int l=0; l<p_; ++l) { Real d = x_(i, l) - x_(j, l); sum += d*d;}
+      return sum;
+    }
+    /** @return @c true if the edge (d1, i1, j1) is lighter than the edge
+     *  (d2, i2, j2). Ties are broken using the indexes of the points so that
+     *  the edges are totally ordered.
+     **/
+    static inline bool lessEdge(Real d1, int i1, int j1, Real d2, int i2, int j2)
+    {
+      if (d1 != d2) return d1 < d2;
+      if (std::min(i1, j1) != std::min(i2, j2)) return std::min(i1, j1) < std::min(i2, j2);
+      return std::max(i1, j1) < std::max(i2, j2);
+    }
+    /** copy the points [begin, end) of the centered data in a tile */
+    void getTile(int begin, int end, CArrayXX& tile) const;
+    /** compute the squared distances between the points of two tiles
+     *  @param a, b the tiles
+     *  @param na, nb the squared norms of the points of the tiles
+     *  @param d2 the squared distances
+     **/
+    void distTile( CArrayXX const& a, CArrayXX const& b
+                 , Real const* na, Real const* nb, CArrayXX& d2) const;
+    /** insert the point j at the distance d in the sorted list of neighbors
+     *  of the row r
+     **/
+    static inline void insert(CArrayXX& bestD, CArrayXXi& bestJ, int r, Real d, int j)
+    {
+      const int k = bestD.sizeCols();
+      if (d >= bestD(r, k-1)) return;
+      int pos = k-1;
+      while (pos > 0 && bestD(r, pos-1) > d)
+      { bestD(r, pos) = bestD(r, pos-1); bestJ(r, pos) = bestJ(r, pos-1); --pos;}
+      bestD(r, pos) = d; bestJ(r, pos) = j;
+    }
+    /** copy the neighbors of the points [i0, i0+bestD.sizeRows()) in the
+     *  output arrays using the exact distances. The missing neighbors
+     *  (index -1) are set to NA at the end of the lists.
+     **/
+    void setNeighbors( int i0, CArrayXX const& bestD, CArrayXXi const& bestJ
+                     , ArrayXXi& neighbors, ArrayXX& dist) const;
+    /** compute the sorted lists of the k nearest neighbors of each point.
+     *  @param k number of neighbors
+     *  @param bestD, bestJ the squared distances and the neighbors (0-based)
+     **/
+    void knnLists( int k, CArrayXX& bestD, CArrayXXi& bestJ) const;
+    /** join the sets of points using Boruvka steps until there is one set.
+     *  The lists of nearest neighbors are used in order to avoid a full
+     *  scan for the points having a neighbor outside of their set and for
+     *  the points whose last neighbor is too far to improve the lightest
+     *  edge leaving their set. The tree is minimal if the lists are exact.
+     *  @param knnD, knnJ the squared distances and the neighbors (0-based)
+     *  @param sets the sets of points
+     *  @param edges the edges of the tree
+     **/
+    void boruvka( CArrayXX const& knnD, CArrayXXi const& knnJ
+                , hidden::UnionFind& sets, std::vector<std::pair<int, int> >& edges) const;
+    /** build a random projection tree and store the leaves of the points.
+     *  A node is split only if its two halves have at least leafSize points.
+     *  @param leafSize minimal number of points in a leaf
+     *  @param leaves the leaves of the tree
+     *  @param leafOf the leaf of each point
+     **/
+    void buildTree( int leafSize, std::vector< std::vector<int> >& leaves, int* leafOf) const;
+    /** compute the predecessor array of a spanning tree given by its edges */
+    void rootTree( std::vector<std::pair<int, int> > const& edges, ArrayXXi& pred) const;
+};
+
+template<class Array>
+NeighborGraph<Array>::NeighborGraph( Array const& data)
+                                   : rows_(data.rows()), n_(data.sizeRows()), p_(data.sizeCols())
+                                   , tileSize_(256), x_(data.sizeRows(), data.sizeCols()), norm2_(data.sizeRows(), 0.)
+{
+  // center the data for a better accuracy of the squared distances
+  for (int l=0; l<p_; ++l)
+  {
+    const int j = data.beginCols() + l;
+    Real mean = 0.;
+    for (int i=0; i<n_; ++i) { mean += data(rows_.begin()+i, j);}
+    mean /= std::max(n_, 1);
+    for (int i=0; i<n_; ++i) { x_(i, l) = data(rows_.begin()+i, j) - mean;}
+  }
+  for (int l=0; l<p_; ++l)
+    for (int i=0; i<n_; ++i) { norm2_[i] += x_(i, l) * x_(i, l);}
+}
+
+template<class Array>
+void NeighborGraph<Array>::getTile(int begin, int end, CArrayXX& tile) const
+{
+  tile.resize(end - begin, p_);
+  for (int l=0; l<p_; ++l)
+    for (int i=begin; i<end; ++i) { tile(i-begin, l) = x_(i, l);}
+}
+
+template<class Array>
+void NeighborGraph<Array>::distTile( CArrayXX const& a, CArrayXX const& b
+                                   , Real const* na, Real const* nb, CArrayXX& d2) const
+{
+  d2 = a * b.transpose();
+  for (int j=0; j<b.sizeRows(); ++j)
+    for (int i=0; i<a.sizeRows(); ++i)
+    { d2(i, j) = std::max(na[i] + nb[j] - 2.*d2(i, j), Real(0.));}
+}
+
+template<class Array>
+void NeighborGraph<Array>::setNeighbors( int i0, CArrayXX const& bestD, CArrayXXi const& bestJ
+                                       , ArrayXXi& neighbors, ArrayXX& dist) const
+{
+  const int k = bestD.sizeCols();
+  std::vector<std::pair<Real, int> > row(k);
+  for (int r=0; r<bestD.sizeRows(); ++r)
+  {
+    for (int l=0; l<k; ++l)
+    {
+      const int j = bestJ(r, l);
+      row[l] = (j < 0) ? std::make_pair(Arithmetic<Real>::max(), j)
+                       : std::make_pair(std::sqrt(dist2(i0+r, j)), j);
+    }
+    std::sort(row.begin(), row.end());
+    for (int l=0; l<k; ++l)
+    {
+      const bool missing = (row[l].second < 0);
+      neighbors(rows_.begin()+i0+r, l+1) = missing ? Arithmetic<int>::NA() : rows_.begin() + row[l].second;
+      dist(rows_.begin()+i0+r, l+1) = missing ? Arithmetic<Real>::NA() : row[l].first;
+    }
+  }
+}
+
+template<class Array>
+void NeighborGraph<Array>::knnLists( int k, CArrayXX& bestD, CArrayXXi& bestJ) const
+{
+  bestD.resize(n_, k); bestD = Arithmetic<Real>::max();
+  bestJ.resize(n_, k); bestJ = -1;
+  const int nbTiles = (n_ + tileSize_ - 1) / tileSize_;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (double(n_)*n_*p_ > ParallelThreshold)
+#endif
+  for (int t=0; t<nbTiles; ++t)
+  {
+    const int i0 = t * tileSize_, i1 = std::min(n_, i0 + tileSize_);
+    CArrayXX a, b, d2;
+    getTile(i0, i1, a);
+    for (int j0=0; j0<n_; j0 += tileSize_)
+    {
+      const int j1 = std::min(n_, j0 + tileSize_);
+      getTile(j0, j1, b);
+      distTile(a, b, &norm2_[i0], &norm2_[j0], d2);
+      for (int j=j0; j<j1; ++j)
+        for (int i=i0; i<i1; ++i)
+        { if (i != j) insert(bestD, bestJ, i, d2(i-i0, j-j0), j);}
+    }
+  }
+}
+
+template<class Array>
+void NeighborGraph<Array>::knn( int k, ArrayXXi& neighbors, ArrayXX& dist) const
+{
+  k = std::min(k, n_-1);
+  if (k < 1)
+  { STKRUNTIME_ERROR_1ARG(NeighborGraph::knn,k,the number of neighbors must be positive);}
+  neighbors.resize(rows_, Range(1, k));
+  dist.resize(rows_, Range(1, k));
+  CArrayXX bestD;
+  CArrayXXi bestJ;
+  knnLists(k, bestD, bestJ);
+  setNeighbors(0, bestD, bestJ, neighbors, dist);
+}
+
+template<class Array>
+void NeighborGraph<Array>::buildTree( int leafSize, std::vector< std::vector<int> >& leaves, int* leafOf) const
+{
+  std::vector< std::vector<int> > stack(1, std::vector<int>(n_));
+  for (int i=0; i<n_; ++i) stack[0][i] = i;
+  std::vector<std::pair<Real, int> > proj;
+  while (!stack.empty())
+  {
+    std::vector<int> ids;
+    ids.swap(stack.back());
+    stack.pop_back();
+    const int size = int(ids.size());
+    if (size < 2*leafSize)
+    {
+      for (int i=0; i<size; ++i) leafOf[ids[i]] = int(leaves.size());
+      leaves.push_back(ids);
+      continue;
+    }
+    // split at the median of the projections on the direction of two points
+    const int a = ids[std::min(int(Law::generator.randUnif()*size), size-1)];
+    int b = ids[std::min(int(Law::generator.randUnif()*size), size-1)];
+    proj.resize(size);
+    for (int i=0; i<size; ++i)
+    {
+      Real s = 0.;
+      for (int l=0; l<p_; ++l) s += (x_(a, l) - x_(b, l)) * x_(ids[i], l);
+      proj[i] = std::make_pair(s, ids[i]);
+    }
+    std::nth_element(proj.begin(), proj.begin() + size/2, proj.end());
+    std::vector<int> left(size/2), right(size - size/2);
+    for (int i=0; i<size/2; ++i) left[i] = proj[i].second;
+    for (int i=size/2; i<size; ++i) right[i-size/2] = proj[i].second;
+    stack.push_back(left);
+    stack.push_back(right);
+  }
+}
+
+template<class Array>
+void NeighborGraph<Array>::approxKnn( int k, ArrayXXi& neighbors, ArrayXX& dist
+                                    , int nbTrees, int leafSize) const
+{
+  k = std::min(k, n_-1);
+  if (k < 1)
+  { STKRUNTIME_ERROR_1ARG(NeighborGraph::approxKnn,k,the number of neighbors must be positive);}
+  nbTrees = std::max(nbTrees, 1);
+  leafSize = std::max((leafSize > 0) ? leafSize : 16, k+1);
+  neighbors.resize(rows_, Range(1, k));
+  dist.resize(rows_, Range(1, k));
+  // build the forest
+  std::vector< std::vector<int> > leaves;
+  std::vector<int> leafOf(nbTrees * n_);
+  for (int t=0; t<nbTrees; ++t) { buildTree(leafSize, leaves, &leafOf[t*n_]);}
+  // neighbors in the leaves
+  CArrayXX bestD(n_, k, Arithmetic<Real>::max());
+  CArrayXXi bestJ(n_, k, -1);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) if (double(n_)*nbTrees*leafSize*p_ > ParallelThreshold)
+#endif
+  for (int i=0; i<n_; ++i)
+  {
+    std::vector<int> cand;
+    for (int t=0; t<nbTrees; ++t)
+    {
+      std::vector<int> const& leaf = leaves[leafOf[t*n_ + i]];
+      cand.insert(cand.end(), leaf.begin(), leaf.end());
+    }
+    std::sort(cand.begin(), cand.end());
+    cand.erase(std::unique(cand.begin(), cand.end()), cand.end());
+    for (size_t c=0; c<cand.size(); ++c)
+    { if (cand[c] != i) insert(bestD, bestJ, i, dist2(i, cand[c]), cand[c]);}
+  }
+  // refine using the neighbors of the neighbors
+  CArrayXX refD(bestD);
+  CArrayXXi refJ(bestJ);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) if (double(n_)*k*k*p_ > ParallelThreshold)
+#endif
+  for (int i=0; i<n_; ++i)
+  {
+    std::vector<int> cand;
+    for (int l=0; l<k; ++l)
+    {
+      const int j = bestJ(i, l);
+      if (j < 0) continue;
+      for (int m=0; m<k; ++m) { if (bestJ(j, m) >= 0) cand.push_back(bestJ(j, m));}
+    }
+    std::sort(cand.begin(), cand.end());
+    cand.erase(std::unique(cand.begin(), cand.end()), cand.end());
+    for (size_t c=0; c<cand.size(); ++c)
+    {
+      const int j = cand[c];
+      if (j == i) continue;
+      bool found = false;
+      for (int l=0; l<k && !found; ++l) found = (refJ(i, l) == j);
+      if (!found) insert(refD, refJ, i, dist2(i, j), j);
+    }
+    // the lists have to be full: scan all the points if needed
+    if (refJ(i, k-1) < 0)
+    {
+      for (int l=0; l<k; ++l) { refD(i, l) = Arithmetic<Real>::max(); refJ(i, l) = -1;}
+      for (int j=0; j<n_; ++j) { if (j != i) insert(refD, refJ, i, dist2(i, j), j);}
+    }
+  }
+  setNeighbors(0, refD, refJ, neighbors, dist);
+}
+
+template<class Array>
+void NeighborGraph<Array>::boruvka( CArrayXX const& knnD, CArrayXXi const& knnJ
+                                  , hidden::UnionFind& sets, std::vector<std::pair<int, int> >& edges) const
+{
+  const int k = knnD.sizeCols();
+  // if the lists contain all the points, there is never a full scan to do
+  const bool complete = (k >= n_-1);
+  std::vector<int> comp(n_), bestJ(n_), compBest(n_), scan;
+  std::vector<Real> bestD(n_), compD(n_);
+  while (sets.nbSets_ > 1)
+  {
+    for (int i=0; i<n_; ++i)
+    { comp[i] = sets.find(i); compD[i] = Arithmetic<Real>::max();}
+    // lightest edge leaving the set of each point among its neighbors
+    for (int i=0; i<n_; ++i)
+    {
+      bestJ[i] = -1; bestD[i] = Arithmetic<Real>::max();
+      for (int l=0; l<k; ++l)
+      {
+        const int j = knnJ(i, l);
+        if (j >= 0 && comp[j] != comp[i])
+        {
+          bestD[i] = knnD(i, l); bestJ[i] = j;
+          compD[comp[i]] = std::min(compD[comp[i]], bestD[i]);
+          break;
+        }
+      }
+    }
+    // points whose lightest leaving edge can be lighter than the lightest
+    // edge found for their set
+    scan.clear();
+    if (!complete)
+    {
+      for (int i=0; i<n_; ++i)
+      { if (bestJ[i] < 0 && (k == 0 || knnD(i, k-1) <= compD[comp[i]])) scan.push_back(i);}
+    }
+    const int nbScan = int(scan.size());
+    const int nbTiles = (nbScan + tileSize_ - 1) / tileSize_;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (double(nbScan)*n_*p_ > ParallelThreshold)
+#endif
+    for (int t=0; t<nbTiles; ++t)
+    {
+      const int s0 = t * tileSize_, s1 = std::min(nbScan, s0 + tileSize_);
+      CArrayXX a(s1-s0, p_), b, d2;
+      std::vector<Real> na(s1-s0);
+      for (int l=0; l<p_; ++l)
+        for (int s=s0; s<s1; ++s) { a(s-s0, l) = x_(scan[s], l);}
+      for (int s=s0; s<s1; ++s) { na[s-s0] = norm2_[scan[s]];}
+      for (int j0=0; j0<n_; j0 += tileSize_)
+      {
+        const int j1 = std::min(n_, j0 + tileSize_);
+        getTile(j0, j1, b);
+        distTile(a, b, &na[0], &norm2_[j0], d2);
+        for (int j=j0; j<j1; ++j)
+          for (int s=s0; s<s1; ++s)
+          {
+            const int i = scan[s];
+            if (comp[i] == comp[j]) continue;
+            const Real d = d2(s-s0, j-j0);
+            if (bestJ[i] < 0 || lessEdge(d, i, j, bestD[i], i, bestJ[i]))
+            { bestD[i] = d; bestJ[i] = j;}
+          }
+      }
+    }
+    // lightest edge leaving each set
+    for (int i=0; i<n_; ++i) compBest[i] = -1;
+    for (int i=0; i<n_; ++i)
+    {
+      if (bestJ[i] < 0) continue;
+      int& c = compBest[comp[i]];
+      if (c < 0 || lessEdge(bestD[i], i, bestJ[i], bestD[c], c, bestJ[c])) c = i;
+    }
+    for (int i=0; i<n_; ++i)
+    {
+      const int c = compBest[i];
+      if (c >= 0 && sets.unite(c, bestJ[c])) edges.push_back(std::make_pair(c, bestJ[c]));
+    }
+  }
+}
+
+template<class Array>
+void NeighborGraph<Array>::rootTree( std::vector<std::pair<int, int> > const& edges, ArrayXXi& pred) const
+{
+  // adjacency lists of the tree
+  std::vector<int> start(n_+1, 0), adj(2*edges.size());
+  for (size_t e=0; e<edges.size(); ++e) { ++start[edges[e].first+1]; ++start[edges[e].second+1];}
+  for (int i=0; i<n_; ++i) start[i+1] += start[i];
+  std::vector<int> pos(start.begin(), start.end()-1);
+  for (size_t e=0; e<edges.size(); ++e)
+  {
+    adj[pos[edges[e].first]++]  = edges[e].second;
+    adj[pos[edges[e].second]++] = edges[e].first;
+  }
+  // breadth first traversal from the first point
+  pred.resize(rows_, Range(1, 1));
+  std::vector<int> parent(n_, -1), queue(1, 0);
+  parent[0] = 0;
+  for (size_t q=0; q<queue.size(); ++q)
+  {
+    const int i = queue[q];
+    for (int e=start[i]; e<start[i+1]; ++e)
+    {
+      if (parent[adj[e]] >= 0) continue;
+      parent[adj[e]] = i;
+      queue.push_back(adj[e]);
+    }
+  }
+  for (int i=0; i<n_; ++i) { pred(rows_.begin()+i, 1) = rows_.begin() + parent[i];}
+}
+
+template<class Array>
+void NeighborGraph<Array>::mst( ArrayXXi& pred) const
+{
+  if (n_ == 0) { pred.resize(rows_, Range(1, 1)); return;}
+  hidden::UnionFind sets(n_);
+  std::vector<std::pair<int, int> > edges;
+  CArrayXX knnD;
+  CArrayXXi knnJ;
+  knnLists(std::min(10, n_-1), knnD, knnJ);
+  boruvka(knnD, knnJ, sets, edges);
+  rootTree(edges, pred);
+}
+
+template<class Array>
+void NeighborGraph<Array>::mst( ArrayXXi const& neighbors, ArrayXX const& dist, ArrayXXi& pred) const
+{
+  if (n_ == 0) { pred.resize(rows_, Range(1, 1)); return;}
+  // sort the edges of the graph
+  const int k = neighbors.sizeCols();
+  std::vector< std::pair<Real, std::pair<int, int> > > graph;
+  graph.reserve(n_ * k);
+  CArrayXX knnD(n_, k);
+  CArrayXXi knnJ(n_, k);
+  for (int i=0; i<n_; ++i)
+    for (int l=0; l<k; ++l)
+    {
+      const Real d = dist(rows_.begin()+i, neighbors.beginCols()+l);
+      const int j = neighbors(rows_.begin()+i, neighbors.beginCols()+l) - rows_.begin();
+      knnD(i, l) = d*d; knnJ(i, l) = j;
+      graph.push_back(std::make_pair(d, std::make_pair(std::min(i, j), std::max(i, j))));
+    }
+  std::sort(graph.begin(), graph.end());
+  // Kruskal on the graph then Boruvka on the connected components
+  hidden::UnionFind sets(n_);
+  std::vector<std::pair<int, int> > edges;
+  for (size_t e=0; e<graph.size() && sets.nbSets_ > 1; ++e)
+  {
+    if (sets.unite(graph[e].second.first, graph[e].second.second))
+    { edges.push_back(graph[e].second);}
+  }
+  boruvka(knnD, knnJ, sets, edges);
+  rootTree(edges, pred);
+}
+
+} // namespace STK
+
+#endif /* STK_NEIGHBORGRAPH_H */
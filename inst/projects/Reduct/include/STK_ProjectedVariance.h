@@ -33,7 +33,11 @@
 #define STK_PROJECTEDVARIANCE_H
 
 #include <STatistiK/include/STK_Stat_MultivariateReal.h>
+#include <STatistiK/include/STK_Stat_OnlineCovariance.h>
 #include <Algebra/include/STK_SymEigen.h>
+#include <Algebra/include/STK_RandomizedSvd.h>
+#include <Algebra/include/STK_Lanczos.h>
+#include <Algebra/include/STK_lapack_SymEigen.h>
 #include "STK_ILinearReduct.h"
 
 namespace STK
@@ -45,6 +49,17 @@ namespace STK
  *
  *  ProjectedVariance (PCA) reduce the dimension of data by maximizing the
  *  projected varaince on an affine subspace of dimension d.
+ *
+ *  By default the axis are the eigenvectors of the covariance matrix. If the
+ *  randomized mode is set, the axis are the leading right singular vectors
+ *  of the centered data, computed by a RandomizedSvd without forming the
+ *  covariance matrix. This is faster when d is small compared to the number
+ *  of variables.
+ *
+ *  When the data set does not fit in memory, the axis can be computed from
+ *  the statistics accumulated by blocks of rows in a Stat::OnlineCovariance
+ *  using @c computeAxis(stat). The rows can then be projected block by block
+ *  using the axis.
 **/
 template<class Array>
 class ProjectedVariance : public ILinearReduct<Array, Vector>
@@ -76,10 +91,30 @@ class ProjectedVariance : public ILinearReduct<Array, Vector>
      **/
     inline virtual ProjectedVariance* clone() const
     { return new ProjectedVariance(*this);}
+    /** @return @c true if the axis are computed using a randomized svd */
+    inline bool isRandomized() const { return randomized_;}
+    /** set the method used for computing the axis.
+     *  @param randomized @c true if the axis have to be computed using a
+     *  randomized svd of the centered data
+     *  @param nbPowerIter number of subspace iterations of the randomized svd
+     **/
+    inline void setRandomized(bool randomized, int nbPowerIter = 2)
+    { randomized_ = randomized; nbPowerIter_ = nbPowerIter;}
+    /** Compute the axis and the index values using the (unbiased) covariance
+     *  matrix of streamed statistics. The data set is not used and is not
+     *  projected.
+     *  @param stat the statistics accumulated on the rows of the data set
+     *  @return @c true if no error occur, @c false otherwise
+     **/
+    bool computeAxis(Stat::OnlineCovariance const& stat);
 
   protected:
     /** the covariance Array */
     ArraySquareX covariance_;
+    /** @c true if the axis are computed using a randomized svd */
+    bool randomized_;
+    /** number of subspace iterations of the randomized svd */
+    int nbPowerIter_;
 
   private:
     /** Find the axis by maximizing the Index. */
@@ -91,26 +126,37 @@ class ProjectedVariance : public ILinearReduct<Array, Vector>
     virtual void maximizeStep(Vector const& weights);
     /** compute axis and index. */
     void computeAxis();
+    /** compute the @c dim leading axis and index using a partial eigen
+     *  decomposition of the covariance matrix.
+     *  @param dim the number of axis to compute
+     *  @return @c false if the partial decomposition failed
+     **/
+    bool computePartialAxis(int dim);
+    /** compute axis and index using the randomized svd of the data.
+     *  @param svd the randomized svd with centering and scaling set
+     *  @param factor the normalizing factor of the squared singular values
+     **/
+    void computeAxis(RandomizedSvd<Array>& svd, Real const& factor);
     /**  update the class if a new data set is set. */
     virtual void update();
 };
 
 /* default constructor */
 template<class Array>
-ProjectedVariance<Array>::ProjectedVariance(): Base() {}
+ProjectedVariance<Array>::ProjectedVariance(): Base(), randomized_(false), nbPowerIter_(2) {}
 /* Constructor.
  *  @param p_data a pointer on the constant data set to reduce.
  **/
 template<class Array>
 ProjectedVariance<Array>::ProjectedVariance( Array const* p_data)
-                                           : Base(p_data)
+                                           : Base(p_data), randomized_(false), nbPowerIter_(2)
 {}
 /* Constructor.
  *  @param data a constatn reference on the data set to reduce.
  **/
 template<class Array>
 ProjectedVariance<Array>::ProjectedVariance( Array const& data)
-                                           : Base(data)
+                                           : Base(data), randomized_(false), nbPowerIter_(2)
 {}
 /* Copy constructor.
  * @param reducer the reducer to copy
@@ -118,6 +164,8 @@ ProjectedVariance<Array>::ProjectedVariance( Array const& data)
 template<class Array>
 ProjectedVariance<Array>::ProjectedVariance( ProjectedVariance const& reducer)
                                            : Base(reducer)
+                                           , randomized_(reducer.randomized_)
+                                           , nbPowerIter_(reducer.nbPowerIter_)
 {}
 
  /* Destructor */
@@ -133,6 +181,13 @@ void ProjectedVariance<Array>::maximizeStep()
   if (!p_data_)
   { STKRUNTIME_ERROR_NO_ARG(ProjectedVariance::maximizeStep,data is not set);}
 #endif
+  if (randomized_)
+  {
+    RandomizedSvd<Array> svd(*p_data_, this->dim_, 10, nbPowerIter_);
+    svd.setCenter(Stat::mean(*p_data_));
+    computeAxis(svd, Real(std::max(p_data_->sizeRows()-1, 1)));
+    return;
+  }
   Stat::covariance(*p_data_, covariance_, true);
   computeAxis();
 }
@@ -147,26 +202,112 @@ void ProjectedVariance<Array>::maximizeStep(Vector const& weights)
   if (!p_data_)
   { STKRUNTIME_ERROR_NO_ARG(ProjectedVariance::maximizeStep,data is not set);}
 #endif
+  if (randomized_)
+  {
+    // same normalization than the unbiased weighted covariance
+    Real sum1 = 0., sum2 = 0.;
+    for (int i=weights.begin(); i<weights.end(); ++i)
+    { Real w = std::abs(weights[i]); sum1 += w; sum2 += w*w;}
+    RandomizedSvd<Array> svd(*p_data_, this->dim_, 10, nbPowerIter_);
+    svd.setCenter(Stat::mean(*p_data_, weights));
+    svd.setRowsScaling(weights.abs().sqrt());
+    computeAxis(svd, (sum1*sum1 > sum2) ? sum1 - sum2/sum1 : Real(1.));
+    return;
+  }
   Stat::covariance(*p_data_, weights, covariance_, true);
   computeAxis();
 }
 
+/* compute axis and index using streamed statistics. */
+template<class Array>
+bool ProjectedVariance<Array>::computeAxis(Stat::OnlineCovariance const& stat)
+{
+  try
+  {
+    stat.covariance(covariance_, true);
+    computeAxis();
+  }
+  catch (Exception const& e)
+  {
+    this->msg_error_ = e.error();
+    return false;
+  }
+  return true;
+}
+
 /* compute axis and index. */
 template<class Array>
 void ProjectedVariance<Array>::computeAxis()
 {
+  // compute only the leading eigenvectors if they are few
+  const int dim = std::min(this->dim_, covariance_.size());
+  // and use the full decomposition if it fails
+  if (dim > 0 && 2*dim + 20 < covariance_.size() && computePartialAxis(dim))
+  { return;}
   SymEigen<ArraySquareX> eigen(covariance_);
   eigen.run();
 
   // compute the range of the axis
-  Range range(p_data_->beginCols(), std::min(this->dim_, p_data_->sizeCols()));
+  Range range(covariance_.begin(), dim);
   // copy axis and index values
-  axis_.resize(p_data_->cols(), range);
+  axis_.resize(covariance_.range(), range);
   idx_values_.resize(range);
   axis_       = eigen.rotation().col(range);
   idx_values_ = eigen.eigenValues().sub(range);
 }
 
+/* compute the leading axis and index. */
+template<class Array>
+bool ProjectedVariance<Array>::computePartialAxis(int dim)
+{
+  Range range(covariance_.begin(), dim);
+#ifdef STKUSELAPACK
+  lapack::SymEigen<CSquareX> eigen(covariance_);
+  eigen.setLargestEigenValues(dim);
+  if (!eigen.run()) return false;
+  axis_.resize(covariance_.range(), range);
+  idx_values_.resize(range);
+  for (int k=0; k<dim; ++k)
+  {
+    const int j = range.begin() + k;
+    axis_.col(j) = eigen.rotation().col(eigen.range().begin() + k);
+    idx_values_[j] = eigen.eigenValues()[eigen.range().begin() + k];
+  }
+#else
+  typedef SymMultFunctor<ArraySquareX> MultFunctor;
+  MultFunctor mult(covariance_);
+  Lanczos<MultFunctor> lanczos(mult, covariance_.range(), dim);
+  if (!lanczos.run()) return false;
+  axis_.resize(covariance_.range(), range);
+  idx_values_.resize(range);
+  for (int k=0; k<dim; ++k)
+  {
+    const int j = range.begin() + k;
+    axis_.col(j) = lanczos.eigenVectors().col(k);
+    idx_values_[j] = lanczos.eigenValues()[k];
+  }
+#endif
+  return true;
+}
+
+/* compute axis and index using the randomized svd of the data. */
+template<class Array>
+void ProjectedVariance<Array>::computeAxis(RandomizedSvd<Array>& svd, Real const& factor)
+{
+  if (!svd.run())
+  { STKRUNTIME_ERROR_NO_ARG(ProjectedVariance::computeAxis,randomized svd failed);}
+  // compute the range of the axis
+  Range range(p_data_->beginCols(), svd.dim());
+  axis_.resize(p_data_->cols(), range);
+  idx_values_.resize(range);
+  for (int k=0; k<svd.dim(); ++k)
+  {
+    const int j = range.begin() + k;
+    axis_.col(j) = svd.getV().col(k);
+    idx_values_[j] = svd.getD()[k] * svd.getD()[k] / factor;
+  }
+}
+
 /* update the class if a new data set is set */
 template<class Array>
 void ProjectedVariance<Array>::update()
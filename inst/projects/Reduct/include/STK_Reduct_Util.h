@@ -79,9 +79,11 @@ String typeReductionToString( TypeReduction const& type);
 /** Type of proximity graph to used in order to compute the local variance:
  * - prim_ the minimal spanning tree
  * - distance_ the first neighbors
+ * - approxPrim_ a spanning tree of the approximate first neighbors graph
+ * - approxDistance_ the approximate first neighbors
  * - unknown_ unknown type of graph
  */
-enum TypeGraph { unknown_graph_, prim_, distance_ };
+enum TypeGraph { unknown_graph_, prim_, distance_, approxPrim_, approxDistance_ };
 /** convert a String to a TypeGraph.
  *  @param type the type of graph in a string
  *  @return the TypeGraph represented by the String @c type. If the string
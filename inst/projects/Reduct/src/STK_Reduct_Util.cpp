@@ -77,6 +77,8 @@ TypeGraph stringToTypeGraph( String const& type)
 {
   if (toUpperString(type) == toUpperString(_T("prim")))  return prim_;
   if (toUpperString(type) == toUpperString(_T("minimalDistance"))) return distance_;
+  if (toUpperString(type) == toUpperString(_T("approxPrim")))  return approxPrim_;
+  if (toUpperString(type) == toUpperString(_T("approxMinimalDistance"))) return approxDistance_;
   return unknown_graph_;
 }
 
@@ -88,6 +90,8 @@ String typeGraphToString( TypeGraph const& type)
 {
   if (type == prim_)  return String(_T("prim"));
   if (type == distance_) return String(_T("minimalDistance"));
+  if (type == approxPrim_)  return String(_T("approxPrim"));
+  if (type == approxDistance_) return String(_T("approxMinimalDistance"));
   return String(_T("unknown"));
 }
 
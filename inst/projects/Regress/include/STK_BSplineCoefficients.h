@@ -43,7 +43,7 @@
 #include <Arrays/include/STK_Array2D.h>
 #include <Arrays/include/STK_Array2DVector.h>
 
-#include <DManager/include/STK_HeapSort.h>
+#include <DManager/include/STK_Sort.h>
 
 #ifdef STK_REGRESS_VERBOSE
 #include <Arrays/include/STK_Display.h>
@@ -418,22 +418,21 @@ void BSplineCoefficients<Vector>::computePeriodicKnots()
 template<class Vector>
 void BSplineCoefficients<Vector>::computeDensityKnots()
 {
-  // sorted data
-  Vector xtri;
-  // sort the data
-  heapSort< Vector >(*p_data_, xtri);
-
-  // compute step
-  Real step = xtri.size()/(Real)lastKnot_;
-  int first = xtri.begin(), last = xtri.lastIdx();
-  // set knots
+  // only the order statistics used by the knots are selected
+  Real step = p_data_->size()/(Real)lastKnot_;
+  int first = p_data_->begin(), last = p_data_->lastIdx();
+  Array2DVector<int> ranks(Range(0, 2*lastKnot_+2));
   for (int k = 0; k < lastKnot_; k++)
   {
     int cell = first + int(k* step);
-    knots_[k] = (xtri[cell] + xtri[cell+1])/2.;
+    ranks[2*k] = cell; ranks[2*k+1] = cell+1;
   }
-  // set last knots
-  knots_[lastKnot_] = (xtri[last-1] + xtri[last])/2.;
+  ranks[2*lastKnot_] = last-1; ranks[2*lastKnot_+1] = last;
+  Array2DVector<Real> xtri;
+  nthElements(*p_data_, ranks, xtri);
+  // set knots
+  for (int k = 0; k <= lastKnot_; k++)
+  { knots_[k] = (xtri[2*k] + xtri[2*k+1])/2.;}
 }
 
 /* Compute the coefficients of the B-Spline curves.*/
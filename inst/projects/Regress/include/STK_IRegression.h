@@ -37,6 +37,7 @@
 #define STK_IREGRESSION_H
 
 #include <STKernel/include/STK_String.h>
+#include <Sdk/include/STK_Macros.h>
 
 namespace STK
 {
@@ -181,6 +182,29 @@ class IRegression
       // return the result of the computations
       return true;
     }
+    /** update the regression function with new observations without
+     *  refitting the model on the whole data set. The predicted values and
+     *  the residuals are computed for the new observations.
+     *  Default implementation is not available and return @c false.
+     *  @param y the new observed outputs
+     *  @param x the new predictors
+     **/
+    virtual bool update( YArray const& y, XArray const& x)
+    {
+      msg_error_ = STKERROR_NO_ARG(IRegression::update,not available for this regression);
+      return false;
+    }
+    /** update the regression function with new weighted observations.
+     *  Default implementation is not available and return @c false.
+     *  @param y the new observed outputs
+     *  @param x the new predictors
+     *  @param weights weights of the new observations
+     **/
+    virtual bool update( YArray const& y, XArray const& x, Weights const& weights)
+    {
+      msg_error_ = STKERROR_NO_ARG(IRegression::update,not available for this regression);
+      return false;
+    }
     /** Set the data set the regression method should use.
      * @param p_y data set to adjust
      * @param p_x data set of the predictors
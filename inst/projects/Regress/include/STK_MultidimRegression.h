@@ -38,7 +38,9 @@
 #define STK_MULTIDIMREGRESSION_H
 
 #include <Arrays/include/STK_Array2D.h> // for coefs
+#include <Arrays/include/STK_CArrayPoint.h>
 #include <Algebra/include/STK_GinvSymmetric.h>
+#include <Algebra/include/STK_UpdatableQr.h>
 #include "STK_IRegression.h"
 
 namespace STK
@@ -46,6 +48,13 @@ namespace STK
 
 /** @brief The @c MultidimRegression class allows to regress a multidimensional
  *  output variable among a multivariate explanation variable.
+ *
+ *  The model can be refreshed with new observations using the @c update
+ *  methods. The triangular factor of the QR decomposition of the matrix
+ *  [X Y] is then maintained by an UpdatableQr instance (initialized with the
+ *  data set of the last @c run) and each new observation is absorbed in
+ *  O((p+q)^2) operations. An exponential forgetting of the past observations
+ *  can be set using @c setForgetting.
  */
 template<class Array, class Weight>
 class MultidimRegression : public IRegression<Array, Array, Weight>
@@ -62,6 +71,21 @@ class MultidimRegression : public IRegression<Array, Array, Weight>
     virtual ~MultidimRegression() {}
     /** @return the coefficients */
     inline Array const& coefs() const { return coefs_;}
+    /** @return the forgetting factor used by the @c update methods */
+    inline Real forgetting() const { return qr_.forgetting();}
+    /** @param lambda the forgetting factor used by the @c update methods.
+     *  It should be in ]0,1], 1 meaning no forgetting.
+     **/
+    inline void setForgetting( Real lambda) { qr_.setForgetting(lambda);}
+    /** update the coefficients with new observations.
+     *  @param y,x the new variates and co-variates
+     **/
+    virtual bool update( Array const& y, Array const& x);
+    /** update the coefficients with new weighted observations.
+     *  @param y,x the new variates and co-variates
+     *  @param weights the weights of the new observations
+     **/
+    virtual bool update( Array const& y, Array const& x, Weight const& weights);
     /** @return the extrapolated values y from the value @c x.
      *  Given the data set @c x will compute the values \f$ y = x.\hat{\beta} \f$.
      *  The coefficients @c coefs_ have to be estimated previously.
@@ -71,6 +95,12 @@ class MultidimRegression : public IRegression<Array, Array, Weight>
 
   protected:
     ArrayXX coefs_;
+    /** triangular factor of the matrix [X Y] used by the updates */
+    UpdatableQr qr_;
+    /** copy of the weights used by the last run, if any */
+    Weight weights_;
+    /** @c true if the last run used weights */
+    bool hasWeights_;
 
   private:
     /** compute the regression function. */
@@ -86,18 +116,31 @@ class MultidimRegression : public IRegression<Array, Array, Weight>
      **/
     inline virtual int computeNbFreeParameter() const
     { return coefs_.sizeCols() * coefs_.sizeRows(); }
+    /** add the observations to the triangular factor
+     *  @param y,x the variates and co-variates
+     *  @param p_weights pointer on the weights of the observations (can be null)
+     **/
+    void addObservations( Array const& y, Array const& x, Weight const* p_weights);
+    /** update the coefficients and compute the predictions of the new observations */
+    bool updateImpl( Array const& y, Array const& x, Weight const* p_weights);
 };
 
 template<class Array, class Weight>
 MultidimRegression<Array,Weight>::MultidimRegression( Array const* y, Array const* x)
                                                     : Base(y, x)
                                                     , coefs_()
+                                                    , qr_()
+                                                    , weights_()
+                                                    , hasWeights_(false)
 {}
 
 /* compute the regression function. */
 template<class Array, class Weight>
 void MultidimRegression<Array,Weight>::regressionStep()
 {
+  // the factor will be computed at the first update
+  qr_.resize(0);
+  hasWeights_ = false;
   // compute X'X
   ArraySquareX prod;
   prod.move(multLeftTranspose(p_x_->asDerived()));
@@ -111,6 +154,11 @@ void MultidimRegression<Array,Weight>::regressionStep()
 template<class Array, class Weight>
 void MultidimRegression<Array,Weight>::regressionStep(Weight const& weights)
 {
+  // the factor will be computed at the first update
+  qr_.resize(0);
+  // the weights are kept for the first update, as the caller may release them
+  weights_ = weights;
+  hasWeights_ = true;
   // compute X'WX
   ArraySquareX prod;
   prod.move(weightedMultLeftTranspose(p_x_->asDerived(), weights));
@@ -120,6 +168,66 @@ void MultidimRegression<Array,Weight>::regressionStep(Weight const& weights)
   coefs_.move(mult(prod, wmultLeftTranspose(p_x_->asDerived(), p_y_->asDerived(), weights)));
 }
 
+/* update the coefficients with new observations. */
+template<class Array, class Weight>
+bool MultidimRegression<Array,Weight>::update( Array const& y, Array const& x)
+{ return updateImpl(y, x, 0);}
+
+/* update the coefficients with new weighted observations. */
+template<class Array, class Weight>
+bool MultidimRegression<Array,Weight>::update( Array const& y, Array const& x, Weight const& weights)
+{ return updateImpl(y, x, &weights);}
+
+template<class Array, class Weight>
+void MultidimRegression<Array,Weight>::addObservations( Array const& y, Array const& x, Weight const* p_weights)
+{
+  const int p = x.sizeCols(), q = y.sizeCols();
+  CPointX row(p+q);
+  for (int i=x.beginRows(), iy=y.beginRows(); i<x.endRows(); ++i, ++iy)
+  {
+    for (int j=0; j<p; ++j) { row[j] = x(i, x.beginCols()+j);}
+    for (int j=0; j<q; ++j) { row[p+j] = y(iy, y.beginCols()+j);}
+    qr_.addRow(row, p_weights ? (*p_weights)[i] : Real(1.));
+  }
+}
+
+template<class Array, class Weight>
+bool MultidimRegression<Array,Weight>::updateImpl( Array const& y, Array const& x, Weight const* p_weights)
+{
+  if (x.sizeRows() != y.sizeRows())
+  {
+    this->msg_error_ = STKERROR_2ARG(MultidimRegression::update,x.sizeRows(),y.sizeRows(),sizes mismatch);
+    return false;
+  }
+  const int p = x.sizeCols(), q = y.sizeCols();
+  // compute the factor of the data set of the last run at the first update
+  if (qr_.nbCols() != p+q)
+  {
+    qr_.resize(p+q);
+    if (p_x_ && p_y_)
+    {
+      if (p_x_->sizeCols() != p || p_y_->sizeCols() != q)
+      {
+        this->msg_error_ = STKERROR_NO_ARG(MultidimRegression::update,the number of variables differ from the data set);
+        return false;
+      }
+      // the past observations are discounted by the forgetting factor
+      addObservations(*p_y_, *p_x_, hasWeights_ ? &weights_ : 0);
+    }
+  }
+  addObservations(y, x, p_weights);
+  // solve the triangular system
+  CArrayXX coefs;
+  qr_.leastSquare(p, coefs);
+  coefs_.resize(x.cols(), y.cols());
+  for (int j=0; j<q; ++j)
+    for (int i=0; i<p; ++i) { coefs_(x.beginCols()+i, y.beginCols()+j) = coefs(i, j);}
+  // predictions and residuals of the new observations
+  this->predicted_.move(mult(x, coefs_));
+  this->residuals_ = y - this->predicted_;
+  return true;
+}
+
 /* Compute the predicted outputs by the regression function. */
 template<class Array, class Weight>
 void MultidimRegression<Array,Weight>::predictionStep()
@@ -52,6 +52,16 @@ struct DataHandlerTraits<RDataHandler, Type>
   typedef RMatrix<Type> Data;
 };
 
+/** @ingroup hidden
+ *  Specialization of the MixtureDataOwner for RMatrix: the R matrix is
+ *  copied before the missing values are imputed.
+ **/
+template<typename Type>
+struct MixtureDataOwner< RMatrix<Type> >
+{
+  static inline void run( RMatrix<Type>& data) { data.detach();}
+};
+
 } // namespace hidden
 
 
@@ -105,7 +115,11 @@ class RDataHandler : public IDataHandler
     /** @return the number of variables (the number of columns of the data) */
     inline virtual int nbVariable() const { return nbVariable_;}
 
-    /** return in an RMatrix the (cloned) data with the given idData */
+    /** return in an RMatrix the data with the given idData. The RMatrix wraps
+     *  the memory of the R matrix and the data are not copied. If the
+     *  missing values have to be imputed, the data are copied by the
+     *  MixtureData (@sa RMatrix::detach).
+     **/
     template<typename Type>
     void getData(std::string const& idData, RMatrix<Type>& data, int& nbVariable) const
     {
@@ -114,7 +128,7 @@ class RDataHandler : public IDataHandler
         Rtype_ = hidden::RcppTraits<Type>::Rtype_
       };
       Rcpp::Matrix<Rtype_> Rdata = data_[idData];
-      data.setMatrix(Rcpp::clone(Rdata));
+      data.setMatrix(Rdata);
       nbVariable = data.sizeCols();
     }
   private:
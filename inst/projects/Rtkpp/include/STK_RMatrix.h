@@ -135,6 +135,10 @@ class RMatrix : public ArrayBase< RMatrix<Type_> >, public TRef<1>
       rows_ = RowRange(0, matrix_.rows());
       cols_ = RowRange(0, matrix_.cols());
     }
+    /** copy the wrapped R matrix. The RMatrix does not share anymore its
+     *  data with R and can be modified without modifying the R object.
+     **/
+    inline void detach() { setMatrix(Rcpp::clone(matrix_));}
     /** cast operator */
     inline operator Rcpp::Matrix<Rtype_>() const { return matrix_;}
 
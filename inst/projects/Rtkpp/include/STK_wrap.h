@@ -61,10 +61,17 @@ struct WrapHelper<Derived, Arrays::vector_>
   static SEXP wrapImpl(Derived const& vec)
   {
     Result res(vec.size());
-    for(int i=vec.begin(), iRes=0; i< vec.end(); i++, iRes++)
-    { res(iRes) = vec.elt(i);}
+    copyImpl(vec, res);
     return Rcpp::wrap(res);
   }
+  /** copy vec in res. @return @c false if the sizes differ */
+  static bool copyImpl(Derived const& vec, Result& res)
+  {
+    if (res.size() != vec.size()) return false;
+    typename Result::iterator it = res.begin();
+    for(int i=vec.begin(); i< vec.end(); i++, ++it) { *it = vec.elt(i);}
+    return true;
+  }
 };
 
 // specialization for vector_
@@ -81,10 +88,17 @@ struct WrapHelper<Derived, Arrays::point_>
   static SEXP wrapImpl(Derived const& vec)
   {
     Result res(vec.size());
-    for(int i=vec.begin(), iRes=0; i< vec.end(); i++, iRes++)
-    { res(iRes) = vec.elt(i);}
+    copyImpl(vec, res);
     return Rcpp::wrap(res);
   }
+  /** copy vec in res. @return @c false if the sizes differ */
+  static bool copyImpl(Derived const& vec, Result& res)
+  {
+    if (res.size() != vec.size()) return false;
+    typename Result::iterator it = res.begin();
+    for(int i=vec.begin(); i< vec.end(); i++, ++it) { *it = vec.elt(i);}
+    return true;
+  }
 };
 
 // specialization for array2D_
@@ -101,12 +115,20 @@ struct WrapHelper<Derived, Arrays::array2D_>
   static SEXP wrapImpl(Derived const& matrix)
   {
     Result res(matrix.sizeRows(), matrix.sizeCols());
-    for(int j=matrix.beginCols(), jRes=0; j< matrix.endCols(); j++, jRes++)
+    copyImpl(matrix, res);
+    return Rcpp::wrap(res);
+  }
+  /** copy matrix in res. @return @c false if the sizes differ */
+  static bool copyImpl(Derived const& matrix, Result& res)
+  {
+    if (res.nrow() != matrix.sizeRows() || res.ncol() != matrix.sizeCols()) return false;
+    typename Result::iterator it = res.begin();
+    for(int j=matrix.beginCols(); j< matrix.endCols(); j++)
     {
-      for(int i=matrix.beginRows(), iRes=0; i< matrix.endRows(); i++, iRes++)
-      { res(iRes, jRes) = matrix.elt(i,j);}
+      for(int i=matrix.beginRows(); i< matrix.endRows(); i++, ++it)
+      { *it = matrix.elt(i,j);}
     }
-    return Rcpp::wrap(res);
+    return true;
   }
 };
 
@@ -124,12 +146,20 @@ struct WrapHelper<Derived, Arrays::square_>
   static SEXP wrapImpl(Derived const& matrix)
   {
     Result res(matrix.sizeRows(), matrix.sizeCols());
-    for(int j=matrix.beginCols(), jRes=0; j< matrix.endCols(); j++, jRes++)
+    copyImpl(matrix, res);
+    return Rcpp::wrap(res);
+  }
+  /** copy matrix in res. @return @c false if the sizes differ */
+  static bool copyImpl(Derived const& matrix, Result& res)
+  {
+    if (res.nrow() != matrix.sizeRows() || res.ncol() != matrix.sizeCols()) return false;
+    typename Result::iterator it = res.begin();
+    for(int j=matrix.beginCols(); j< matrix.endCols(); j++)
     {
-      for(int i=matrix.beginRows(), iRes=0; i< matrix.endRows(); i++, iRes++)
-      { res(iRes, jRes) = matrix.elt(i,j);}
+      for(int i=matrix.beginRows(); i< matrix.endRows(); i++, ++it)
+      { *it = matrix.elt(i,j);}
     }
-    return Rcpp::wrap(res);
+    return true;
   }
 };
 
@@ -143,6 +173,17 @@ template<typename Derived>
 SEXP wrap( ExprBase<Derived> const& expr)
 { return hidden::WrapHelper<Derived>::wrapImpl(expr.asDerived());}
 
+/** template method allowing to copy an expression in a R vector or matrix
+ *  allocated on the R side (like a slot of a S4 object), without creating
+ *  an intermediary R object.
+ *  @param expr the expression to copy
+ *  @param res the R object to overwrite, it must have the size of @c expr
+ *  @return @c false if the sizes differ
+ **/
+template<typename Derived>
+bool copyTo( ExprBase<Derived> const& expr, typename hidden::WrapHelper<Derived>::Result& res)
+{ return hidden::WrapHelper<Derived>::copyImpl(expr.asDerived(), res);}
+
 } // namespace STK
 
 
@@ -74,6 +74,17 @@ const int MaxUnroll = 20;
  * This value means that when we unroll loops we go until MaxUnrollSquareRoot */
 const int MaxUnrollSquareRoot = 10;
 
+/** @ingroup STKernel
+ * Minimal number of elements of an array for computing the reductions
+ * (sum, mean, min, max,...) in parallel */
+const int ParallelThreshold = 1 << 16;
+
+/** @ingroup STKernel
+ * Number of elements of the blocks used by the parallel reductions. The
+ * partial results of the blocks are merged pairwise and in order, so that the
+ * result does not depend on the number of threads. */
+const int ReductionBlockSize = 1 << 12;
+
 } // namespace STK
 
 
@@ -76,6 +76,11 @@ class Gaussian : public IKernelBase<Array>
     Real const& width() const {return width_;}
     /** set the bandwidth of the kernel */
     void setWidth(Real const& width) {width_ = width;}
+    /** @return the value of the kernel between the individuals i and j
+     *  @param i,j indexes of the individuals
+     **/
+    virtual Real comp(int i, int j) const
+    { return std::exp(-(p_data_->row(i) - p_data_->row(j)).norm2()/(2.*width_));}
     /** compute the kernel */
     virtual bool run();
 
@@ -37,6 +37,7 @@
 #define STK_KERNEL_IKERNELBASE_H
 
 #include "Arrays/include/STK_CArraySquare.h"
+#include "Arrays/include/STK_CArrayVector.h"
 
 namespace STK
 {
@@ -69,6 +70,12 @@ class IKernelBase : public IRunnerBase
      *  @param data the data set to "kernelized"
      **/
     inline void setData(Array const& data) { p_data_ = &data;}
+    /** @return the value of the kernel between the individuals i and j.
+     *  The default implementation use the gram matrix, it has to be overloaded
+     *  if the kernel is used without computing the gram matrix.
+     *  @param i,j indexes of the individuals
+     **/
+    virtual Real comp(int i, int j) const { return gram_(i,j);}
 
   protected:
     /** A constant pointer on the data set */
@@ -88,6 +95,41 @@ class IKernelBase : public IRunnerBase
     }
 };
 
+/** @ingroup Kernel
+ *  Functor computing the product of the gram matrix of a kernel with a
+ *  vector without storing the gram matrix. It can be used as @c MultFunctor
+ *  in the CG and Lanczos classes. The rows of the products are computed in
+ *  parallel.
+ **/
+template<class Array>
+struct GramMultFunctor
+{
+  /** constructor
+   *  @param kernel the kernel to use
+   **/
+  inline GramMultFunctor( IKernelBase<Array> const& kernel): kernel_(kernel) {}
+  /** @return the product of the gram matrix with x
+   *  @param x the vector to multiply (with the range of the rows of the data)
+   **/
+  CVectorX operator()( CVectorX const& x) const
+  {
+    CVectorX y(x.range());
+    const int first = x.begin(), last = x.end();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) if (x.size() > 256)
+#endif
+    for (int i= first; i < last; ++i)
+    {
+      Real sum = 0.;
+      for (int j= first; j < last; ++j) { sum += kernel_.comp(i,j) * x[j];}
+      y[i] = sum;
+    }
+    return y;
+  }
+  /** the kernel */
+  IKernelBase<Array> const& kernel_;
+};
+
 } // namespace Kernel
 
 } // namespace STK
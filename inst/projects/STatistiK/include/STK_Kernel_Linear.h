@@ -67,6 +67,11 @@ class Linear : public IKernelBase<Array>
     Linear(Array const& data): Base(data) {}
     /** destructor */
     virtual ~Linear() {}
+    /** @return the value of the kernel between the individuals i and j
+     *  @param i,j indexes of the individuals
+     **/
+    virtual Real comp(int i, int j) const
+    { return p_data_->row(i).dot(p_data_->row(j));}
     /** compute the kernel */
     virtual bool run();
 };
@@ -89,6 +89,11 @@ class Polynomial : public IKernelBase<Array>
     Real const& shift() const {return shift_;}
     /** set the shift of the kernel */
     void setShift(Real const& shift) { shift_ = shift;}
+    /** @return the value of the kernel between the individuals i and j
+     *  @param i,j indexes of the individuals
+     **/
+    virtual Real comp(int i, int j) const
+    { return std::pow(p_data_->row(i).dot(p_data_->row(j)) + shift_, d_);}
     /** compute the kernel */
     virtual bool run();
 
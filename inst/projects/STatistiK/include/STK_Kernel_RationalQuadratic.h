@@ -82,6 +82,13 @@ class RationalQuadratic : public IKernelBase<Array>
     Real const& shift() const {return shift_;}
     /** set the shift of the kernel */
     void setWidth(Real const& shift) { shift_ = shift;}
+    /** @return the value of the kernel between the individuals i and j
+     *  @param i,j indexes of the individuals
+     **/
+    virtual Real comp(int i, int j) const
+    { Real aux = (p_data_->row(i) - p_data_->row(j)).norm2();
+      return 1 - aux/(aux + shift_);
+    }
     /** compute the kernel */
     virtual bool run();
 
@@ -57,13 +57,7 @@ struct MinOp
     /**  @return the minimal value of the variable V
      *  \f[ \min_{i=1}^n v_i \f]
      **/
-    Type const operator()() const
-    {
-      Type min  = Arithmetic<Type>::max();
-      for (int i=V_.begin(); i<V_.end(); i++)
-      { min = std::min(min, V_[i]);}
-      return min;
-    }
+    inline Type const operator()() const { return V_.minElt();}
     /** @return the minimal value of the variable V
      *  \f[ \min_{i=1}^n w_i v_i \f]
      *  @param w the weights
@@ -128,13 +122,7 @@ struct MaxOp
     /** @return the maximal value of the variable V
      *  \f[ \max_{i=1}^n v_i \f]
      **/
-    Type const operator()() const
-    {
-      Type max  = -Arithmetic<Type>::max();
-      for (int i=V_.begin(); i<V_.end(); i++)
-      { max = std::max(max, V_[i]);}
-      return max;
-    }
+    inline Type const operator()() const { return V_.maxElt();}
     /** @return the weighted maximal value of the variable V
      *  \f[ \max_{i=1}^n w_i v_i \f]
      *  @param w the weights
@@ -199,14 +187,7 @@ struct SumOp
     /** @return the mean of the variable V
      *  \f[ \hat{\mu} = \frac{1}{n} \sum_{i=1}^n V(i) \f]
      **/
-    Type const operator()() const
-    {
-      // sum the samples
-      Type sum  = 0.;
-      for (int i=V_.begin(); i<V_.end(); i++) { sum += V_[i];}
-      // compute the mean
-      return sum;
-    }
+    inline Type const operator()() const { return V_.sum();}
     /** @return the weighted mean value of the variable V
      *  \f[ \hat{\mu} = \frac{1}{\sum_{i=1}^n w(i)} \sum_{i=1}^n w(i) V(i). \f]
      *  @param w the weights
@@ -286,11 +267,8 @@ struct MeanOp
     {
       // no samples
       if (V_.empty()) { return Arithmetic<Type>::NA();}
-      // sum the samples
-      Type sum  = 0.;
-      for (int i=V_.begin(); i<V_.end(); i++) { sum += V_[i];}
       // compute the mean
-      return sum /= (Type)(V_.size());
+      return V_.sum() / (Type)(V_.size());
     }
     /** @return the weighted mean value of the variable V
      *  \f[ \hat{\mu} = \frac{1}{\sum_{i=1}^n w(i)} \sum_{i=1}^n w(i) V(i). \f]
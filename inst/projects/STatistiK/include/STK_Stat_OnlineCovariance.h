@@ -0,0 +1,360 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2016  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::STatistiK::StatDesc
+ * Purpose:  Compute the mean and the covariance of a data set by blocks of rows.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ **/
+
+/** @file STK_Stat_OnlineCovariance.h
+ *  @brief In this file we define the OnlineCovariance class computing in one
+ *  pass the mean, the covariance, the minimal and maximal values of a data set
+ *  given by blocks of rows.
+ **/
+
+#ifndef STK_STAT_ONLINECOVARIANCE_H
+#define STK_STAT_ONLINECOVARIANCE_H
+
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <STKernel/include/STK_Real.h>
+#include <STKernel/include/STK_Range.h>
+#include <STKernel/include/STK_Constants.h>
+
+#include <Arrays/include/STK_Array2DPoint.h>
+#include <Arrays/include/STK_Array2DSquare.h>
+#include <Arrays/include/STK_CArray.h>
+
+namespace STK
+{
+namespace Stat
+{
+/** @ingroup StatDesc
+ *  @brief Computation in one pass of the mean, the covariance, the minimal and
+ *  maximal values of a set of Real variables.
+ *
+ *  The data set is given by blocks of rows (read from a file, a memory mapped
+ *  array, chunks of a R matrix...) using the @c update methods, so that it
+ *  never need to be stored in memory. The rows of a block are processed by
+ *  tiles of @c tileSize() rows: the mean of a tile is computed, then its
+ *  scatter matrix is computed as the product of the centered tile with its
+ *  transpose. The statistics of the tiles are merged with the statistics of
+ *  the previous rows using the formulas of Chan, Golub and LeVeque
+ *  \f[
+ *    \bar{x} = \bar{x}_a + \frac{w_b}{w}\delta, \quad
+ *    S = S_a + S_b + \frac{w_a w_b}{w} \delta\delta^T,
+ *    \quad \delta = \bar{x}_b - \bar{x}_a.
+ *  \f]
+ *  which are numerically stable. The tiles of a large block are processed in
+ *  parallel, each thread accumulating a partial state, and the partial states
+ *  are merged by pairs.
+ *
+ *  Two accumulators built on different parts of a data set (by different
+ *  processes, for example) can be merged using @c merge.
+ *
+ *  The rows with a non finite value are skipped and counted as missing. The
+ *  weights are taken in absolute value.
+ **/
+class OnlineCovariance
+{
+  public:
+    /** default constructor. */
+    inline OnlineCovariance(): cols_(), tileSize_(256) { release();}
+    /** constructor.
+     *  @param cols the range of the variables
+     **/
+    inline OnlineCovariance( Range const& cols): cols_(cols), tileSize_(256) { release();}
+    /** copy constructor
+     *  @param stat the statistics to copy
+     **/
+    inline OnlineCovariance( OnlineCovariance const& stat)
+                           : cols_(stat.cols_), tileSize_(stat.tileSize_)
+                           , nbSamples_(stat.nbSamples_), nbMissing_(stat.nbMissing_)
+                           , sumWeights_(stat.sumWeights_), sum2Weights_(stat.sum2Weights_)
+                           , mean_(stat.mean_), min_(stat.min_), max_(stat.max_)
+                           , scatter_(stat.scatter_)
+    {}
+    /** destructor */
+    inline ~OnlineCovariance() {}
+
+    /** @return the range of the variables */
+    inline Range const& cols() const { return cols_;}
+    /** @return the number of rows used in the statistics */
+    inline int nbSamples() const { return nbSamples_;}
+    /** @return the number of rows skipped as they have non finite values */
+    inline int nbMissing() const { return nbMissing_;}
+    /** @return the sum of the weights (the number of rows if not weighted) */
+    inline Real sumWeights() const { return sumWeights_;}
+    /** @return the sum of the squared weights */
+    inline Real sum2Weights() const { return sum2Weights_;}
+    /** @return the mean of the variables */
+    inline Point const& mean() const { return mean_;}
+    /** @return the minimal values of the variables */
+    inline Point const& min() const { return min_;}
+    /** @return the maximal values of the variables */
+    inline Point const& max() const { return max_;}
+    /** @return the (weighted) sum of the cross products of the centered rows */
+    inline ArraySquareX const& scatter() const { return scatter_;}
+    /** @return the number of rows of the tiles */
+    inline int tileSize() const { return tileSize_;}
+    /** @param tileSize the number of rows of the tiles */
+    inline void setTileSize( int tileSize) { tileSize_ = std::max(tileSize, 1);}
+
+    /** set the range of the variables and release the statistics
+     *  @param cols the range of the variables
+     **/
+    inline void resize( Range const& cols) { cols_ = cols; release();}
+    /** release the computed statistics */
+    inline void release()
+    {
+      nbSamples_ = 0; nbMissing_ = 0;
+      sumWeights_ = 0.; sum2Weights_ = 0.;
+      mean_.resize(cols_) = 0.;
+      min_.resize(cols_) = Arithmetic<Real>::max();
+      max_.resize(cols_) = -Arithmetic<Real>::max();
+      scatter_.resize(cols_) = 0.;
+    }
+    /** @return the covariance of the variables
+     *  @param cov the covariance matrix
+     *  @param unbiased @c true if the unbiased covariance have to be computed,
+     *  i.e. if the scatter matrix is divided by \f$ w - \sum w_i^2/w \f$
+     *  (\f$ n-1 \f$ if the rows are not weighted) rather than by \f$ w\f$.
+     **/
+    inline void covariance( ArraySquareX& cov, bool unbiased = false) const
+    {
+      cov.resize(cols_);
+      Real d = divisor(unbiased);
+      if (d > 0.) { cov = scatter_ / d;} else { cov = 0.;}
+    }
+    /** @return the variance of the variables
+     *  @param unbiased @c true if the unbiased variance have to be computed
+     **/
+    inline Point variance( bool unbiased = false) const
+    {
+      Point var(cols_, 0.);
+      Real d = divisor(unbiased);
+      if (d > 0.)
+      { for (int j=cols_.begin(); j<cols_.end(); ++j) var[j] = scatter_(j,j) / d;}
+      return var;
+    }
+
+    /** update the statistics with a block of rows.
+     *  @param block the rows to add
+     **/
+    template<class Block>
+    void update( Block const& block)
+    { updateImpl(block, (Point const*)0);}
+    /** update the statistics with a block of weighted rows.
+     *  @param block the rows to add
+     *  @param weights the weights of the rows
+     **/
+    template<class Block, class Weights>
+    void update( Block const& block, Weights const& weights)
+    {
+      if (block.rows() != weights.range())
+      { STKRUNTIME_ERROR_NO_ARG(OnlineCovariance::update,block.rows() != weights.range());}
+      updateImpl(block, &weights);
+    }
+    /** merge the statistics of an other data set with these statistics.
+     *  @param other the statistics to merge
+     **/
+    void merge( OnlineCovariance const& other)
+    {
+      if (other.cols_ != cols_)
+      { STKRUNTIME_ERROR_NO_ARG(OnlineCovariance::merge,other.cols() != cols());}
+      nbMissing_ += other.nbMissing_;
+      if (other.sumWeights_ <= 0.)
+      { nbSamples_ += other.nbSamples_; return;}
+      if (sumWeights_ <= 0.)
+      {
+        mean_ = other.mean_; min_ = other.min_; max_ = other.max_;
+        scatter_ = other.scatter_;
+        nbSamples_ += other.nbSamples_;
+        sumWeights_ = other.sumWeights_; sum2Weights_ = other.sum2Weights_;
+        return;
+      }
+      const Real w = sumWeights_ + other.sumWeights_;
+      const Real f = sumWeights_ * other.sumWeights_ / w;
+      Point delta = other.mean_ - mean_;
+      for (int j=cols_.begin(); j<cols_.end(); ++j)
+      {
+        for (int i=cols_.begin(); i<cols_.end(); ++i)
+        { scatter_(i,j) += other.scatter_(i,j) + f * delta[i] * delta[j];}
+        min_[j] = std::min(min_[j], other.min_[j]);
+        max_[j] = std::max(max_[j], other.max_[j]);
+      }
+      mean_ += delta * (other.sumWeights_ / w);
+      nbSamples_   += other.nbSamples_;
+      sumWeights_   = w;
+      sum2Weights_ += other.sum2Weights_;
+    }
+
+  private:
+    /** range of the variables */
+    Range cols_;
+    /** number of rows of the tiles */
+    int tileSize_;
+    /** number of used rows */
+    int nbSamples_;
+    /** number of skipped rows */
+    int nbMissing_;
+    /** sum of the weights */
+    Real sumWeights_;
+    /** sum of the squared weights */
+    Real sum2Weights_;
+    /** mean of the variables */
+    Point mean_;
+    /** minimal values */
+    Point min_;
+    /** maximal values */
+    Point max_;
+    /** scatter matrix */
+    ArraySquareX scatter_;
+
+    /** @return the divisor of the scatter matrix
+     *  @param unbiased @c true for the unbiased divisor
+     **/
+    inline Real divisor( bool unbiased) const
+    {
+      if (!unbiased) return sumWeights_;
+      return (sumWeights_*sumWeights_ > sum2Weights_) ? sumWeights_ - sum2Weights_/sumWeights_ : 0.;
+    }
+    /** update the statistics with a block of rows processed by tiles.
+     *  @param block the rows to add
+     *  @param p_weights pointer on the weights of the rows (can be null)
+     **/
+    template<class Block, class Weights>
+    void updateImpl( Block const& block, Weights const* p_weights)
+    {
+      if (block.cols() != cols_)
+      { STKRUNTIME_ERROR_NO_ARG(OnlineCovariance::update,block.cols() != cols());}
+      const int first = block.beginRows(), nbRows = block.sizeRows();
+      const int nbTiles = (nbRows + tileSize_ - 1) / tileSize_;
+      if (nbTiles == 0) return;
+      int nbThreads = 1;
+#ifdef _OPENMP
+      if (double(nbRows) * cols_.size() * cols_.size() > ParallelThreshold)
+      { nbThreads = std::min(nbTiles, omp_get_max_threads());}
+#endif
+      if (nbThreads == 1)
+      {
+        OnlineCovariance tile(cols_);
+        for (int t = 0; t < nbTiles; ++t)
+        {
+          const int begin = first + t * tileSize_;
+          tile.tileStat(block, p_weights, begin, std::min(begin + tileSize_, first + nbRows));
+          merge(tile);
+        }
+        return;
+      }
+      // each thread accumulates a contiguous set of tiles
+      std::vector<OnlineCovariance> partial(nbThreads, OnlineCovariance(cols_));
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(nbThreads)
+#endif
+      for (int k = 0; k < nbThreads; ++k)
+      {
+        OnlineCovariance tile(cols_);
+        for (int t = (k * nbTiles) / nbThreads; t < ((k+1) * nbTiles) / nbThreads; ++t)
+        {
+          const int begin = first + t * tileSize_;
+          tile.tileStat(block, p_weights, begin, std::min(begin + tileSize_, first + nbRows));
+          partial[k].merge(tile);
+        }
+      }
+      // merge the partial states by pairs
+      for (int step = 1; step < nbThreads; step *= 2)
+      {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int k = 0; k < nbThreads - step; k += 2*step)
+        { partial[k].merge(partial[k + step]);}
+      }
+      merge(partial[0]);
+    }
+    /** compute the statistics of the rows [begin, end) of a block, overwriting
+     *  the current statistics.
+     *  @param block the block of rows
+     *  @param p_weights pointer on the weights of the rows (can be null)
+     *  @param begin, end the rows of the tile
+     **/
+    template<class Block, class Weights>
+    void tileStat( Block const& block, Weights const* p_weights, int begin, int end)
+    {
+      release();
+      const int bc = block.beginCols(), p = cols_.size();
+      // select the rows without missing values
+      std::vector<int> rows;
+      rows.reserve(end - begin);
+      for (int i = begin; i < end; ++i)
+      {
+        bool finite = true;
+        for (int j = 0; j < p && finite; ++j)
+        { finite = Arithmetic<Real>::isFinite(block.elt(i, bc + j));}
+        if (finite) { rows.push_back(i);} else { ++nbMissing_;}
+      }
+      nbSamples_ = int(rows.size());
+      if (nbSamples_ == 0) return;
+      // mean, min and max of the tile
+      std::vector<Real> w(nbSamples_, 1.);
+      for (int k = 0; k < nbSamples_; ++k)
+      {
+        if (p_weights) w[k] = std::abs(Real((*p_weights)[rows[k]]));
+        sumWeights_ += w[k]; sum2Weights_ += w[k] * w[k];
+        for (int j = 0; j < p; ++j)
+        {
+          const Real x = block.elt(rows[k], bc + j);
+          mean_[cols_.begin() + j] += w[k] * x;
+          min_[cols_.begin() + j] = std::min(min_[cols_.begin() + j], x);
+          max_[cols_.begin() + j] = std::max(max_[cols_.begin() + j], x);
+        }
+      }
+      if (sumWeights_ <= 0.) { mean_ = 0.; return;}
+      mean_ /= sumWeights_;
+      // scatter matrix of the centered and weighted tile
+      CArrayXX xc(nbSamples_, p);
+      for (int j = 0; j < p; ++j)
+      {
+        const Real m = mean_[cols_.begin() + j];
+        for (int k = 0; k < nbSamples_; ++k)
+        { xc(k, j) = std::sqrt(w[k]) * (block.elt(rows[k], bc + j) - m);}
+      }
+      CArrayXX s = xc.transpose() * xc;
+      for (int j = 0; j < p; ++j)
+        for (int i = 0; i < p; ++i)
+        { scatter_(cols_.begin() + i, cols_.begin() + j) = s(i, j);}
+    }
+};
+
+} // namespace Stat
+
+} // namespace STK
+
+#endif /* STK_STAT_ONLINECOVARIANCE_H */
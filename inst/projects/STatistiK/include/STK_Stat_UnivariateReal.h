@@ -37,6 +37,7 @@
 #define STK_STAT_UNIVARIATEREAL_H
 
 #include "DManager/include/STK_HeapSort.h"
+#include "DManager/include/STK_Sort.h"
 #include "DManager/include/STK_Variable.h"
 
 namespace STK
@@ -652,11 +653,11 @@ class Univariate<TContainer1D, Real>
       if (!sorted_)
       {
         // if the Variable is not weighted, we can sort it directly
-        if (!weighted_) heapSort(V_);
+        if (!weighted_) sort(V_);
         else // otherwise we have to sort V_and W_ using indirection
         {
           Array2DVector<int> I; // auxiliary Array for indirection
-          heapSort(I, V_);
+          argSort(I, V_);
           applySort1D(V_, I);
           applySort1D(W_, I);
         }
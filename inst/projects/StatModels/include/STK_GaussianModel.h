@@ -39,6 +39,7 @@
 
 #include "STK_IGaussianModel.h"
 #include <STatistiK/include/STK_Stat_MultivariateReal.h>
+#include <STatistiK/include/STK_Stat_OnlineCovariance.h>
 #include <STatistiK/include/STK_MultiLaw_Normal.h>
 
 namespace STK
@@ -79,6 +80,16 @@ class GaussianModel : public IGaussianModel<Array>
      * @return @c true if no error occur and @c false otherwise.
      */
     bool run(ColVector const& weights);
+    /** implementation of the Gaussian statistical model using statistics
+     *  accumulated by blocks of rows. The data set is not used, so that it can
+     *  be larger than the memory. The ln-likelihood is computed using
+     *  \f$ \ln L = -\frac{w}{2}(p\ln(2\pi) + \ln|\hat{\Sigma}| + p)\f$
+     *  where @e w is the sum of the weights (the number of rows if they are
+     *  not weighted).
+     *  @param stat the statistics of the rows of the data set
+     *  @return @c true if no error occur and @c false otherwise.
+     **/
+    bool run(Stat::OnlineCovariance const& stat);
     /** get the empirical covariance
      * @return the empirical covariance
      */
@@ -98,8 +109,9 @@ class GaussianModel : public IGaussianModel<Array>
 template <class Array>
 GaussianModel<Array>::GaussianModel( Array const* p_data)
                             : Base(p_data)
-                            , cov_(p_data_->cols())
+                            , cov_()
 {
+  if (p_data_) cov_.resize(p_data_->cols());
   this->setNbFreeParameter(nbVariable() + (nbVariable()* (nbVariable()-1))/2);
 }
 
@@ -109,7 +121,7 @@ GaussianModel<Array>::GaussianModel( Array const& data)
                             : Base(data)
                             , cov_(data.cols())
 {
-  setNbFreeParameter(nbVariable() + (nbVariable()* (nbVariable()-1))/2);
+  this->setNbFreeParameter(nbVariable() + (nbVariable()* (nbVariable()-1))/2);
 }
 
 /* destructor */
@@ -158,6 +170,27 @@ bool GaussianModel<Array>::run(ColVector const& weights)
   return true;
 }
 
+/* implementation of the Gaussian statistical model using streamed statistics */
+template <class Array>
+bool GaussianModel<Array>::run(Stat::OnlineCovariance const& stat)
+{
+  if (stat.sumWeights() <= 0.) return false;
+  this->setNbSample(stat.nbSamples());
+  this->setNbVariable(stat.cols().size());
+  this->setNbFreeParameter(nbVariable() + (nbVariable()* (nbVariable()-1))/2);
+  mean_ = stat.mean();
+  stat.covariance(cov_);
+  if (!p_law_) p_law_ = new MultiLaw::Normal<RowVector>(mean_, cov_);
+  else static_cast<MultiLaw::Normal<RowVector>*>(p_law_)->setParameters(mean_, cov_);
+  // the ln-likelihood at the maximum likelihood estimates
+  const Real det = static_cast<MultiLaw::Normal<RowVector>* >(p_law_)->decomp().det();
+  if (det <= 0.) return false;
+  const Real p = nbVariable();
+  this->setLnLikelihood(-stat.sumWeights()*(p*Const::_LNSQRT2PI_ + 0.5*std::log(det) + 0.5*p));
+  // everything ok
+  return true;
+}
+
 /** compute the empirical covariance matrix. */
 template <class Array>
 void GaussianModel<Array>::compCovariance()